@@ -0,0 +1,43 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "alloc_counter.h"
+
+static std::atomic<uint64_t> s_allocCount {0};
+static std::atomic<uint64_t> s_allocBytes {0};
+
+static void *countedAlloc(std::size_t size) {
+	s_allocCount.fetch_add(1, std::memory_order_relaxed);
+	s_allocBytes.fetch_add(size, std::memory_order_relaxed);
+	if (size == 0) { size = 1; }
+	return std::malloc(size);
+}
+
+void *operator new(std::size_t size) {
+	if (void *p = countedAlloc(size)) { return p; }
+	throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) {
+	if (void *p = countedAlloc(size)) { return p; }
+	throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept { return countedAlloc(size); }
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept { return countedAlloc(size); }
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete[](void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+
+namespace Bench {
+	AllocStats allocTotals() {
+		return {s_allocCount.load(std::memory_order_relaxed), s_allocBytes.load(std::memory_order_relaxed)};
+	}
+} // namespace Bench
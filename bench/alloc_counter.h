@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Bench {
+	struct AllocStats {
+			uint64_t count = 0;
+			uint64_t bytes = 0;
+	};
+
+	// Totals since process start, counted by the operator new replacement in alloc_counter.cpp
+	AllocStats allocTotals();
+
+	// Allocations made between construction and stats()
+	class AllocScope {
+		public:
+			AllocScope(): m_start(allocTotals()) {}
+
+			AllocStats stats() const {
+				AllocStats now = allocTotals();
+				return {now.count - m_start.count, now.bytes - m_start.bytes};
+			}
+
+		private:
+			AllocStats m_start;
+	};
+} // namespace Bench
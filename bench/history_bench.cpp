@@ -0,0 +1,264 @@
+// History pipeline benchmark: parser throughput, allocations and end-to-end folder refresh over synthetic logs.
+//
+//   history_bench [--files N] [--size KB] [--sessions N] [--noise R] [--seed S] [--iterations N] [--dir PATH]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "alloc_counter.h"
+#include "log_generator.h"
+
+#include "history_stats.h"
+#include "log_parser.h"
+#include "search_index.h"
+#include "session_store.h"
+
+namespace fs = std::filesystem;
+using std::string;
+using std::vector;
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+		int files = 200;
+		size_t sizeKb = 256;
+		int sessions = 3;
+		double noise = 0.1;
+		uint64_t seed = 1;
+		int iterations = 5;
+		string dir;
+};
+
+static bool parseArgs(int argc, char **argv, Options &options) {
+	for (int i = 1; i < argc; ++i) {
+		string arg = argv[i];
+		auto value = [&]() -> const char * { return i + 1 < argc ? argv[++i] : nullptr; };
+		const char *v = nullptr;
+		if (arg == "--files" && (v = value())) {
+			options.files = std::atoi(v);
+		} else if (arg == "--size" && (v = value())) {
+			options.sizeKb = static_cast<size_t>(std::strtoull(v, nullptr, 10));
+		} else if (arg == "--sessions" && (v = value())) {
+			options.sessions = std::atoi(v);
+		} else if (arg == "--noise" && (v = value())) {
+			options.noise = std::atof(v);
+		} else if (arg == "--seed" && (v = value())) {
+			options.seed = std::strtoull(v, nullptr, 10);
+		} else if (arg == "--iterations" && (v = value())) {
+			options.iterations = (std::max)(1, std::atoi(v));
+		} else if (arg == "--dir" && (v = value())) {
+			options.dir = v;
+		} else {
+			std::fprintf(stderr, "unknown or incomplete argument: %s\n", arg.c_str());
+			return false;
+		}
+	}
+	return true;
+}
+
+static double millisSince(Clock::time_point start) {
+	return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static size_t storeBytes(const HistoryStore &store) {
+	const SessionTable &t = store.sessions;
+	size_t bytes = store.logs.capacity() * sizeof(LogInfo);
+	for (const auto &log : store.logs) { bytes += log.fileName.capacity() + log.fullPath.capacity(); }
+	bytes += t.timestampMs.capacity() * sizeof(int64_t) + t.jobId.capacity() * sizeof(JobGuid)
+		   + t.placeId.capacity() * sizeof(uint64_t) + t.universeId.capacity() * sizeof(uint64_t)
+		   + t.serverIp.capacity() * sizeof(uint32_t) + t.serverPort.capacity() * sizeof(uint16_t)
+		   + t.durationMs.capacity() * sizeof(uint32_t);
+	bytes += store.outputArena.capacity() + store.outputLines.capacity() * sizeof(TextSpan);
+	return bytes;
+}
+
+static Bench::LogGeneratorOptions generatorOptions(const Options &options, int index) {
+	Bench::LogGeneratorOptions gen;
+	gen.targetBytes = options.sizeKb * 1024;
+	gen.sessions = options.sessions;
+	gen.noise = options.noise;
+	gen.seed = options.seed + static_cast<uint64_t>(index);
+	gen.startMs += static_cast<int64_t>(index) * 3600000;
+	return gen;
+}
+
+// LogLineParser over an in-memory buffer: pure parsing cost, no I/O
+static void benchParseBuffer(const Options &options) {
+	string log = Bench::generateRobloxLog(generatorOptions(options, 0));
+
+	double bestMs = 1e30;
+	Bench::AllocStats allocs {};
+	size_t sessions = 0;
+	for (int i = 0; i < options.iterations; ++i) {
+		HistoryStore sink;
+		sink.outputArena.reserve(log.size());
+		Bench::AllocScope scope;
+		auto start = Clock::now();
+		LogLineParser parser(&sink);
+		parser.feed(log, true);
+		double ms = millisSince(start);
+		if (ms < bestMs) {
+			bestMs = ms;
+			allocs = scope.stats();
+			sessions = parser.sessions().size();
+		}
+	}
+
+	double mb = static_cast<double>(log.size()) / (1024.0 * 1024.0);
+	std::printf(
+		"parse buffer     %8.2f KB  %8.3f ms  %8.1f MB/s  %6llu allocs  %8llu alloc bytes  %zu sessions\n",
+		static_cast<double>(log.size()) / 1024.0,
+		bestMs,
+		mb / (bestMs / 1000.0),
+		static_cast<unsigned long long>(allocs.count),
+		static_cast<unsigned long long>(allocs.bytes),
+		sessions
+	);
+}
+
+// parseLogFile on one file: the per-log cost of a refresh including the read
+static void benchParseFile(const Options &options, const fs::path &dir) {
+	LogInfo probe;
+	probe.fileName = Bench::generatedLogName(options.seed, 0);
+	probe.fullPath = (dir / probe.fileName).string();
+
+	double bestMs = 1e30;
+	Bench::AllocStats allocs {};
+	for (int i = 0; i < options.iterations; ++i) {
+		HistoryStore store;
+		LogInfo logInfo = probe;
+		Bench::AllocScope scope;
+		auto start = Clock::now();
+		parseLogFile(logInfo, store);
+		double ms = millisSince(start);
+		if (ms < bestMs) {
+			bestMs = ms;
+			allocs = scope.stats();
+		}
+	}
+
+	std::error_code ec;
+	double mb = static_cast<double>(fs::file_size(probe.fullPath, ec)) / (1024.0 * 1024.0);
+	std::printf(
+		"parse file       %8.2f KB  %8.3f ms  %8.1f MB/s  %6llu allocs  %8llu alloc bytes\n",
+		mb * 1024.0,
+		bestMs,
+		mb / (bestMs / 1000.0),
+		static_cast<unsigned long long>(allocs.count),
+		static_cast<unsigned long long>(allocs.bytes)
+	);
+}
+
+// What the Refresh button does: scan, parse, sort, index, roll up stats
+static void benchRefresh(const Options &options, const fs::path &dir) {
+	double bestScanMs = 1e30;
+	double bestIndexMs = 1e30;
+	double bestStatsMs = 1e30;
+	Bench::AllocStats allocs {};
+	size_t logs = 0;
+	size_t sessions = 0;
+	size_t bytes = 0;
+	for (int i = 0; i < options.iterations; ++i) {
+		Bench::AllocScope scope;
+		auto start = Clock::now();
+		HistoryStore store;
+		scanLogFolder(dir.string(), store);
+		double scanMs = millisSince(start);
+
+		start = Clock::now();
+		LogSearchIndex index;
+		index.build(store);
+		double indexMs = millisSince(start);
+
+		start = Clock::now();
+		HistoryStats stats;
+		stats.build(store);
+		double statsMs = millisSince(start);
+
+		if (scanMs + indexMs + statsMs < bestScanMs + bestIndexMs + bestStatsMs) {
+			bestScanMs = scanMs;
+			bestIndexMs = indexMs;
+			bestStatsMs = statsMs;
+			allocs = scope.stats();
+			logs = store.logs.size();
+			sessions = store.sessions.size();
+			bytes = storeBytes(store);
+		}
+	}
+
+	std::printf(
+		"refresh          %8zu logs  %8.3f ms scan  %8.3f ms index  %8.3f ms stats  %8llu allocs  %zu sessions  "
+		"%.2f MB store\n",
+		logs,
+		bestScanMs,
+		bestIndexMs,
+		bestStatsMs,
+		static_cast<unsigned long long>(allocs.count),
+		sessions,
+		static_cast<double>(bytes) / (1024.0 * 1024.0)
+	);
+
+	// Keystroke-sized queries against the freshly built index
+	HistoryStore store;
+	scanLogFolder(dir.string(), store);
+	LogSearchIndex index;
+	index.build(store);
+	const char *queries[] = {"1", "12", "128.116", "version-", "zzzz"};
+	vector<int> results;
+	for (const char *query : queries) {
+		double bestMs = 1e30;
+		for (int i = 0; i < options.iterations; ++i) {
+			auto start = Clock::now();
+			index.query(query, nullptr, results);
+			bestMs = (std::min)(bestMs, millisSince(start));
+		}
+		std::printf("search %-9s %8zu hits  %8.3f ms\n", query, results.size(), bestMs);
+	}
+}
+
+int main(int argc, char **argv) {
+	Options options;
+	if (!parseArgs(argc, argv, options)) { return 2; }
+
+	fs::path dir = options.dir.empty() ? fs::temp_directory_path() / "altman_history_bench" : fs::path(options.dir);
+	std::error_code ec;
+	fs::remove_all(dir, ec);
+	fs::create_directories(dir, ec);
+	if (ec) {
+		std::fprintf(stderr, "cannot create %s: %s\n", dir.string().c_str(), ec.message().c_str());
+		return 1;
+	}
+
+	std::printf(
+		"history_bench: %d files x %zu KB, %d sessions, noise %.2f, seed %llu, best of %d\n",
+		options.files,
+		options.sizeKb,
+		options.sessions,
+		options.noise,
+		static_cast<unsigned long long>(options.seed),
+		options.iterations
+	);
+
+	for (int i = 0; i < options.files; ++i) {
+		std::ofstream out(dir / Bench::generatedLogName(options.seed, i), std::ios::binary);
+		string log = Bench::generateRobloxLog(generatorOptions(options, i));
+		out.write(log.data(), static_cast<std::streamsize>(log.size()));
+	}
+
+	benchParseBuffer(options);
+	if (options.files > 0) {
+		benchParseFile(options, dir);
+		benchRefresh(options, dir);
+	}
+
+	if (options.dir.empty()) { fs::remove_all(dir, ec); }
+	return 0;
+}
@@ -0,0 +1,161 @@
+// Regression check for the History folder scan: logs that are skipped (installer logs, unreadable files) between real
+// logs must not disturb the sessions and output lines of the logs parsed before them, and a scan must find every
+// session that tailing the same file does. Exits non-zero on a mismatch.
+//
+//   history_scan_check [--dir PATH]
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "log_generator.h"
+
+#include "log_parser.h"
+#include "session_store.h"
+
+namespace fs = std::filesystem;
+using std::string;
+using std::vector;
+
+static int g_failures = 0;
+
+static void expect(bool condition, const string &what) {
+	if (condition) { return; }
+	std::fprintf(stderr, "FAILED: %s\n", what.c_str());
+	++g_failures;
+}
+
+static void writeFile(const fs::path &path, const string &contents) {
+	std::ofstream out(path, std::ios::binary);
+	out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+}
+
+static string generatedLog(uint64_t seed, int sessions) {
+	Bench::LogGeneratorOptions options;
+	options.targetBytes = 32 * 1024;
+	options.sessions = sessions;
+	options.seed = seed;
+	options.startMs += static_cast<int64_t>(seed) * 3600 * 1000;
+	return Bench::generateRobloxLog(options);
+}
+
+// The log parsed on its own, for comparing against what the shared store holds for it
+static HistoryStore parsedAlone(const fs::path &path, LogInfo &info) {
+	HistoryStore store;
+	info.fileName = path.filename().string();
+	info.fullPath = path.string();
+	parseLogFile(info, store);
+	return store;
+}
+
+static void expectSameAsAlone(const HistoryStore &store, const LogInfo &log) {
+	LogInfo aloneInfo;
+	HistoryStore alone = parsedAlone(log.fullPath, aloneInfo);
+	expect(log.sessionCount == aloneInfo.sessionCount, log.fileName + ": session count");
+	expect(log.outputLineCount == aloneInfo.outputLineCount, log.fileName + ": output line count");
+	if (log.sessionCount != aloneInfo.sessionCount || log.outputLineCount != aloneInfo.outputLineCount) { return; }
+	for (uint32_t i = 0; i < log.sessionCount; ++i) {
+		GameSession a = store.session(log, i);
+		GameSession b = alone.session(aloneInfo, i);
+		bool same = a.timestampMs == b.timestampMs && a.jobId == b.jobId && a.placeId == b.placeId;
+		expect(same, log.fileName + ": session");
+	}
+	for (uint32_t i = 0; i < log.outputLineCount; ++i) {
+		expect(store.outputLine(log, i) == alone.outputLine(aloneInfo, i), log.fileName + ": output line");
+	}
+}
+
+// Parses the files in the given order, keeping or discarding each the way scanLogFolder does
+static HistoryStore parseInOrder(const vector<fs::path> &paths) {
+	HistoryStore store;
+	for (const auto &path : paths) {
+		LogInfo info;
+		info.fileName = path.filename().string();
+		info.fullPath = path.string();
+		parseLogFile(info, store);
+		if (info.timestampMs != 0 || info.versionId != 0) {
+			store.logs.push_back(std::move(info));
+		} else {
+			store.discardParsed(info);
+		}
+	}
+	return store;
+}
+
+int main(int argc, char **argv) {
+	fs::path dir = fs::temp_directory_path() / "altman_history_scan_check";
+	if (argc == 3 && string(argv[1]) == "--dir") {
+		dir = argv[2];
+	} else if (argc != 1) {
+		std::fprintf(stderr, "usage: history_scan_check [--dir PATH]\n");
+		return 2;
+	}
+	std::error_code ec;
+	fs::remove_all(dir, ec);
+	fs::create_directories(dir, ec);
+	if (ec) {
+		std::fprintf(stderr, "cannot create %s: %s\n", dir.string().c_str(), ec.message().c_str());
+		return 1;
+	}
+
+	fs::path b = dir / "0.689.0.6890917_20240501T123456Z_Player_b.log";
+	fs::path installer = dir / "0.689.0.6890917_20240501T130000Z_RobloxPlayerInstaller_1A2B3.log";
+	fs::path missing = dir / "0.689.0.6890917_20240501T131500Z_Player_missing.log";
+	fs::path a = dir / "0.689.0.6890917_20240501T140000Z_Player_a.log";
+	writeFile(b, generatedLog(2, 3));
+	writeFile(installer, generatedLog(3, 1));
+	writeFile(a, generatedLog(4, 2));
+
+	// An installer log and an unreadable one between two real logs
+	HistoryStore store = parseInOrder({b, installer, missing, a});
+	expect(store.logs.size() == 2, "two logs kept");
+	size_t sessions = 0;
+	for (const auto &log : store.logs) {
+		expectSameAsAlone(store, log);
+		sessions += log.sessionCount;
+	}
+	expect(store.sessions.size() == sessions, "no stray session rows");
+	if (store.logs.size() == 2) {
+		expect(store.logs[0].firstSession != store.logs[1].firstSession, "logs own separate session rows");
+	}
+
+	// A log longer than one read chunk: the scan must find the same sessions as the live watcher, which tails the file
+	// in small appends to the end
+	fs::path large = dir / "0.689.0.6890917_20240501T150000Z_Player_large.log";
+	{
+		Bench::LogGeneratorOptions options;
+		options.targetBytes = 3 * 1024 * 1024;
+		options.sessions = 6;
+		options.seed = 5;
+		writeFile(large, Bench::generateRobloxLog(options));
+	}
+	LogInfo largeInfo;
+	HistoryStore largeStore = parsedAlone(large, largeInfo);
+	LogLineParser tail;
+	{
+		std::ifstream in(large, std::ios::binary);
+		string pending;
+		char chunk[4096];
+		while (in.read(chunk, sizeof(chunk)), in.gcount() > 0) {
+			pending.append(chunk, static_cast<size_t>(in.gcount()));
+			pending.erase(0, tail.feed(pending, false));
+		}
+		tail.feed(pending, true);
+	}
+	expect(tail.sessions().size() == 6, "large log: generated sessions found by tailing");
+	expect(largeInfo.sessionCount == tail.sessions().size(), "large log: scan finds the tailed sessions");
+	fs::remove(large, ec);
+
+	// The real folder scan, in whatever order the directory lists the files
+	HistoryStore scanned;
+	scanLogFolder(dir.string(), scanned);
+	expect(scanned.logs.size() == 2, "scan keeps two logs");
+	for (const auto &log : scanned.logs) { expectSameAsAlone(scanned, log); }
+
+	fs::remove_all(dir, ec);
+	if (g_failures == 0) { std::printf("history_scan_check: ok\n"); }
+	return g_failures == 0 ? 0 : 1;
+}
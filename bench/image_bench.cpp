@@ -0,0 +1,238 @@
+// Thumbnail decode benchmark: PNG -> RGBA cost per image on one thread and throughput on the shared worker pool,
+// i.e. the work that used to run on the UI thread when a grid of thumbnails arrived.
+//
+//   image_bench [--images N] [--threads N] [--dir PATH]
+//
+// Without --dir the images are synthetic PNGs written with stored (uncompressed) deflate blocks, which decode faster
+// than real thumbnails; point --dir at a folder of downloaded thumbnails for representative numbers.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "core/image_decode.h"
+#include "system/worker_pool.h"
+
+namespace fs = std::filesystem;
+using std::string;
+using std::vector;
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+		int images = 400;
+		int threads = 8;
+		string dir;
+};
+
+static bool parseArgs(int argc, char **argv, Options &options) {
+	for (int i = 1; i < argc; ++i) {
+		string arg = argv[i];
+		auto value = [&]() -> const char * { return i + 1 < argc ? argv[++i] : nullptr; };
+		const char *v = nullptr;
+		if (arg == "--images" && (v = value())) {
+			options.images = (std::max)(1, std::atoi(v));
+		} else if (arg == "--threads" && (v = value())) {
+			options.threads = (std::max)(1, std::atoi(v));
+		} else if (arg == "--dir" && (v = value())) {
+			options.dir = v;
+		} else {
+			std::fprintf(stderr, "unknown or incomplete argument: %s\n", arg.c_str());
+			return false;
+		}
+	}
+	return true;
+}
+
+static uint32_t crc32(const uint8_t *data, size_t size, uint32_t crc = 0) {
+	static uint32_t table[256] = {};
+	if (table[1] == 0) {
+		for (uint32_t n = 0; n < 256; ++n) {
+			uint32_t c = n;
+			for (int k = 0; k < 8; ++k) { c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1; }
+			table[n] = c;
+		}
+	}
+	crc = ~crc;
+	for (size_t i = 0; i < size; ++i) { crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8); }
+	return ~crc;
+}
+
+static void putBe32(string &out, uint32_t v) {
+	out += static_cast<char>(v >> 24);
+	out += static_cast<char>(v >> 16);
+	out += static_cast<char>(v >> 8);
+	out += static_cast<char>(v);
+}
+
+static void putChunk(string &out, const char *type, const string &data) {
+	putBe32(out, static_cast<uint32_t>(data.size()));
+	string body = string(type, 4) + data;
+	out += body;
+	putBe32(out, crc32(reinterpret_cast<const uint8_t *>(body.data()), body.size()));
+}
+
+// RGBA PNG of a gradient with noise. Rows use the Paeth filter so decoding does the same unfiltering work as real
+// thumbnails; only the inflate step is cheaper.
+static string syntheticPng(int width, int height, uint32_t seed) {
+	vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4);
+	for (int y = 0; y < height; ++y) {
+		for (int x = 0; x < width; ++x) {
+			seed = seed * 1664525u + 1013904223u;
+			uint8_t *p = &pixels[(static_cast<size_t>(y) * width + x) * 4];
+			p[0] = static_cast<uint8_t>(x * 255 / width + (seed >> 28));
+			p[1] = static_cast<uint8_t>(y * 255 / height + (seed >> 29));
+			p[2] = static_cast<uint8_t>((x + y) * 127 / (width + height) + (seed >> 30));
+			p[3] = (x + y) % 7 == 0 ? 0 : 255;
+		}
+	}
+
+	auto paeth = [](int a, int b, int c) {
+		int p = a + b - c;
+		int pa = std::abs(p - a);
+		int pb = std::abs(p - b);
+		int pc = std::abs(p - c);
+		return pa <= pb && pa <= pc ? a : (pb <= pc ? b : c);
+	};
+	size_t stride = static_cast<size_t>(width) * 4;
+	string raw;
+	raw.reserve((stride + 1) * height);
+	for (int y = 0; y < height; ++y) {
+		raw += static_cast<char>(4);
+		for (size_t i = 0; i < stride; ++i) {
+			int a = i >= 4 ? pixels[y * stride + i - 4] : 0;
+			int b = y > 0 ? pixels[(y - 1) * stride + i] : 0;
+			int c = i >= 4 && y > 0 ? pixels[(y - 1) * stride + i - 4] : 0;
+			raw += static_cast<char>(pixels[y * stride + i] - paeth(a, b, c));
+		}
+	}
+
+	string zlib = "\x78\x01";
+	for (size_t pos = 0; pos < raw.size() || pos == 0; pos += 65535) {
+		size_t len = (std::min)(raw.size() - pos, static_cast<size_t>(65535));
+		bool last = pos + len >= raw.size();
+		zlib += static_cast<char>(last ? 1 : 0);
+		zlib += static_cast<char>(len & 0xFF);
+		zlib += static_cast<char>(len >> 8);
+		zlib += static_cast<char>(~len & 0xFF);
+		zlib += static_cast<char>((~len >> 8) & 0xFF);
+		zlib.append(raw, pos, len);
+		if (last) { break; }
+	}
+	uint32_t s1 = 1;
+	uint32_t s2 = 0;
+	for (unsigned char ch : raw) {
+		s1 = (s1 + ch) % 65521;
+		s2 = (s2 + s1) % 65521;
+	}
+	putBe32(zlib, (s2 << 16) | s1);
+
+	string png = "\x89PNG\r\n\x1a\n";
+	string ihdr;
+	putBe32(ihdr, static_cast<uint32_t>(width));
+	putBe32(ihdr, static_cast<uint32_t>(height));
+	ihdr += string("\x08\x06\x00\x00\x00", 5);
+	putChunk(png, "IHDR", ihdr);
+	putChunk(png, "IDAT", zlib);
+	putChunk(png, "IEND", {});
+	return png;
+}
+
+static vector<string> loadDir(const string &dir) {
+	vector<string> files;
+	std::error_code ec;
+	for (const auto &entry : fs::directory_iterator(dir, ec)) {
+		if (!entry.is_regular_file()) { continue; }
+		std::ifstream in(entry.path(), std::ios::binary);
+		files.emplace_back(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+	}
+	return files;
+}
+
+static double msSince(Clock::time_point start) {
+	return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static void benchSet(const char *label, const vector<string> &pngs, const Options &options) {
+	size_t pixelBytes = 0;
+	size_t failures = 0;
+	auto start = Clock::now();
+	for (const auto &png : pngs) {
+		DecodedImage image;
+		if (DecodeImage(png.data(), png.size(), image)) {
+			pixelBytes += image.bytes();
+		} else {
+			++failures;
+		}
+	}
+	double serialMs = msSince(start);
+
+	WorkerPool pool(static_cast<size_t>(options.threads));
+	std::mutex mutex;
+	std::condition_variable finished;
+	size_t remaining = pngs.size();
+	std::atomic<size_t> poolBytes {0};
+	start = Clock::now();
+	for (const auto &png : pngs) {
+		pool.Post([&]() {
+			DecodedImage image;
+			if (DecodeImage(png.data(), png.size(), image)) { poolBytes += image.bytes(); }
+			std::lock_guard<std::mutex> lock(mutex);
+			if (--remaining == 0) { finished.notify_one(); }
+		});
+	}
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		finished.wait(lock, [&] { return remaining == 0; });
+	}
+	double poolMs = msSince(start);
+
+	double perImageUs = serialMs * 1000.0 / pngs.size();
+	std::printf(
+		"%-10s %5zu images  %8.1f us/image  1 thread %7.1f ms  %d threads %7.1f ms  %6.1f MB pixels%s\n",
+		label,
+		pngs.size(),
+		perImageUs,
+		serialMs,
+		options.threads,
+		poolMs,
+		pixelBytes / (1024.0 * 1024.0),
+		failures ? "  DECODE FAILURES" : ""
+	);
+	// What a burst of one screenful of thumbnails cost the UI thread when each was decoded inside MainThread::Process
+	std::printf("%-10s a 48-thumbnail burst decoded on the UI thread took %.2f ms\n", "", perImageUs * 48 / 1000.0);
+}
+
+int main(int argc, char **argv) {
+	Options options;
+	if (!parseArgs(argc, argv, options)) { return 1; }
+
+	std::printf("image_bench: %d images per size, pool of %d threads\n", options.images, options.threads);
+	if (!options.dir.empty()) {
+		vector<string> files = loadDir(options.dir);
+		if (files.empty()) {
+			std::fprintf(stderr, "no files in %s\n", options.dir.c_str());
+			return 1;
+		}
+		benchSet("files", files, options);
+		return 0;
+	}
+
+	for (int size : {75, 150, 420}) {
+		vector<string> pngs;
+		pngs.reserve(options.images);
+		for (int i = 0; i < options.images; ++i) { pngs.push_back(syntheticPng(size, size, static_cast<uint32_t>(i))); }
+		string label = std::to_string(size) + "x" + std::to_string(size);
+		benchSet(label.c_str(), pngs, options);
+	}
+	return 0;
+}
@@ -0,0 +1,181 @@
+// Image kernel benchmark: the SSE2 and AVX2 versions of the thumbnail kernels against the scalar reference. Every level
+// is first checked to produce exactly the scalar output, then timed.
+//
+//   image_ops_bench [--iterations N] [--size N] [--target N]
+//
+// --size is the square source image (420, the avatar fetch size, by default) and --target the edge it is resized to.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "core/image_ops.h"
+
+using Clock = std::chrono::steady_clock;
+using ImageOps::SimdLevel;
+using std::vector;
+
+struct Options {
+		int iterations = 200;
+		int size = 420;
+		int target = 330;
+};
+
+static bool parseArgs(int argc, char **argv, Options &options) {
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		auto value = [&]() -> const char * { return i + 1 < argc ? argv[++i] : nullptr; };
+		const char *v = nullptr;
+		if (arg == "--iterations" && (v = value())) {
+			options.iterations = (std::max)(1, std::atoi(v));
+		} else if (arg == "--size" && (v = value())) {
+			options.size = (std::max)(2, std::atoi(v));
+		} else if (arg == "--target" && (v = value())) {
+			options.target = (std::max)(1, std::atoi(v));
+		} else {
+			std::fprintf(stderr, "unknown or incomplete argument: %s\n", arg.c_str());
+			return false;
+		}
+	}
+	return true;
+}
+
+// Noisy gradient with a transparent border and soft edges, like an item rendered on a transparent background
+static DecodedImage syntheticImage(int width, int height, uint32_t seed) {
+	DecodedImage image;
+	image.width = width;
+	image.height = height;
+	image.rgba.resize(static_cast<size_t>(width) * height * 4);
+	for (int y = 0; y < height; ++y) {
+		for (int x = 0; x < width; ++x) {
+			seed = seed * 1664525u + 1013904223u;
+			uint8_t *p = &image.rgba[(static_cast<size_t>(y) * width + x) * 4];
+			int edge = (std::min)((std::min)(x, width - 1 - x), (std::min)(y, height - 1 - y));
+			p[0] = static_cast<uint8_t>(x * 255 / width + (seed >> 28));
+			p[1] = static_cast<uint8_t>(y * 255 / height + (seed >> 29));
+			p[2] = static_cast<uint8_t>(seed >> 24);
+			p[3] = static_cast<uint8_t>((std::min)(255, (std::max)(0, (edge - width / 8) * 16)));
+		}
+	}
+	return image;
+}
+
+struct Kernel {
+		const char *name;
+		size_t pixels; // Source pixels per run, for the per-pixel figure
+		std::function<DecodedImage(const DecodedImage &)> run;
+};
+
+static bool sameImage(const DecodedImage &a, const DecodedImage &b) {
+	return a.width == b.width && a.height == b.height && a.rgba == b.rgba;
+}
+
+int main(int argc, char **argv) {
+	Options options;
+	if (!parseArgs(argc, argv, options)) { return 1; }
+
+	const int size = options.size;
+	const int target = (std::min)(options.target, size);
+	const DecodedImage source = syntheticImage(size, size, 1);
+	const size_t pixels = static_cast<size_t>(size) * size;
+
+	vector<Kernel> kernels = {
+		{"premultiply",
+		 pixels,
+		 [](const DecodedImage &in) {
+			 DecodedImage out = in;
+			 ImageOps::PremultiplyAlpha(out.rgba.data(), out.rgba.size() / 4);
+			 return out;
+		 }},
+		{"unpremultiply",
+		 pixels,
+		 [](const DecodedImage &in) {
+			 DecodedImage out = in;
+			 ImageOps::UnpremultiplyAlpha(out.rgba.data(), out.rgba.size() / 4);
+			 return out;
+		 }},
+		{"halve",
+		 pixels,
+		 [](const DecodedImage &in) {
+			 DecodedImage out;
+			 out.width = (std::max)(1, in.width / 2);
+			 out.height = (std::max)(1, in.height / 2);
+			 out.rgba.resize(static_cast<size_t>(out.width) * out.height * 4);
+			 ImageOps::HalveImage(in.rgba.data(), in.width, in.height, out.rgba.data());
+			 return out;
+		 }},
+		{"bilinear",
+		 pixels,
+		 [target](const DecodedImage &in) {
+			 DecodedImage out;
+			 out.width = target;
+			 out.height = target;
+			 out.rgba.resize(static_cast<size_t>(target) * target * 4);
+			 ImageOps::ResizeBilinear(in.rgba.data(), in.width, in.height, out.rgba.data(), target, target);
+			 return out;
+		 }},
+		{"prepare",
+		 pixels,
+		 [target](const DecodedImage &in) {
+			 DecodedImage out = in;
+			 ImageOps::PrepareForDisplay(out, target);
+			 return out;
+		 }},
+	};
+
+	vector<SimdLevel> levels = {SimdLevel::Scalar};
+	SimdLevel best = ImageOps::DetectSimdLevel();
+	if (best >= SimdLevel::Sse2) { levels.push_back(SimdLevel::Sse2); }
+	if (best >= SimdLevel::Avx2) { levels.push_back(SimdLevel::Avx2); }
+
+	std::printf(
+		"image_ops_bench: %dx%d source, resized to %dx%d, %d iterations, best level %s\n",
+		size,
+		size,
+		target,
+		target,
+		options.iterations,
+		ImageOps::SimdLevelName(best)
+	);
+	std::printf("%-14s %-7s %12s %12s %9s\n", "kernel", "level", "us/image", "ns/pixel", "speedup");
+
+	bool mismatch = false;
+	for (const auto &kernel : kernels) {
+		ImageOps::SetSimdLevel(SimdLevel::Scalar);
+		DecodedImage reference = kernel.run(source);
+		double scalarUs = 0;
+		for (SimdLevel level : levels) {
+			ImageOps::SetSimdLevel(level);
+			bool same = sameImage(kernel.run(source), reference);
+			mismatch |= !same;
+
+			auto start = Clock::now();
+			size_t sink = 0;
+			for (int i = 0; i < options.iterations; ++i) { sink += kernel.run(source).rgba[0]; }
+			double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / options.iterations;
+			if (level == SimdLevel::Scalar) { scalarUs = us; }
+			std::printf(
+				"%-14s %-7s %12.1f %12.2f %8.2fx%s%s\n",
+				kernel.name,
+				ImageOps::SimdLevelName(level),
+				us,
+				us * 1000.0 / kernel.pixels,
+				scalarUs / us,
+				same ? "" : "  MISMATCH",
+				sink == SIZE_MAX ? " " : ""
+			);
+		}
+	}
+
+	// What normalization saves per avatar: texture bytes before and after
+	DecodedImage prepared = source;
+	ImageOps::PrepareForDisplay(prepared, target);
+	std::printf("texture bytes: %zu as downloaded, %zu normalized\n", source.bytes(), prepared.bytes());
+	return mismatch ? 1 : 0;
+}
@@ -0,0 +1,30 @@
+// Converts binary structured log files (storage/logs/*.bin) to text.
+//
+//   log_decode FILE...
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+#include "core/structured_log.h"
+
+int main(int argc, char **argv) {
+	if (argc < 2) {
+		std::fprintf(stderr, "usage: log_decode FILE...\n");
+		return 2;
+	}
+	int status = 0;
+	for (int i = 1; i < argc; ++i) {
+		std::ifstream in(argv[i], std::ios::binary);
+		if (!in) {
+			std::fprintf(stderr, "cannot open %s\n", argv[i]);
+			status = 1;
+			continue;
+		}
+		if (!StructuredLog::DecodeBinary(in, std::cout)) {
+			std::fprintf(stderr, "%s: not a log file or truncated record\n", argv[i]);
+			status = 1;
+		}
+	}
+	return status;
+}
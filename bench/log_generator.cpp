@@ -0,0 +1,208 @@
+#include <cstdio>
+#include <string>
+
+#include "log_generator.h"
+
+using std::string;
+
+namespace {
+	// splitmix64: tiny, fast and identical everywhere, unlike the <random> distributions
+	struct Rng {
+			uint64_t state;
+
+			uint64_t next() {
+				uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+				z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+				z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+				return z ^ (z >> 31);
+			}
+
+			uint64_t below(uint64_t bound) { return bound ? next() % bound : 0; }
+
+			double unit() { return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0); }
+	};
+
+	const char *kCategories[] = {
+		"FLog::Network",
+		"FLog::HttpTrace",
+		"DFLog::HttpTraceError",
+		"FLog::Graphics",
+		"FLog::RobloxStarter",
+		"FLog::SingleSurfaceApp",
+		"FLog::AudioFocus",
+		"FLog::ClientRunInfo",
+		"FLog::WndProcessCheck",
+		"DFLog::LuaGcStats",
+	};
+
+	const char *kFillerText[] = {
+		"Settings Date header set to Wed, 01 May 2024 12:34:56 GMT",
+		"HttpResponse(#42 0x1c2f) time:53.2ms (net 51.9ms callback queue: 0.1ms)",
+		"[Graphics] D3D11 device created, feature level 11_1, adapter 0x10de",
+		"Loaded texture rbxasset://textures/ui/LuaApp/icons/ic-more.png in 1.3ms",
+		"AudioFocusService: focus granted to context 2",
+		"Lua GC step: 0.42ms heap 48213 KB, 1937 objects collected",
+		"Window state changed: active=1 minimized=0",
+		"ReplicatorRakNet: packet queue depth 3, avg latency 62ms",
+	};
+
+	// Lines that contain parser tokens but must not produce data
+	const char *kNearMisses[] = {
+		"! Joining game 'not-a-guid' place abc",
+		"Teleport to place pending, universeid: unknown",
+		"UDMUX Address = pending",
+		"Report: place  at universe",
+		"userId = unknown (guest)",
+		"The channel is",
+	};
+
+	template <size_t N> const char *pick(Rng &rng, const char *(&items)[N]) { return items[rng.below(N)]; }
+
+	string isoTimestamp(int64_t ms) {
+		int64_t days = ms / 86400000;
+		int64_t rem = ms % 86400000;
+		// civil_from_days (Howard Hinnant)
+		int64_t z = days + 719468;
+		int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+		int64_t doe = z - era * 146097;
+		int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+		int64_t y = yoe + era * 400;
+		int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+		int64_t mp = (5 * doy + 2) / 153;
+		int64_t d = doy - (153 * mp + 2) / 5 + 1;
+		int64_t m = mp < 10 ? mp + 3 : mp - 9;
+		if (m <= 2) { ++y; }
+
+		char buffer[64]; // Wide enough for any int64 in each field
+		std::snprintf(
+			buffer,
+			sizeof(buffer),
+			"%04lld-%02lld-%02lldT%02lld:%02lld:%02lld.%03lldZ",
+			static_cast<long long>(y),
+			static_cast<long long>(m),
+			static_cast<long long>(d),
+			static_cast<long long>(rem / 3600000),
+			static_cast<long long>(rem / 60000 % 60),
+			static_cast<long long>(rem / 1000 % 60),
+			static_cast<long long>(rem % 1000)
+		);
+		return buffer;
+	}
+
+	class Writer {
+		public:
+			Writer(Rng &rng, int64_t startMs): m_rng(rng), m_nowMs(startMs) {}
+
+			void line(const char *category, const string &text) {
+				m_nowMs += static_cast<int64_t>(m_rng.below(400));
+				char prefix[64];
+				std::snprintf(
+					prefix,
+					sizeof(prefix),
+					",%u.%06u,%04llx,6 [",
+					static_cast<unsigned>(m_rng.below(100)),
+					static_cast<unsigned>(m_rng.below(1000000)),
+					static_cast<unsigned long long>(m_rng.below(0x10000))
+				);
+				m_out += isoTimestamp(m_nowMs);
+				m_out += prefix;
+				m_out += category;
+				m_out += "] ";
+				m_out += text;
+				m_out += '\n';
+			}
+
+			string &out() { return m_out; }
+
+		private:
+			Rng &m_rng;
+			int64_t m_nowMs;
+			string m_out;
+	};
+
+	string randomGuid(Rng &rng) {
+		uint64_t hi = rng.next();
+		uint64_t lo = rng.next();
+		char buffer[40];
+		std::snprintf(
+			buffer,
+			sizeof(buffer),
+			"%08llx-%04llx-%04llx-%04llx-%012llx",
+			static_cast<unsigned long long>(hi >> 32),
+			static_cast<unsigned long long>((hi >> 16) & 0xFFFF),
+			static_cast<unsigned long long>(hi & 0xFFFF),
+			static_cast<unsigned long long>(lo >> 48),
+			static_cast<unsigned long long>(lo & 0xFFFFFFFFFFFFULL)
+		);
+		return buffer;
+	}
+
+	void fillerLine(Writer &writer, Rng &rng, const Bench::LogGeneratorOptions &options) {
+		if (rng.unit() < options.noise) {
+			writer.line(pick(rng, kCategories), pick(rng, kNearMisses));
+		} else if (rng.unit() < options.outputRatio) {
+			writer.line("FLog::Output", pick(rng, kFillerText));
+		} else {
+			writer.line(pick(rng, kCategories), pick(rng, kFillerText));
+		}
+	}
+} // namespace
+
+namespace Bench {
+	string generateRobloxLog(const LogGeneratorOptions &options) {
+		Rng rng {options.seed};
+		Writer writer(rng, options.startMs);
+		writer.out().reserve(options.targetBytes + 4096);
+
+		uint64_t userId = 1000000 + rng.below(4000000000ULL);
+		writer.line("FLog::Output", "The channel is production");
+		writer.line(
+			"FLog::ClientRunInfo",
+			"{\"version\":\"version-" + std::to_string(rng.next() % 0xFFFFFFFFFFFFULL) + "\",\"platform\":\"Win64\"}"
+		);
+		writer.line("FLog::Output", "Authenticated as userId = " + std::to_string(userId));
+
+		int sessions = options.sessions > 0 ? options.sessions : 0;
+		size_t sessionSpacing = options.targetBytes / static_cast<size_t>(sessions + 1);
+		int emitted = 0;
+		while (writer.out().size() < options.targetBytes || emitted < sessions) {
+			if (emitted < sessions && writer.out().size() >= sessionSpacing * static_cast<size_t>(emitted + 1)) {
+				uint64_t placeId = 1000000 + rng.below(20000000000ULL);
+				uint64_t universeId = 100000 + rng.below(9000000000ULL);
+				writer.line(
+					"FLog::Output",
+					"! Joining game '" + randomGuid(rng) + "' place " + std::to_string(placeId) + " at 10.0.0."
+						+ std::to_string(rng.below(255))
+				);
+				writer.line(
+					"FLog::GameJoinLoadTime",
+					"Report game_join_loadtime: placeid:" + std::to_string(placeId)
+						+ ", universeid:" + std::to_string(universeId) + ", userid:" + std::to_string(userId)
+				);
+				writer.line(
+					"FLog::Network",
+					"UDMUX Address = 128.116." + std::to_string(rng.below(256)) + "." + std::to_string(rng.below(256))
+						+ ", Port = " + std::to_string(49152 + rng.below(16384))
+						+ " | RCC Server Address = 10.1.2.3, Port = 60000"
+				);
+				++emitted;
+				continue;
+			}
+			fillerLine(writer, rng, options);
+		}
+		return std::move(writer.out());
+	}
+
+	string generatedLogName(uint64_t seed, int index) {
+		char buffer[96];
+		std::snprintf(
+			buffer,
+			sizeof(buffer),
+			"0.620.0.6200%03d_20240501T%06dZ_Player_%05llx_last.log",
+			index % 1000,
+			index % 1000000,
+			static_cast<unsigned long long>((seed * 2654435761ULL + static_cast<uint64_t>(index)) & 0xFFFFF)
+		);
+		return buffer;
+	}
+} // namespace Bench
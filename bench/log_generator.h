@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace Bench {
+	struct LogGeneratorOptions {
+			size_t targetBytes = 256 * 1024; // Approximate output size; filler lines pad up to it
+			int sessions = 3; // Game joins spread evenly through the log
+			double noise = 0.1; // Fraction of filler lines that contain near-miss parser tokens
+			double outputRatio = 0.2; // Fraction of filler lines tagged [FLog::Output]
+			uint64_t seed = 1;
+			int64_t startMs = 1714566896000; // 2024-05-01T12:34:56Z
+	};
+
+	// Deterministic Roblox client log: same options, same bytes, on every platform
+	std::string generateRobloxLog(const LogGeneratorOptions &options);
+
+	// Roblox-style log file name for the index-th generated log
+	std::string generatedLogName(uint64_t seed, int index);
+} // namespace Bench
@@ -0,0 +1,140 @@
+// Structured logging benchmark: caller-side cost per record, writer throughput and binary round trip.
+//
+//   logging_bench [--records N] [--threads N] [--dir PATH]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "alloc_counter.h"
+
+#include "core/structured_log.h"
+
+namespace fs = std::filesystem;
+using std::string;
+using std::vector;
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+		int records = 200000;
+		int threads = 4;
+		string dir;
+};
+
+static bool parseArgs(int argc, char **argv, Options &options) {
+	for (int i = 1; i < argc; ++i) {
+		string arg = argv[i];
+		auto value = [&]() -> const char * { return i + 1 < argc ? argv[++i] : nullptr; };
+		const char *v = nullptr;
+		if (arg == "--records" && (v = value())) {
+			options.records = (std::max)(1, std::atoi(v));
+		} else if (arg == "--threads" && (v = value())) {
+			options.threads = (std::max)(1, std::atoi(v));
+		} else if (arg == "--dir" && (v = value())) {
+			options.dir = v;
+		} else {
+			std::fprintf(stderr, "unknown or incomplete argument: %s\n", arg.c_str());
+			return false;
+		}
+	}
+	return true;
+}
+
+static void writeRecord(int i) {
+	StructuredLog::Write(
+		StructuredLog::Level::Info,
+		"bench",
+		"Fetched server page",
+		{{"placeId", 1818ULL + static_cast<uint64_t>(i)}, {"page", i % 50}, {"ms", 12.5}, {"cursor", "abc123"}}
+	);
+}
+
+// Records per thread are paced in bursts the queue can absorb, so the timing is the enqueue path rather than drops
+static void benchMode(const Options &options, const fs::path &dir, bool binary) {
+	std::error_code ec;
+	fs::remove_all(dir, ec);
+
+	StructuredLog::Options logOptions;
+	logOptions.directory = dir.string();
+	logOptions.binary = binary;
+	logOptions.maxFileBytes = 1024 * 1024;
+	logOptions.maxFiles = 4;
+	StructuredLog::Start(logOptions);
+
+	uint64_t droppedBefore = StructuredLog::DroppedRecords();
+	std::atomic<int64_t> callNanos {0};
+	Bench::AllocScope scope;
+	auto start = Clock::now();
+	vector<std::thread> threads;
+	int perThread = options.records / options.threads;
+	for (int t = 0; t < options.threads; ++t) {
+		threads.emplace_back([&, t]() {
+			int64_t nanos = 0;
+			for (int done = 0; done < perThread;) {
+				int burst = (std::min)(256, perThread - done);
+				auto burstStart = Clock::now();
+				for (int i = 0; i < burst; ++i) { writeRecord(t * perThread + done + i); }
+				nanos += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - burstStart).count();
+				done += burst;
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+			callNanos += nanos;
+		});
+	}
+	for (auto &thread : threads) { thread.join(); }
+	StructuredLog::Stop();
+	double totalMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	Bench::AllocStats allocs = scope.stats();
+
+	uint64_t bytes = 0;
+	int files = 0;
+	for (const auto &entry : fs::directory_iterator(dir, ec)) {
+		bytes += entry.file_size(ec);
+		++files;
+	}
+	int written = perThread * options.threads;
+	std::printf(
+		"%-6s %8d records  %6.1f ns/call  %8.1f ms total  %6llu dropped  %6llu allocs  %d files  %.2f MB\n",
+		binary ? "binary" : "text",
+		written,
+		static_cast<double>(callNanos.load()) / written,
+		totalMs,
+		static_cast<unsigned long long>(StructuredLog::DroppedRecords() - droppedBefore),
+		static_cast<unsigned long long>(allocs.count),
+		files,
+		static_cast<double>(bytes) / (1024.0 * 1024.0)
+	);
+
+	if (binary) {
+		std::ifstream in(dir / "altman.bin", std::ios::binary);
+		std::ostringstream text;
+		bool ok = StructuredLog::DecodeBinary(in, text);
+		string decoded = text.str();
+		size_t lines = static_cast<size_t>(std::count(decoded.begin(), decoded.end(), '\n'));
+		std::printf("decode %8zu records  %s\n", lines, ok ? "ok" : "FAILED");
+		if (!decoded.empty()) { std::printf("  %s", decoded.substr(0, decoded.find('\n') + 1).c_str()); }
+	}
+}
+
+int main(int argc, char **argv) {
+	Options options;
+	if (!parseArgs(argc, argv, options)) { return 2; }
+
+	fs::path dir = options.dir.empty() ? fs::temp_directory_path() / "altman_logging_bench" : fs::path(options.dir);
+	std::printf("logging_bench: %d records over %d threads\n", options.records, options.threads);
+	benchMode(options, dir / "text", false);
+	benchMode(options, dir / "binary", true);
+
+	std::error_code ec;
+	if (options.dir.empty()) { fs::remove_all(dir, ec); }
+	return 0;
+}
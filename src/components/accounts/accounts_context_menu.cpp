@@ -22,6 +22,8 @@
 #include "../../utils/network/roblox/common.h"
 #include "../context_menus.h"
 #include "../data.h"
+#include "../history/log_watcher.h"
+#include "../history/session_store.h"
 #include "../webview_helpers.h"
 #include "accounts_join_ui.h"
 #include "core/logging.hpp"
@@ -80,7 +82,14 @@ void RenderAccountContextMenu(AccountData &account, const string &unique_context
 		// If user is InGame but cached placeId/jobId are missing, kick off a non-blocking fetch once
 		if (IsWindowAppearing()) {
 			if (account.status == "InGame" && account.placeId == 0 && !account.userId.empty()) {
-				if (g_presenceFetchInFlight.find(account.id) == g_presenceFetchInFlight.end()) {
+				// A Roblox client on this machine already told us where the account is; no request needed
+				GameSession liveSession;
+				uint64_t liveUserId = strtoull(account.userId.c_str(), nullptr, 10);
+				if (LogWatcher::LatestSessionForUser(liveUserId, liveSession) && liveSession.placeId != 0
+					&& !liveSession.jobId.empty()) {
+					account.placeId = liveSession.placeId;
+					account.jobId = formatJobGuid(liveSession.jobId);
+				} else if (g_presenceFetchInFlight.find(account.id) == g_presenceFetchInFlight.end()) {
 					g_presenceFetchInFlight.insert(account.id);
 					auto creds = AccountUtils::credentialsFromAccount(account);
 					Threading::newThread([acctId = account.id, userIdStr = account.userId, creds]() {
@@ -1,4 +1,7 @@
 #include "inventory.h"
+#include "ownership_index.h"
+#include "texture_residency.h"
+#include "thumbnail_service.h"
 
 #include "../data.h"
 #include "system/main_thread.h"
@@ -6,12 +9,15 @@
 #include "ui/image.h"
 #include "network/roblox.h"
 #include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <cmath>
+#include <cstdlib>
 #include <cstring>
 #include <d3d11.h>
 #include <imgui.h>
 #include <imgui_internal.h> // for ImGuiListClipper
+#include <iterator>
 #include <nlohmann/json.hpp>
 #include <string>
 #include <unordered_map>
@@ -26,23 +32,37 @@ struct InventoryItem {
 		std::string assetName;
 };
 
+// One asset type's inventory, loaded a page at a time as the grid scrolls towards its end
+struct InventoryPages {
+		std::vector<InventoryItem> items;
+		std::string nextCursor; // Cursor of the next page to fetch
+		bool complete {false}; // Every page has arrived
+		bool loading {false}; // A page request is in flight
+		bool failed {false}; // The last page request failed
+};
+
+// Grid rows beyond the visible ones that should already be loaded, so scrolling rarely reaches the end of the items
+constexpr int kInventoryPrefetchRows = 12;
+
+// Bumped when the shown asset type or account changes. Page requests of older generations are not sent if they have
+// not started yet, and their results are dropped.
+static std::atomic<uint64_t> s_inventoryGeneration {0};
+
 struct CategoryInfo {
 		std::string displayName; // e.g. "Accessories"
 		std::vector<std::pair<int, std::string>> assetTypes; // pair<assetTypeId, displayName>
 };
 
-struct ThumbInfo {
-		ID3D11ShaderResourceView *srv {nullptr};
-		int width {0};
-		int height {0};
-		bool loading {false};
-		bool failed {false};
-};
+// Thumbnails not drawn for this many frames may be freed once the textures exceed g_thumbnailMemoryBudgetMb
+constexpr uint64_t kThumbMinIdleFrames = 120;
 
-static std::unordered_map<uint64_t, ThumbInfo> s_thumbCache; // key = assetId
+// Asset thumbnails are the same for every account, so textures are kept across account switches
+static TextureResidency s_thumbCache(static_cast<size_t>(128) * 1024 * 1024, kThumbMinIdleFrames); // key = assetId
 
 // Rounded corner radius for thumbnail buttons
 constexpr float kThumbRounding = 6.0f;
+// Avatar images are fetched at this size and shrunk to the pane
+constexpr int kAvatarFetchEdge = 420;
 
 // Selected inventory asset (for outline highlight)
 static uint64_t s_selectedAssetId = 0;
@@ -53,9 +73,92 @@ static bool s_equippedLoading = false;
 static bool s_equippedFailed = false;
 static std::vector<uint64_t> s_equippedAssetIds;
 
-// Limit concurrent thumbnail fetches to avoid hammering the thumbnail API.
-static int s_activeThumbLoads = 0;
-constexpr int kMaxConcurrentThumbLoads = 24; // tweak as needed
+// Account name for an indexed owner, falling back to the user id for accounts no longer in the list
+static std::string ownerLabel(uint64_t userId) {
+	std::string id = std::to_string(userId);
+	for (const auto &acc : g_accounts) {
+		if (acc.userId != id) { continue; }
+		return acc.displayName.empty() ? acc.username : acc.displayName + " (@" + acc.username + ")";
+	}
+	return id;
+}
+
+static std::vector<OwnershipIndex::Account> ownershipTargets(bool selectedOnly) {
+	std::vector<OwnershipIndex::Account> targets;
+	for (const auto &acc : g_accounts) {
+		if (selectedOnly && !g_selectedAccountIds.count(acc.id)) { continue; }
+		uint64_t userId = 0;
+		try {
+			userId = std::stoull(acc.userId);
+		} catch (...) { continue; }
+		targets.push_back({userId, Roblox::makeAuthConfig(acc.cookie, acc.hbaPrivateKey, acc.hbaEnabled)});
+	}
+	return targets;
+}
+
+// Index controls and "who owns this asset" lookup under the equipped items
+static void renderOwnershipIndex() {
+	static char s_ownerQuery[24] = "";
+	static uint64_t s_countGeneration = UINT64_MAX;
+	static size_t s_assetCount = 0;
+
+	Spacing();
+	SeparatorText("Owned by accounts");
+
+	OwnershipIndex::Progress progress = OwnershipIndex::CurrentProgress();
+	if (progress.running) {
+		Text("Indexing accounts %zu/%zu (%zu pages)...", progress.accountsDone, progress.accountsTotal, progress.pages);
+		SameLine();
+		if (SmallButton("Cancel##ownership")) { OwnershipIndex::Cancel(); }
+	} else {
+		if (Button("Index all accounts")) { OwnershipIndex::Refresh(ownershipTargets(false), false); }
+		if (IsItemHovered()) { SetTooltip("Accounts indexed in the last few hours are skipped."); }
+		if (!g_selectedAccountIds.empty()) {
+			SameLine();
+			if (Button("Reindex selected")) { OwnershipIndex::Refresh(ownershipTargets(true), true); }
+		}
+		if (progress.accountsFailed > 0) {
+			TextDisabled("%zu accounts could not be indexed.", progress.accountsFailed);
+		}
+	}
+
+	uint64_t generation = OwnershipIndex::Generation();
+	if (generation != s_countGeneration) {
+		s_countGeneration = generation;
+		s_assetCount = OwnershipIndex::AssetCount();
+	}
+	TextDisabled("%zu items indexed", s_assetCount);
+
+	SetNextItemWidth(-FLT_MIN);
+	InputTextWithHint(
+		"##ownerLookup",
+		"Asset ID",
+		s_ownerQuery,
+		sizeof(s_ownerQuery),
+		ImGuiInputTextFlags_CharsDecimal
+	);
+	uint64_t assetId = std::strtoull(s_ownerQuery, nullptr, 10);
+	if (assetId != 0) {
+		std::vector<uint64_t> owners = OwnershipIndex::OwnersOf(assetId);
+		if (owners.empty()) { TextDisabled("No indexed account owns this item."); }
+		for (uint64_t owner : owners) { BulletText("%s", ownerLabel(owner).c_str()); }
+	}
+}
+
+// Queues the item's thumbnail with the thumbnail service; on-screen items requested in the same frame share one
+// metadata call
+static void requestAssetThumbnail(uint64_t assetId, ResidentTexture &thumb) {
+	thumb.loading = true;
+	Thumbnails::Request({ThumbnailType::Asset, assetId, "75x75"}, [assetId](bool ok, DecodedImage image) {
+		if (!ok) {
+			s_thumbCache.setTexture(assetId, nullptr, 0, 0);
+			return;
+		}
+		TextureUploads::Post(std::move(image), [assetId](ID3D11ShaderResourceView *srv, int w, int h) {
+			s_thumbCache.setTexture(assetId, srv, w, h);
+		});
+	});
+}
 
 void RenderInventoryTab() {
 	// Persistent state across frames
@@ -66,6 +169,7 @@ void RenderInventoryTab() {
 	static bool s_failed = false;
 	static bool s_started = false;
 	static uint64_t s_loadedUserId = 0; // UserId that the current texture belongs to
+	static int s_avatarEdge = 0; // Size the newest avatar request was shrunk to
 
 	static uint64_t s_catUserId = 0; // userId categories were fetched for
 	static bool s_catLoading = false;
@@ -73,13 +177,16 @@ void RenderInventoryTab() {
 	static std::vector<CategoryInfo> s_categories;
 	static int s_selectedCategory = 0; // tab index
 
-	static std::unordered_map<int, std::vector<InventoryItem>> s_cachedInventories; // key = assetTypeId
+	static std::unordered_map<int, InventoryPages> s_cachedInventories; // key = assetTypeId
 	static int s_selectedAssetTypeIndex = 0; // dropdown index inside selected category
-	static bool s_invLoading = false;
-	static bool s_invFailed = false;
+	static int s_shownAssetTypeId = 0; // Asset type whose pages are being fetched
 
 	static char s_searchBuffer[64] = "";
 
+	// Free thumbnails scrolled out of view long ago, using last frame's draws
+	s_thumbCache.setBudget(static_cast<size_t>(g_thumbnailMemoryBudgetMb) * 1024 * 1024);
+	s_thumbCache.endFrame();
+
 	// Determine which user we should show
 	uint64_t currentUserId = 0;
 	Roblox::HBA::AuthConfig currentAuth;
@@ -127,14 +234,9 @@ void RenderInventoryTab() {
 		s_selectedCategory = 0;
 		s_selectedAssetTypeIndex = 0;
 		s_cachedInventories.clear();
-		s_invLoading = false;
-		s_invFailed = false;
+		s_shownAssetTypeId = 0;
+		++s_inventoryGeneration;
 		s_searchBuffer[0] = '\0';
-		// Clear thumbnail cache for previous user
-		for (auto &p : s_thumbCache) {
-			if (p.second.srv) { p.second.srv->Release(); }
-		}
-		s_thumbCache.clear();
 		// reset equipped list state
 		s_equippedUserId = 0;
 		s_equippedLoading = false;
@@ -148,62 +250,54 @@ void RenderInventoryTab() {
 		return;
 	}
 
-	// Kick off download once per userId
-	if (!s_started) {
-		s_started = true;
-		s_loading = true;
-
-		Threading::newThread([currentUserId] {
-			// 420×420 PNG full-body avatar image
-			std::string metaUrl = "https://thumbnails.roblox.com/v1/users/avatar?userIds="
-								+ std::to_string(currentUserId) + "&size=420x420&format=Png";
-
-			auto metaResp = HttpClient::get(metaUrl);
-			if (metaResp.status_code != 200 || metaResp.text.empty()) {
-				MainThread::Post([] {
+	// Layout: left 35% width child for the avatar image
+	float availWidth = GetContentRegionAvail().x;
+	float leftWidth = availWidth * 0.35f;
+	float avatarWidth = leftWidth - GetStyle().ItemSpacing.x * 2;
+
+	// 420×420 PNG full-body avatar image, shrunk to the pane width before upload. A texture that is already showing
+	// stays until its replacement arrives.
+	auto requestAvatar = [currentUserId](int edge) {
+		s_avatarEdge = edge;
+		Thumbnails::Request(
+			{ThumbnailType::Avatar, currentUserId, "420x420"},
+			[currentUserId](bool ok, DecodedImage image) {
+				// Discard if the account changed while the image was loading
+				if (currentUserId != s_loadedUserId) { return; }
+				if (!ok) {
+					s_failed = s_texture == nullptr;
 					s_loading = false;
-					s_failed = true;
-				});
-				return;
-			}
-
-			nlohmann::json metaJson = HttpClient::decode(metaResp);
-			std::string avatarUrl;
-			try {
-				if (metaJson.contains("data") && !metaJson["data"].empty()
-					&& metaJson["data"][0].contains("imageUrl")) {
-					avatarUrl = metaJson["data"][0]["imageUrl"].get<std::string>();
+					return;
 				}
-			} catch (...) { avatarUrl.clear(); }
-
-			if (avatarUrl.empty()) {
-				MainThread::Post([] {
-					s_loading = false;
-					s_failed = true;
-				});
-				return;
-			}
-
-			auto imgResp = HttpClient::get(avatarUrl);
-			if (imgResp.status_code != 200 || imgResp.text.empty()) {
-				MainThread::Post([] {
+				TextureUploads::Post(std::move(image), [currentUserId](ID3D11ShaderResourceView *srv, int w, int h) {
+					if (currentUserId != s_loadedUserId) {
+						if (srv) { srv->Release(); }
+						return;
+					}
 					s_loading = false;
-					s_failed = true;
+					if (!srv) {
+						s_failed = s_texture == nullptr;
+						return;
+					}
+					if (s_texture) { s_texture->Release(); }
+					s_texture = srv;
+					s_imageWidth = w;
+					s_imageHeight = h;
+					s_failed = false;
 				});
-				return;
-			}
-
-			std::string data = std::move(imgResp.text);
+			},
+			edge
+		);
+	};
 
-			MainThread::Post([data = std::move(data)]() mutable {
-				if (LoadTextureFromMemory(data.data(), data.size(), &s_texture, &s_imageWidth, &s_imageHeight)) {
-					s_failed = false;
-				} else {
-					s_failed = true;
-				}
-				s_loading = false;
-			});
-		});
+	// Kick off download once per userId
+	if (!s_started) {
+		s_started = true;
+		s_loading = true;
+		requestAvatar((std::max)(1, static_cast<int>(std::ceil(avatarWidth))));
+	} else if (s_texture && s_avatarEdge < kAvatarFetchEdge && avatarWidth > s_avatarEdge * 1.15f) {
+		// The pane grew well past the texture; fetch a sharper one (normally from the disk cache)
+		requestAvatar((std::max)(1, static_cast<int>(std::ceil(avatarWidth))));
 	}
 
 	// Kick off categories fetch once
@@ -254,14 +348,10 @@ void RenderInventoryTab() {
 		});
 	}
 
-	// Layout: left 35% width child for the avatar image
-	float availWidth = GetContentRegionAvail().x;
-	float leftWidth = availWidth * 0.35f;
-
 	BeginChild("AvatarImagePane", ImVec2(leftWidth, 0), true);
 
 	if (s_texture && !s_loading) {
-		float desiredWidth = leftWidth - GetStyle().ItemSpacing.x * 2;
+		float desiredWidth = avatarWidth;
 		float desiredHeight
 			= (s_imageWidth > 0) ? (desiredWidth * static_cast<float>(s_imageHeight) / s_imageWidth) : 0.0f;
 		Image(ImTextureID(reinterpret_cast<void *>(s_texture)), ImVec2(desiredWidth, desiredHeight));
@@ -340,54 +430,8 @@ void RenderInventoryTab() {
 		for (uint64_t aid : s_equippedAssetIds) {
 			if (index % equipColumns != 0) { SameLine(); }
 
-			auto &thumb = s_thumbCache[aid];
-			if (!thumb.srv && !thumb.loading && !thumb.failed && s_activeThumbLoads < kMaxConcurrentThumbLoads) {
-				thumb.loading = true;
-				++s_activeThumbLoads;
-				Threading::newThread([assetId = aid]() {
-					// identical download logic as before
-					auto finish = [assetId](bool success) {
-						MainThread::Post([assetId, success]() {
-							auto &ti = s_thumbCache[assetId];
-							ti.loading = false;
-							ti.failed = !success;
-							--s_activeThumbLoads;
-						});
-					};
-					std::string metaUrl = "https://thumbnails.roblox.com/v1/assets?assetIds=" + std::to_string(assetId)
-										+ "&size=75x75&format=Png";
-					auto metaResp = HttpClient::get(metaUrl);
-					if (metaResp.status_code != 200 || metaResp.text.empty()) {
-						finish(false);
-						return;
-					}
-					nlohmann::json metaJson = HttpClient::decode(metaResp);
-					std::string imageUrl;
-					try {
-						if (metaJson.contains("data") && !metaJson["data"].empty()) {
-							const auto &d = metaJson["data"][0];
-							if (d.contains("imageUrl")) { imageUrl = d["imageUrl"].get<std::string>(); }
-						}
-					} catch (...) { imageUrl.clear(); }
-					if (imageUrl.empty()) {
-						finish(false);
-						return;
-					}
-					auto imgResp = HttpClient::get(imageUrl);
-					if (imgResp.status_code != 200 || imgResp.text.empty()) {
-						finish(false);
-						return;
-					}
-					std::string data = std::move(imgResp.text);
-					MainThread::Post([assetId, data = std::move(data)]() mutable {
-						auto &ti = s_thumbCache[assetId];
-						bool ok = LoadTextureFromMemory(data.data(), data.size(), &ti.srv, &ti.width, &ti.height);
-						ti.loading = false;
-						ti.failed = !ok;
-						--s_activeThumbLoads;
-					});
-				});
-			}
+			ResidentTexture &thumb = s_thumbCache.touch(aid);
+			if (!thumb.srv && !thumb.loading && !thumb.failed) { requestAssetThumbnail(aid, thumb); }
 
 			// Ensure unique ImGui IDs for each equipped item to avoid conflicts.
 			PushID(index);
@@ -417,6 +461,8 @@ void RenderInventoryTab() {
 		}
 	}
 
+	renderOwnershipIndex();
+
 	EndChild();
 
 	SameLine();
@@ -470,12 +516,12 @@ void RenderInventoryTab() {
 	int assetTypeId = s_categories[s_selectedCategory].assetTypes[s_selectedAssetTypeIndex].first;
 
 	// Build dynamic hint text like "Search 53 items" when inventory is available
-	int itemCountHint = 0;
+	std::string searchHint = "Search items";
 	auto itHintInv = s_cachedInventories.find(assetTypeId);
-	if (itHintInv != s_cachedInventories.end()) { itemCountHint = static_cast<int>(itHintInv->second.size()); }
-
-	std::string searchHint
-		= itemCountHint > 0 ? ("Search " + std::to_string(itemCountHint) + " items") : "Search items";
+	if (itHintInv != s_cachedInventories.end() && !itHintInv->second.items.empty()) {
+		searchHint = "Search " + std::to_string(itHintInv->second.items.size())
+				   + (itHintInv->second.complete ? " items" : "+ items");
+	}
 
 	// Search input
 	PushItemWidth(inputWidth);
@@ -502,36 +548,33 @@ void RenderInventoryTab() {
 
 	Separator();
 
-	// Fetch inventory if not cached
-	auto itInv = s_cachedInventories.find(assetTypeId);
-	if (itInv == s_cachedInventories.end() && !s_invLoading) {
-		s_invLoading = true;
-		s_invFailed = false;
-		Threading::newThread([currentUserId, auth = currentAuth, assetTypeId] {
-			std::vector<InventoryItem> items;
+	// Switching asset type cancels the previous type's page request; its loaded pages stay cached and continue
+	// from their cursor when the type is shown again
+	if (assetTypeId != s_shownAssetTypeId) {
+		s_shownAssetTypeId = assetTypeId;
+		++s_inventoryGeneration;
+		for (auto &[typeId, pages] : s_cachedInventories) { pages.loading = false; }
+	}
 
-			std::string cursor; // pagination cursor, empty for first page
-			bool anyError = false;
-			while (!anyError) {
-				std::string url = "https://inventory.roblox.com/v2/users/" + std::to_string(currentUserId)
-								+ "/inventory/" + std::to_string(assetTypeId) + "?limit=100&sortOrder=Asc";
-				if (!cursor.empty()) { url += "&cursor=" + cursor; }
-
-				auto resp = Roblox::AuthenticatedHttp::get(url, auth);
-				if (resp.status_code != 200 || resp.text.empty()) {
-					anyError = true;
-					break;
-				}
+	// Fetches the page after the ones already loaded and appends it on arrival
+	auto fetchNextPage = [currentUserId, &currentAuth, assetTypeId](InventoryPages &pages) {
+		pages.loading = true;
+		pages.failed = false;
+		uint64_t generation = s_inventoryGeneration;
+		Threading::newThread([currentUserId, auth = currentAuth, assetTypeId, cursor = pages.nextCursor, generation] {
+			if (generation != s_inventoryGeneration) { return; }
 
-				nlohmann::json j;
-				try {
-					j = HttpClient::decode(resp);
-				} catch (...) {
-					anyError = true;
-					break;
-				}
+			std::string url = "https://inventory.roblox.com/v2/users/" + std::to_string(currentUserId) + "/inventory/"
+							+ std::to_string(assetTypeId) + "?limit=100&sortOrder=Asc";
+			if (!cursor.empty()) { url += "&cursor=" + cursor; }
 
+			std::vector<InventoryItem> items;
+			std::string nextCursor;
+			bool ok = false;
+			auto resp = Roblox::AuthenticatedHttp::get(url, auth);
+			if (resp.status_code == 200 && !resp.text.empty()) {
 				try {
+					nlohmann::json j = HttpClient::decode(resp);
 					if (j.contains("data")) {
 						for (auto &it : j["data"]) {
 							InventoryItem ii;
@@ -540,40 +583,52 @@ void RenderInventoryTab() {
 							items.push_back(std::move(ii));
 						}
 					}
-				} catch (...) {}
-
-				// Check for pagination cursor
-				cursor.clear();
-				try {
 					if (j.contains("nextPageCursor") && !j["nextPageCursor"].is_null()) {
-						cursor = j["nextPageCursor"].get<std::string>();
+						nextCursor = j["nextPageCursor"].get<std::string>();
 					}
+					ok = true;
 				} catch (...) {}
-
-				if (cursor.empty()) {
-					break; // no more pages
-				}
 			}
 
-			MainThread::Post([assetTypeId, anyError, items = std::move(items)]() mutable {
-				if (!anyError) {
-					s_cachedInventories[assetTypeId] = std::move(items);
-					s_invFailed = false;
-				} else {
-					s_invFailed = true;
+			MainThread::Post([assetTypeId, generation, ok, items = std::move(items), nextCursor]() mutable {
+				if (generation != s_inventoryGeneration) { return; }
+				auto it = s_cachedInventories.find(assetTypeId);
+				if (it == s_cachedInventories.end()) { return; }
+				InventoryPages &pages = it->second;
+				pages.loading = false;
+				if (!ok) {
+					pages.failed = true;
+					return;
 				}
-				s_invLoading = false;
+				pages.items.insert(
+					pages.items.end(),
+					std::make_move_iterator(items.begin()),
+					std::make_move_iterator(items.end())
+				);
+				pages.nextCursor = std::move(nextCursor);
+				pages.complete = pages.nextCursor.empty();
 			});
 		});
+	};
+
+	// The first page is requested as soon as the type is shown
+	auto itInv = s_cachedInventories.find(assetTypeId);
+	if (itInv == s_cachedInventories.end()) {
+		itInv = s_cachedInventories.emplace(assetTypeId, InventoryPages {}).first;
+		fetchNextPage(itInv->second);
 	}
+	InventoryPages &pages = itInv->second;
 
 	// Draw inventory list / grid
-	if (s_invLoading) {
+	if (pages.items.empty() && !pages.complete && !pages.failed) {
+		if (!pages.loading) { fetchNextPage(pages); }
 		TextUnformatted("Loading items...");
-	} else if (s_invFailed) {
+	} else if (pages.items.empty() && pages.failed) {
 		TextUnformatted("Failed to load items.");
+		SameLine();
+		if (SmallButton("Retry")) { fetchNextPage(pages); }
 	} else {
-		const auto &invItems = s_cachedInventories[assetTypeId];
+		const auto &invItems = pages.items;
 		std::string filterLower;
 		{
 			std::string sb = s_searchBuffer;
@@ -616,7 +671,9 @@ void RenderInventoryTab() {
 
 		ImGuiListClipper clipper;
 		clipper.Begin(rowCount, cellSize + style.ItemSpacing.y);
+		int lastDrawnRow = 0;
 		while (clipper.Step()) {
+			lastDrawnRow = (std::max)(lastDrawnRow, clipper.DisplayEnd);
 			for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
 				int firstIdx = row * columns;
 				for (int col = 0; col < columns; ++col) {
@@ -629,60 +686,8 @@ void RenderInventoryTab() {
 					if (col > 0) { SameLine(); }
 
 					// Thumbnail handling (only start downloads for on-screen items)
-					auto &thumb = s_thumbCache[itm.assetId];
-					if (!thumb.srv && !thumb.loading && !thumb.failed
-						&& s_activeThumbLoads < kMaxConcurrentThumbLoads) {
-						thumb.loading = true;
-						++s_activeThumbLoads;
-						Threading::newThread([assetId = itm.assetId]() {
-							auto finishWithState = [assetId](bool success) {
-								MainThread::Post([assetId, success]() {
-									auto &ti = s_thumbCache[assetId];
-									ti.loading = false;
-									ti.failed = !success;
-									--s_activeThumbLoads;
-								});
-							};
-
-							std::string metaUrl = "https://thumbnails.roblox.com/v1/assets?assetIds="
-												+ std::to_string(assetId) + "&size=75x75&format=Png";
-							auto metaResp = HttpClient::get(metaUrl);
-							if (metaResp.status_code != 200 || metaResp.text.empty()) {
-								finishWithState(false);
-								return;
-							}
-
-							nlohmann::json metaJson = HttpClient::decode(metaResp);
-							std::string imageUrl;
-							try {
-								if (metaJson.contains("data") && !metaJson["data"].empty()) {
-									const auto &d = metaJson["data"][0];
-									if (d.contains("imageUrl")) { imageUrl = d["imageUrl"].get<std::string>(); }
-								}
-							} catch (...) { imageUrl.clear(); }
-
-							if (imageUrl.empty()) {
-								finishWithState(false);
-								return;
-							}
-
-							auto imgResp = HttpClient::get(imageUrl);
-							if (imgResp.status_code != 200 || imgResp.text.empty()) {
-								finishWithState(false);
-								return;
-							}
-
-							std::string data = std::move(imgResp.text);
-							MainThread::Post([assetId, data = std::move(data)]() mutable {
-								auto &ti = s_thumbCache[assetId];
-								bool ok
-									= LoadTextureFromMemory(data.data(), data.size(), &ti.srv, &ti.width, &ti.height);
-								ti.loading = false;
-								ti.failed = !ok;
-								--s_activeThumbLoads;
-							});
-						});
-					}
+					ResidentTexture &thumb = s_thumbCache.touch(itm.assetId);
+					if (!thumb.srv && !thumb.loading && !thumb.failed) { requestAssetThumbnail(itm.assetId, thumb); }
 
 					PushID(itemIndex);
 					bool itemClicked = false;
@@ -741,6 +746,11 @@ void RenderInventoryTab() {
 					if (BeginPopupContextItem("ctx")) {
 						MenuItem("Equip", nullptr, false, false); // dummy disabled
 						MenuItem("Inspect", nullptr, false, false);
+						std::vector<uint64_t> owners = OwnershipIndex::OwnersOf(itm.assetId);
+						if (!owners.empty()) {
+							SeparatorText("Owned by");
+							for (uint64_t owner : owners) { TextUnformatted(ownerLabel(owner).c_str()); }
+						}
 						EndPopup();
 					}
 
@@ -755,6 +765,19 @@ void RenderInventoryTab() {
 				}
 			}
 		}
+
+		// Later pages load as the grid nears its end; a search looks through every page
+		bool nearEnd = lastDrawnRow + kInventoryPrefetchRows >= rowCount;
+		if (!pages.complete && !pages.loading && !pages.failed && (nearEnd || !filterLower.empty())) {
+			fetchNextPage(pages);
+		}
+		if (pages.loading) {
+			TextDisabled("Loading more items...");
+		} else if (pages.failed) {
+			TextUnformatted("Failed to load more items.");
+			SameLine();
+			if (SmallButton("Retry")) { fetchNextPage(pages); }
+		}
 	}
 
 	EndChild();
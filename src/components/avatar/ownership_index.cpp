@@ -0,0 +1,382 @@
+#include "ownership_index.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "../data.h"
+#include "core/logging.hpp"
+#include "network/roblox/authenticated_http.h"
+#include "system/threading.h"
+
+using nlohmann::json;
+using Clock = std::chrono::steady_clock;
+
+static constexpr const char *kIndexFile = "ownership_index.json";
+// Accounts indexed more recently than this are skipped unless a refresh is forced
+static constexpr int64_t kFreshForMs = 6LL * 60 * 60 * 1000;
+static constexpr size_t kParallelAccounts = 4;
+// Spacing between any two inventory requests, whichever account they are for
+static constexpr std::chrono::milliseconds kMinRequestInterval {200};
+static constexpr int kMaxRetries = 5; // Per page, for HTTP 429, 5xx and network errors
+static constexpr std::chrono::milliseconds kRetryDelay {1000}; // Doubles after each failed attempt on the same page
+// Avatar item types: clothing, accessories, gear, body parts, animations, emotes, layered clothing and heads
+static constexpr const char *kAssetTypes
+	= "2,8,11,12,17,18,19,27,28,29,30,31,41,42,43,44,45,46,47,48,49,50,51,52,53,54,55,61,64,65,66,67,68,69,70,71,72,"
+	  "76,77,78,79";
+
+namespace {
+	struct AccountEntry {
+			uint64_t userId = 0;
+			int64_t indexedAtMs = 0;
+			size_t items = 0;
+	};
+
+	struct CrawlQueue {
+			std::mutex mutex;
+			std::deque<OwnershipIndex::Account> accounts;
+			size_t workersLeft = 0;
+	};
+} // namespace
+
+static std::mutex g_mutex;
+// Indexed accounts; position is the account's bit in every row, so entries are never removed or reordered
+static std::vector<AccountEntry> g_slots;
+static std::unordered_map<uint64_t, size_t> g_rows; // assetId -> row
+static std::vector<uint64_t> g_rowAssets; // row -> assetId
+static std::vector<uint64_t> g_words; // One row of g_wordsPerRow words per asset
+static size_t g_wordsPerRow = 1;
+static bool g_loaded = false;
+static uint64_t g_generation = 0;
+static OwnershipIndex::Progress g_progress;
+static std::atomic<bool> g_cancelled {false};
+
+static std::mutex g_rateMutex;
+static Clock::time_point g_nextRequest;
+
+static int64_t nowMs() {
+	using namespace std::chrono;
+	return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+// Caller holds g_mutex
+static void loadLocked() {
+	if (g_loaded) { return; }
+	g_loaded = true;
+
+	std::string path = Data::StorageFilePath(kIndexFile);
+	std::ifstream in {path};
+	if (!in.is_open()) { return; }
+	try {
+		json root;
+		in >> root;
+		size_t wordsPerRow = (std::max)(root.value("wordsPerRow", size_t {1}), size_t {1});
+		std::vector<AccountEntry> accounts;
+		for (const auto &j : root.value("accounts", json::array())) {
+			accounts.push_back({j.value("userId", 0ULL), j.value("indexedAt", 0LL), j.value("items", size_t {0})});
+		}
+		std::vector<uint64_t> rowAssets;
+		std::vector<uint64_t> words;
+		for (const auto &j : root.value("assets", json::array())) {
+			if (!j.is_array() || j.size() != wordsPerRow + 1) { continue; }
+			rowAssets.push_back(j[0].get<uint64_t>());
+			for (size_t w = 0; w < wordsPerRow; ++w) { words.push_back(j[w + 1].get<uint64_t>()); }
+		}
+		g_slots = std::move(accounts);
+		g_rowAssets = std::move(rowAssets);
+		g_words = std::move(words);
+		g_wordsPerRow = wordsPerRow;
+		for (size_t row = 0; row < g_rowAssets.size(); ++row) { g_rows[g_rowAssets[row]] = row; }
+		LOG_INFO(
+			"Loaded ownership index: " + std::to_string(g_slots.size()) + " accounts, "
+			+ std::to_string(g_rowAssets.size()) + " assets"
+		);
+	} catch (const std::exception &e) {
+		LOG_ERROR("Could not parse " + path + ": " + e.what());
+		g_slots.clear();
+		g_rows.clear();
+		g_rowAssets.clear();
+		g_words.clear();
+		g_wordsPerRow = 1;
+	}
+}
+
+static void save() {
+	json accounts = json::array();
+	json assets = json::array();
+	size_t wordsPerRow = 0;
+	{
+		std::lock_guard<std::mutex> lock(g_mutex);
+		wordsPerRow = g_wordsPerRow;
+		for (const auto &entry : g_slots) {
+			accounts.push_back({{"userId", entry.userId}, {"indexedAt", entry.indexedAtMs}, {"items", entry.items}});
+		}
+		for (size_t row = 0; row < g_rowAssets.size(); ++row) {
+			const uint64_t *words = &g_words[row * g_wordsPerRow];
+			// Assets no account owns any more are left out
+			if (std::all_of(words, words + g_wordsPerRow, [](uint64_t w) { return w == 0; })) { continue; }
+			json j = json::array({g_rowAssets[row]});
+			for (size_t w = 0; w < g_wordsPerRow; ++w) { j.push_back(words[w]); }
+			assets.push_back(std::move(j));
+		}
+	}
+
+	json index {{"wordsPerRow", wordsPerRow}, {"accounts", std::move(accounts)}, {"assets", std::move(assets)}};
+
+	// Written to a temporary file and swapped in, so a crash mid-write keeps the previous index
+	std::string path = Data::StorageFilePath(kIndexFile);
+	std::string temp = path + ".tmp";
+	{
+		std::ofstream out(temp, std::ios::trunc);
+		if (!out.is_open()) {
+			LOG_ERROR("Could not open '" + temp + "' for writing");
+			return;
+		}
+		out << index.dump();
+	}
+	std::error_code ec;
+	std::filesystem::rename(temp, path, ec);
+	if (ec) { LOG_ERROR("Could not save ownership index: " + ec.message()); }
+}
+
+// Caller holds g_mutex; bit position of the account, added (and every row widened if needed) when new
+static size_t slotForLocked(uint64_t userId) {
+	for (size_t slot = 0; slot < g_slots.size(); ++slot) {
+		if (g_slots[slot].userId == userId) { return slot; }
+	}
+	g_slots.push_back({userId, 0, 0});
+	size_t slot = g_slots.size() - 1;
+	if (slot / 64 >= g_wordsPerRow) {
+		size_t wider = g_wordsPerRow + 1;
+		std::vector<uint64_t> words(g_rowAssets.size() * wider, 0);
+		for (size_t row = 0; row < g_rowAssets.size(); ++row) {
+			std::copy_n(&g_words[row * g_wordsPerRow], g_wordsPerRow, &words[row * wider]);
+		}
+		g_words = std::move(words);
+		g_wordsPerRow = wider;
+	}
+	return slot;
+}
+
+// Caller holds g_mutex
+static size_t rowForLocked(uint64_t assetId) {
+	auto [it, inserted] = g_rows.try_emplace(assetId, g_rowAssets.size());
+	if (inserted) {
+		g_rowAssets.push_back(assetId);
+		g_words.resize(g_words.size() + g_wordsPerRow, 0);
+	}
+	return it->second;
+}
+
+static void applyAccount(uint64_t userId, const std::vector<uint64_t> &assetIds) {
+	std::lock_guard<std::mutex> lock(g_mutex);
+	size_t slot = slotForLocked(userId);
+	size_t word = slot / 64;
+	uint64_t bit = 1ULL << (slot % 64);
+	for (size_t row = 0; row < g_rowAssets.size(); ++row) { g_words[row * g_wordsPerRow + word] &= ~bit; }
+	for (uint64_t assetId : assetIds) { g_words[rowForLocked(assetId) * g_wordsPerRow + word] |= bit; }
+	g_slots[slot].indexedAtMs = nowMs();
+	g_slots[slot].items = assetIds.size();
+	++g_generation;
+}
+
+// Waits for this request's turn under the shared rate limit; returns false if cancelled meanwhile
+static bool waitForTurn() {
+	Clock::time_point turn;
+	{
+		std::lock_guard<std::mutex> lock(g_rateMutex);
+		turn = (std::max)(Clock::now(), g_nextRequest);
+		g_nextRequest = turn + kMinRequestInterval;
+	}
+	constexpr auto kSlice = std::chrono::milliseconds(50);
+	while (!g_cancelled.load()) {
+		Clock::time_point now = Clock::now();
+		if (now >= turn) { return true; }
+		std::this_thread::sleep_for((std::min)(Clock::duration(kSlice), turn - now));
+	}
+	return false;
+}
+
+// A rate limited or failing request holds back every account, not only the one that hit it
+static void backOff(int attempt) {
+	std::lock_guard<std::mutex> lock(g_rateMutex);
+	g_nextRequest = (std::max)(g_nextRequest, Clock::now() + kRetryDelay * (1 << (std::min)(attempt, 6)));
+}
+
+static bool isRetryable(int status) { return status == 0 || status == 429 || status >= 500; }
+
+// Every indexed asset in the account's inventory, or nullopt if a page failed or the crawl was cancelled
+static std::optional<std::vector<uint64_t>> crawlAccount(const OwnershipIndex::Account &account) {
+	std::unordered_set<uint64_t> assets;
+	std::unordered_set<std::string> seenCursors;
+	std::string cursor;
+	for (;;) {
+		std::string url = "https://inventory.roblox.com/v2/users/" + std::to_string(account.userId)
+						+ "/inventory?assetTypes=" + kAssetTypes + "&limit=100&sortOrder=Asc";
+		if (!cursor.empty()) { url += "&cursor=" + cursor; }
+
+		HttpClient::Response resp;
+		for (int attempt = 0;; ++attempt) {
+			if (!waitForTurn()) { return std::nullopt; }
+			resp = Roblox::AuthenticatedHttp::get(url, account.auth);
+			if (resp.status_code == 200 || !isRetryable(resp.status_code) || attempt >= kMaxRetries) { break; }
+			backOff(attempt);
+		}
+		if (resp.status_code != 200) {
+			LOG_WARN(
+				"Ownership index: inventory of " + std::to_string(account.userId)
+				+ " failed with HTTP " + std::to_string(resp.status_code)
+			);
+			return std::nullopt;
+		}
+
+		std::string next;
+		try {
+			json j = HttpClient::decode(resp);
+			for (const auto &item : j.value("data", json::array())) {
+				uint64_t assetId = item.value("assetId", 0ULL);
+				if (assetId != 0) { assets.insert(assetId); }
+			}
+			if (j.contains("nextPageCursor") && j["nextPageCursor"].is_string()) {
+				next = j["nextPageCursor"].get<std::string>();
+			}
+		} catch (const std::exception &e) {
+			LOG_WARN("Ownership index: bad inventory page for " + std::to_string(account.userId) + ": " + e.what());
+			return std::nullopt;
+		}
+		{
+			std::lock_guard<std::mutex> lock(g_mutex);
+			++g_progress.pages;
+		}
+		// A cursor seen before would loop forever; treat it as the end of the inventory
+		if (next.empty() || !seenCursors.insert(next).second) { break; }
+		cursor = std::move(next);
+	}
+	return std::vector<uint64_t>(assets.begin(), assets.end());
+}
+
+static void runWorker(const std::shared_ptr<CrawlQueue> &queue) {
+	for (;;) {
+		OwnershipIndex::Account account;
+		{
+			std::lock_guard<std::mutex> lock(queue->mutex);
+			if (queue->accounts.empty() || g_cancelled.load()) {
+				if (--queue->workersLeft != 0) { return; }
+				break;
+			}
+			account = std::move(queue->accounts.front());
+			queue->accounts.pop_front();
+		}
+
+		std::optional<std::vector<uint64_t>> assets = crawlAccount(account);
+		if (assets) { applyAccount(account.userId, *assets); }
+		std::lock_guard<std::mutex> lock(g_mutex);
+		++g_progress.accountsDone;
+		if (!assets && !g_cancelled.load()) { ++g_progress.accountsFailed; }
+	}
+
+	// The last worker out saves once for the whole crawl
+	save();
+	std::lock_guard<std::mutex> lock(g_mutex);
+	g_progress.running = false;
+	++g_generation;
+	LOG_INFO(
+		"Ownership index: " + std::to_string(g_progress.accountsDone) + "/" + std::to_string(g_progress.accountsTotal)
+		+ " accounts done, " + std::to_string(g_progress.accountsFailed) + " failed, "
+		+ std::to_string(g_progress.pages) + " pages" + (g_cancelled.load() ? " (cancelled)" : "")
+	);
+}
+
+namespace OwnershipIndex {
+	void Refresh(std::vector<Account> accounts, bool force) {
+		auto queue = std::make_shared<CrawlQueue>();
+		{
+			std::lock_guard<std::mutex> lock(g_mutex);
+			loadLocked();
+			if (g_progress.running) { return; }
+
+			int64_t now = nowMs();
+			std::unordered_set<uint64_t> seen;
+			g_progress = {};
+			for (auto &account : accounts) {
+				if (account.userId == 0 || account.auth.cookie.empty() || !seen.insert(account.userId).second) {
+					continue;
+				}
+				++g_progress.accountsTotal;
+				bool fresh = std::any_of(g_slots.begin(), g_slots.end(), [&](const AccountEntry &entry) {
+					return entry.userId == account.userId && now - entry.indexedAtMs < kFreshForMs;
+				});
+				if (fresh && !force) {
+					++g_progress.accountsDone;
+				} else {
+					queue->accounts.push_back(std::move(account));
+				}
+			}
+			if (queue->accounts.empty()) { return; }
+			g_progress.running = true;
+			g_cancelled = false;
+			queue->workersLeft = (std::min)(kParallelAccounts, queue->accounts.size());
+		}
+
+		for (size_t i = 0, workers = queue->workersLeft; i < workers; ++i) {
+			Threading::newThread([queue]() { runWorker(queue); });
+		}
+	}
+
+	void Cancel() { g_cancelled = true; }
+
+	Progress CurrentProgress() {
+		std::lock_guard<std::mutex> lock(g_mutex);
+		return g_progress;
+	}
+
+	std::vector<uint64_t> OwnersOf(uint64_t assetId) {
+		std::lock_guard<std::mutex> lock(g_mutex);
+		loadLocked();
+		std::vector<uint64_t> owners;
+		auto it = g_rows.find(assetId);
+		if (it == g_rows.end()) { return owners; }
+		const uint64_t *words = &g_words[it->second * g_wordsPerRow];
+		for (size_t slot = 0; slot < g_slots.size(); ++slot) {
+			if (words[slot / 64] & (1ULL << (slot % 64))) { owners.push_back(g_slots[slot].userId); }
+		}
+		return owners;
+	}
+
+	int64_t IndexedAtMs(uint64_t userId) {
+		std::lock_guard<std::mutex> lock(g_mutex);
+		loadLocked();
+		for (const auto &entry : g_slots) {
+			if (entry.userId == userId) { return entry.indexedAtMs; }
+		}
+		return 0;
+	}
+
+	size_t AssetCount() {
+		std::lock_guard<std::mutex> lock(g_mutex);
+		loadLocked();
+		size_t count = 0;
+		for (size_t row = 0; row < g_rowAssets.size(); ++row) {
+			const uint64_t *words = &g_words[row * g_wordsPerRow];
+			if (std::any_of(words, words + g_wordsPerRow, [](uint64_t w) { return w != 0; })) { ++count; }
+		}
+		return count;
+	}
+
+	uint64_t Generation() {
+		std::lock_guard<std::mutex> lock(g_mutex);
+		return g_generation;
+	}
+} // namespace OwnershipIndex
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "network/roblox/hba.h"
+
+// Which of the managed accounts own which avatar items. Account inventories are crawled in the background, a few
+// accounts at a time with every request spaced to stay under the rate limit, and folded into an inverted index: one
+// bitset of account slots per asset. An account's bits change only once its whole inventory has been read, so a
+// failed or cancelled crawl keeps the previous answer. The index is kept in ownership_index.json.
+namespace OwnershipIndex {
+	struct Account {
+			uint64_t userId = 0;
+			Roblox::HBA::AuthConfig auth;
+	};
+
+	struct Progress {
+			bool running = false;
+			size_t accountsDone = 0; // Finished, failed or skipped as fresh
+			size_t accountsTotal = 0;
+			size_t accountsFailed = 0;
+			size_t pages = 0;
+	};
+
+	// Crawls the accounts in the background, skipping ones indexed within the last few hours unless force is set.
+	// Ignored while a crawl is running.
+	void Refresh(std::vector<Account> accounts, bool force);
+
+	void Cancel();
+
+	Progress CurrentProgress();
+
+	// UserIds of the indexed accounts owning assetId, in the order they were first indexed
+	std::vector<uint64_t> OwnersOf(uint64_t assetId);
+
+	// When the account's inventory was last indexed, in ms since the epoch; 0 if never
+	int64_t IndexedAtMs(uint64_t userId);
+
+	// Number of distinct assets owned by any indexed account
+	size_t AssetCount();
+
+	// Changes whenever an account's ownership is updated
+	uint64_t Generation();
+} // namespace OwnershipIndex
@@ -0,0 +1,66 @@
+#include "texture_residency.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+TextureResidency::TextureResidency(size_t budgetBytes, uint64_t minIdleFrames):
+	m_budgetBytes(budgetBytes),
+	m_minIdleFrames(minIdleFrames) {}
+
+TextureResidency::~TextureResidency() { clear(); }
+
+ResidentTexture &TextureResidency::touch(uint64_t key) {
+	ResidentTexture &entry = m_entries[key];
+	entry.lastUsedFrame = m_frame;
+	return entry;
+}
+
+ResidentTexture *TextureResidency::find(uint64_t key) {
+	auto it = m_entries.find(key);
+	return it != m_entries.end() ? &it->second : nullptr;
+}
+
+void TextureResidency::setTexture(uint64_t key, ID3D11ShaderResourceView *srv, int width, int height) {
+	ResidentTexture &entry = m_entries[key];
+	release(entry);
+	entry.srv = srv;
+	entry.width = width;
+	entry.height = height;
+	entry.loading = false;
+	entry.failed = srv == nullptr;
+	entry.bytes = srv ? static_cast<size_t>(width) * height * 4 : 0;
+	m_residentBytes += entry.bytes;
+}
+
+void TextureResidency::release(ResidentTexture &entry) {
+	if (entry.srv) {
+		entry.srv->Release();
+		entry.srv = nullptr;
+	}
+	m_residentBytes -= entry.bytes;
+	entry.bytes = 0;
+}
+
+void TextureResidency::endFrame() {
+	++m_frame;
+	if (m_residentBytes <= m_budgetBytes) { return; }
+
+	std::vector<std::pair<uint64_t, uint64_t>> idle; // (last used frame, key)
+	for (const auto &[key, entry] : m_entries) {
+		bool idleLongEnough = m_frame - entry.lastUsedFrame > m_minIdleFrames;
+		if (entry.srv && idleLongEnough) { idle.emplace_back(entry.lastUsedFrame, key); }
+	}
+	std::sort(idle.begin(), idle.end());
+	for (const auto &[lastUsed, key] : idle) {
+		if (m_residentBytes <= m_budgetBytes) { break; }
+		auto it = m_entries.find(key);
+		release(it->second);
+		m_entries.erase(it);
+	}
+}
+
+void TextureResidency::clear() {
+	for (auto &[key, entry] : m_entries) { release(entry); }
+	m_entries.clear();
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <d3d11.h>
+#include <unordered_map>
+
+struct ResidentTexture {
+		ID3D11ShaderResourceView *srv {nullptr};
+		int width {0};
+		int height {0};
+		bool loading {false};
+		bool failed {false};
+		size_t bytes {0}; // Estimated GPU memory of srv
+		uint64_t lastUsedFrame {0};
+};
+
+// Thumbnail textures with a memory budget. Every texture drawn in a frame is touch()ed; once the textures held exceed
+// the budget, endFrame() releases the least recently drawn ones that have not been drawn for minIdleFrames and forgets
+// them, so the next touch() finds an empty entry and the thumbnail is requested again (normally straight from the
+// disk cache). Textures that are on screen are never evicted, even if they alone exceed the budget. Main thread only.
+class TextureResidency {
+	public:
+		TextureResidency(size_t budgetBytes, uint64_t minIdleFrames);
+
+		~TextureResidency();
+
+		TextureResidency(const TextureResidency &) = delete;
+		TextureResidency &operator=(const TextureResidency &) = delete;
+
+		// Entry for key, created if missing, marked as used this frame
+		ResidentTexture &touch(uint64_t key);
+
+		// Entry for key without marking it used; nullptr if missing
+		ResidentTexture *find(uint64_t key);
+
+		// Stores a finished upload, taking ownership of srv. A null srv marks the entry failed.
+		void setTexture(uint64_t key, ID3D11ShaderResourceView *srv, int width, int height);
+
+		void setBudget(size_t budgetBytes) { m_budgetBytes = budgetBytes; }
+
+		// Advances the frame counter and evicts down to the budget
+		void endFrame();
+
+		// Releases every texture
+		void clear();
+
+		size_t residentBytes() const { return m_residentBytes; }
+
+		size_t size() const { return m_entries.size(); }
+
+	private:
+		void release(ResidentTexture &entry);
+
+		std::unordered_map<uint64_t, ResidentTexture> m_entries;
+		size_t m_budgetBytes;
+		size_t m_residentBytes = 0;
+		uint64_t m_minIdleFrames;
+		uint64_t m_frame = 1;
+};
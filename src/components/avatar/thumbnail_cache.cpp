@@ -0,0 +1,282 @@
+#include "thumbnail_cache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <nlohmann/json.hpp>
+#include <system_error>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "../data.h"
+#include "core/logging.hpp"
+#include "system/threading.h"
+
+namespace fs = std::filesystem;
+using nlohmann::json;
+
+static constexpr uint64_t kSharedCacheBytes = 256ULL * 1024 * 1024;
+// Avatars change whenever the user changes outfit, so they are refetched after a while; asset images do not expire
+static constexpr int64_t kAvatarTtlMs = 60LL * 60 * 1000;
+// Eviction frees down to this fraction of maxBytes so it does not run again on the next put
+static constexpr double kEvictTarget = 0.9;
+// Index writes are batched; a burst of downloads saves once
+static constexpr auto kFlushDelay = std::chrono::seconds(2);
+
+ThumbnailDiskCache &SharedThumbnailDiskCache() {
+	static ThumbnailDiskCache cache(Data::StorageFilePath("thumbnails"), kSharedCacheBytes);
+	return cache;
+}
+
+static int64_t nowMs() {
+	using namespace std::chrono;
+	return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+ThumbnailDiskCache::ThumbnailDiskCache(fs::path directory, uint64_t maxBytes):
+	m_directory(std::move(directory)),
+	m_maxBytes(maxBytes) {}
+
+std::string ThumbnailDiskCache::keyOf(const ThumbnailKey &key) {
+	return std::string(key.type == ThumbnailType::Avatar ? "avatar:" : "asset:") + std::to_string(key.targetId) + ':'
+		 + key.size;
+}
+
+// FNV-1a over the contents plus their length; two different images would have to collide on both to share a file
+std::string ThumbnailDiskCache::blobNameOf(const std::string &png) {
+	uint64_t hash = 14695981039346656037ULL;
+	for (unsigned char c : png) {
+		hash ^= c;
+		hash *= 1099511628211ULL;
+	}
+	char name[48];
+	std::snprintf(name, sizeof(name), "%016llx-%zu.png", static_cast<unsigned long long>(hash), png.size());
+	return name;
+}
+
+void ThumbnailDiskCache::startLoading() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	startLoadingLocked();
+}
+
+void ThumbnailDiskCache::startLoadingLocked() {
+	if (m_loadStarted) { return; }
+	m_loadStarted = true;
+	Threading::newThread([this]() { load(); });
+}
+
+void ThumbnailDiskCache::waitLoadedLocked(std::unique_lock<std::mutex> &lock) {
+	startLoadingLocked();
+	m_loadedCv.wait(lock, [this]() { return m_loaded; });
+}
+
+void ThumbnailDiskCache::load() {
+	std::unordered_map<std::string, KeyEntry> keys;
+	std::unordered_map<std::string, Blob> blobs;
+	uint64_t totalBytes = 0;
+
+	std::error_code ec;
+	fs::create_directories(m_directory, ec);
+	std::ifstream in(m_directory / "index.json");
+	if (in.is_open()) {
+		try {
+			json root;
+			in >> root;
+			for (const auto &j : root.value("blobs", json::array())) {
+				blobs[j.value("name", "")] = {j.value("bytes", 0ULL), j.value("lastUsed", 0LL)};
+			}
+			for (const auto &j : root.value("keys", json::array())) {
+				std::string blob = j.value("blob", "");
+				if (blobs.count(blob)) { keys[j.value("key", "")] = {blob, j.value("storedAt", 0LL)}; }
+			}
+		} catch (const std::exception &e) {
+			LOG_ERROR(std::string("Could not parse thumbnail cache index: ") + e.what());
+			keys.clear();
+			blobs.clear();
+		}
+	}
+
+	// Files written after the last index save are deleted; indexed files that are gone are forgotten
+	std::unordered_set<std::string> onDisk;
+	for (const auto &entry : fs::directory_iterator(m_directory, ec)) {
+		std::string name = entry.path().filename().string();
+		if (name == "index.json") { continue; }
+		if (blobs.count(name)) {
+			onDisk.insert(name);
+		} else {
+			fs::remove(entry.path(), ec);
+		}
+	}
+	for (auto it = blobs.begin(); it != blobs.end();) {
+		if (onDisk.count(it->first)) {
+			totalBytes += it->second.bytes;
+			++it;
+		} else {
+			it = blobs.erase(it);
+		}
+	}
+	std::erase_if(keys, [&](const auto &entry) { return blobs.count(entry.second.blob) == 0; });
+	LOG_INFO(
+		"Thumbnail cache: " + std::to_string(keys.size()) + " images in " + std::to_string(blobs.size()) + " files, "
+		+ std::to_string(totalBytes / (1024 * 1024)) + " MB"
+	);
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_keys = std::move(keys);
+		m_blobs = std::move(blobs);
+		m_totalBytes = totalBytes;
+		m_loaded = true;
+	}
+	m_loadedCv.notify_all();
+}
+
+// Caller holds m_mutex and the index has loaded
+const ThumbnailDiskCache::KeyEntry *ThumbnailDiskCache::findLocked(const std::string &key, int64_t now) {
+	auto it = m_keys.find(key);
+	if (it == m_keys.end()) { return nullptr; }
+	if (key.rfind("avatar:", 0) == 0 && now - it->second.storedAtMs > kAvatarTtlMs) { return nullptr; }
+	return &it->second;
+}
+
+bool ThumbnailDiskCache::contains(const ThumbnailKey &key) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (!m_loaded) {
+		startLoadingLocked();
+		return false;
+	}
+	return findLocked(keyOf(key), nowMs()) != nullptr;
+}
+
+std::optional<std::string> ThumbnailDiskCache::get(const ThumbnailKey &key) {
+	std::string keyString = keyOf(key);
+	fs::path path;
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		waitLoadedLocked(lock);
+		int64_t now = nowMs();
+		const KeyEntry *entry = findLocked(keyString, now);
+		if (!entry) { return std::nullopt; }
+		m_blobs[entry->blob].lastUsedMs = now;
+		path = m_directory / entry->blob;
+		scheduleFlushLocked();
+	}
+
+	std::ifstream in(path, std::ios::binary);
+	std::string png((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+	if (png.empty()) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_keys.erase(keyString);
+		m_dirty = true;
+		return std::nullopt;
+	}
+	return png;
+}
+
+void ThumbnailDiskCache::put(const ThumbnailKey &key, const std::string &png) {
+	if (png.empty()) { return; }
+	std::string blob = blobNameOf(png);
+	bool write = false;
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		waitLoadedLocked(lock);
+		write = m_blobs.count(blob) == 0;
+	}
+
+	if (write) {
+		// Written under a temporary name so a crash never leaves a truncated file under the real one. Identical images
+		// downloaded at the same time each get their own temporary file; the last rename wins with the same bytes.
+		static std::atomic<uint64_t> s_tempCounter {0};
+		fs::path temp = m_directory / (blob + '.' + std::to_string(++s_tempCounter) + ".tmp");
+		{
+			std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+			out.write(png.data(), static_cast<std::streamsize>(png.size()));
+			if (!out) {
+				LOG_WARN("Could not write thumbnail to " + temp.string());
+				return;
+			}
+		}
+		std::error_code ec;
+		fs::rename(temp, m_directory / blob, ec);
+		if (ec) { return; }
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	int64_t now = nowMs();
+	auto [it, inserted] = m_blobs.try_emplace(blob, Blob {png.size(), now});
+	if (inserted) { m_totalBytes += png.size(); }
+	it->second.lastUsedMs = now;
+	m_keys[keyOf(key)] = {blob, now};
+	if (m_totalBytes > m_maxBytes) { evictLocked(); }
+	scheduleFlushLocked();
+}
+
+void ThumbnailDiskCache::evictLocked() {
+	std::vector<std::pair<int64_t, std::string>> byAge;
+	byAge.reserve(m_blobs.size());
+	for (const auto &[name, blob] : m_blobs) { byAge.emplace_back(blob.lastUsedMs, name); }
+	std::sort(byAge.begin(), byAge.end());
+
+	auto target = static_cast<uint64_t>(m_maxBytes * kEvictTarget);
+	std::error_code ec;
+	std::unordered_set<std::string> evicted;
+	for (const auto &[lastUsed, name] : byAge) {
+		if (m_totalBytes <= target) { break; }
+		fs::remove(m_directory / name, ec);
+		m_totalBytes -= m_blobs[name].bytes;
+		m_blobs.erase(name);
+		evicted.insert(name);
+	}
+	std::erase_if(m_keys, [&](const auto &entry) { return evicted.count(entry.second.blob) != 0; });
+	m_dirty = true;
+}
+
+void ThumbnailDiskCache::scheduleFlushLocked() {
+	m_dirty = true;
+	if (m_flushScheduled) { return; }
+	m_flushScheduled = true;
+	Threading::newThread([this]() {
+		std::this_thread::sleep_for(kFlushDelay);
+		flush();
+	});
+}
+
+void ThumbnailDiskCache::flush() {
+	json blobs = json::array();
+	json keys = json::array();
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_flushScheduled = false;
+		if (!m_dirty) { return; }
+		m_dirty = false;
+		for (const auto &[name, blob] : m_blobs) {
+			blobs.push_back({{"name", name}, {"bytes", blob.bytes}, {"lastUsed", blob.lastUsedMs}});
+		}
+		for (const auto &[key, entry] : m_keys) {
+			keys.push_back({{"key", key}, {"blob", entry.blob}, {"storedAt", entry.storedAtMs}});
+		}
+	}
+
+	fs::path temp = m_directory / "index.json.tmp";
+	{
+		std::ofstream out(temp, std::ios::trunc);
+		if (!out.is_open()) {
+			LOG_ERROR("Could not open '" + temp.string() + "' for writing");
+			return;
+		}
+		out << json {{"blobs", std::move(blobs)}, {"keys", std::move(keys)}}.dump();
+	}
+	std::error_code ec;
+	fs::rename(temp, m_directory / "index.json", ec);
+	if (ec) { LOG_ERROR("Could not save thumbnail cache index: " + ec.message()); }
+}
+
+uint64_t ThumbnailDiskCache::totalBytes() {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	waitLoadedLocked(lock);
+	return m_totalBytes;
+}
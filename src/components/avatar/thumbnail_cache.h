@@ -0,0 +1,87 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "thumbnail_service.h"
+
+// Thumbnail PNGs on disk, so reopening an inventory that was viewed before needs no network. Files are named after a
+// hash of their contents, so the many assets that share one image (placeholders, recolours of the same mesh) store it
+// once; index.json maps each (type, id, size) key to its file. Past maxBytes the least recently used files are
+// deleted along with every key that points at them. All methods lock; file contents are read and written outside
+// the lock. The index is loaded and saved from background threads, so an instance must outlive them.
+class ThumbnailDiskCache {
+	public:
+		ThumbnailDiskCache(std::filesystem::path directory, uint64_t maxBytes);
+
+		// Starts loading the index on a background thread if that has not started yet
+		void startLoading();
+
+		// True if key has an image that has not expired. Never touches files, so it is safe on the UI thread: until
+		// the index has loaded every key is a miss.
+		bool contains(const ThumbnailKey &key);
+
+		// The stored PNG, or nullopt if the key is missing, expired or its file is gone. Waits for the index to load,
+		// as put and totalBytes do.
+		std::optional<std::string> get(const ThumbnailKey &key);
+
+		void put(const ThumbnailKey &key, const std::string &png);
+
+		// Writes the index if anything changed since the last save; call on exit so recent files are not orphaned
+		void flush();
+
+		uint64_t totalBytes();
+
+	private:
+		using Clock = std::chrono::system_clock;
+
+		struct Blob {
+				uint64_t bytes = 0;
+				int64_t lastUsedMs = 0;
+		};
+
+		struct KeyEntry {
+				std::string blob; // File name of the content
+				int64_t storedAtMs = 0;
+		};
+
+		static std::string keyOf(const ThumbnailKey &key);
+
+		static std::string blobNameOf(const std::string &png);
+
+		// Reads the index and reconciles it with the directory, without m_mutex; nothing writes files until it is done
+		void load();
+
+		// Caller holds m_mutex
+		void startLoadingLocked();
+
+		void waitLoadedLocked(std::unique_lock<std::mutex> &lock);
+
+		const KeyEntry *findLocked(const std::string &key, int64_t now);
+
+		void evictLocked();
+
+		void scheduleFlushLocked();
+
+		std::mutex m_mutex;
+		std::condition_variable m_loadedCv;
+		std::filesystem::path m_directory;
+		uint64_t m_maxBytes;
+		uint64_t m_totalBytes = 0;
+		std::unordered_map<std::string, KeyEntry> m_keys;
+		std::unordered_map<std::string, Blob> m_blobs;
+		bool m_loadStarted = false;
+		bool m_loaded = false;
+		bool m_dirty = false;
+		bool m_flushScheduled = false;
+};
+
+// The cache under storage/thumbnails used by the thumbnail service
+ThumbnailDiskCache &SharedThumbnailDiskCache();
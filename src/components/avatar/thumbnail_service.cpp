@@ -0,0 +1,194 @@
+#include "thumbnail_service.h"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "thumbnail_cache.h"
+
+#include "core/image_decode.h"
+#include "core/image_ops.h"
+#include "core/logging.hpp"
+#include "network/http.hpp"
+#include "network/roblox/thumbnails.h"
+#include "system/main_thread.h"
+#include "system/threading.h"
+#include "system/worker_pool.h"
+
+using Clock = std::chrono::steady_clock;
+
+// How long the dispatcher waits for more requests before sending a batch
+static constexpr auto kBatchWindow = std::chrono::milliseconds(50);
+// Thumbnails still being rendered server side are polled again after this long, a few times at most
+static constexpr auto kPendingRetryDelay = std::chrono::seconds(1);
+static constexpr int kMaxMetadataPolls = 6;
+
+namespace {
+	struct Waiting {
+			std::vector<ThumbnailCallback> callbacks;
+			int displayEdge = 0;
+			int polls = 0;
+	};
+
+	struct QueuedKey {
+			ThumbnailKey key;
+			Clock::time_point due;
+	};
+} // namespace
+
+static std::mutex g_mutex;
+static std::unordered_map<ThumbnailKey, Waiting, ThumbnailKeyHash> g_waiting; // Every key not yet delivered
+static std::vector<QueuedKey> g_metadataQueue;
+static bool g_dispatcherRunning = false;
+
+static void deliver(const ThumbnailKey &key, bool ok, DecodedImage image) {
+	std::vector<ThumbnailCallback> callbacks;
+	int displayEdge = 0;
+	{
+		std::lock_guard<std::mutex> lock(g_mutex);
+		auto it = g_waiting.find(key);
+		if (it == g_waiting.end()) { return; }
+		callbacks = std::move(it->second.callbacks);
+		displayEdge = it->second.displayEdge;
+		g_waiting.erase(it);
+	}
+	// Runs on the pool thread that decoded the image, so the upload only copies finished pixels
+	if (ok) { ImageOps::PrepareForDisplay(image, displayEdge); }
+	MainThread::Post([ok, image = std::move(image), callbacks = std::move(callbacks)]() mutable {
+		// Usually there is one callback, which gets the pixels without a copy
+		for (size_t i = 0; i + 1 < callbacks.size(); ++i) { callbacks[i](ok, image); }
+		if (!callbacks.empty()) { callbacks.back()(ok, std::move(image)); }
+	});
+}
+
+static void download(const ThumbnailKey &key, std::string url) {
+	Threading::SharedPool().Post([key, url = std::move(url)]() {
+		HttpClient::Response resp = HttpClient::get(url);
+		DecodedImage image;
+		bool ok = resp.status_code == 200 && DecodeImage(resp.text.data(), resp.text.size(), image);
+		// Only images that decode are kept, so the disk cache never serves a broken file
+		if (ok) { SharedThumbnailDiskCache().put(key, resp.text); }
+		deliver(key, ok, std::move(image));
+	});
+}
+
+// Caller holds g_mutex; returns false once the key has been polled too often
+static bool requeueLocked(const ThumbnailKey &key, Clock::time_point now) {
+	auto it = g_waiting.find(key);
+	if (it == g_waiting.end() || ++it->second.polls >= kMaxMetadataPolls) { return false; }
+	g_metadataQueue.push_back({key, now + kPendingRetryDelay});
+	return true;
+}
+
+static std::vector<Roblox::ThumbnailInfo>
+fetchMetadata(ThumbnailType type, const std::vector<uint64_t> &targetIds, const std::string &size) {
+	switch (type) {
+	case ThumbnailType::Avatar: return Roblox::getAvatarThumbnails(targetIds, size);
+	case ThumbnailType::Asset:
+	default: return Roblox::getAssetThumbnails(targetIds, size);
+	}
+}
+
+static void runDispatcher() {
+	for (;;) {
+		std::this_thread::sleep_for(kBatchWindow);
+
+		// Keys that are due, grouped by what one metadata call can cover
+		std::map<std::pair<ThumbnailType, std::string>, std::vector<uint64_t>> batches;
+		{
+			std::lock_guard<std::mutex> lock(g_mutex);
+			if (g_metadataQueue.empty()) {
+				g_dispatcherRunning = false;
+				return;
+			}
+			Clock::time_point now = Clock::now();
+			std::vector<QueuedKey> later;
+			for (auto &queued : g_metadataQueue) {
+				if (queued.due > now) {
+					later.push_back(std::move(queued));
+				} else {
+					batches[{queued.key.type, queued.key.size}].push_back(queued.key.targetId);
+				}
+			}
+			g_metadataQueue = std::move(later);
+		}
+
+		for (const auto &[group, targetIds] : batches) {
+			const auto &[type, size] = group;
+			std::unordered_map<uint64_t, Roblox::ThumbnailInfo> byTarget;
+			for (auto &info : fetchMetadata(type, targetIds, size)) { byTarget[info.targetId] = std::move(info); }
+
+			std::vector<ThumbnailKey> failed;
+			{
+				std::lock_guard<std::mutex> lock(g_mutex);
+				Clock::time_point now = Clock::now();
+				for (uint64_t targetId : targetIds) {
+					ThumbnailKey key {type, targetId, size};
+					auto found = byTarget.find(targetId);
+					if (found != byTarget.end() && found->second.state == "Completed" && !found->second.imageUrl.empty()) {
+						download(key, found->second.imageUrl);
+					} else if (found == byTarget.end() || found->second.state == "Pending") {
+						// Missing targets are usually a failed request, so they get the same retries as Pending ones
+						if (!requeueLocked(key, now)) { failed.push_back(key); }
+					} else {
+						failed.push_back(key);
+					}
+				}
+			}
+			for (const auto &key : failed) { deliver(key, false, {}); }
+		}
+	}
+}
+
+// Caller holds g_mutex
+static void queueMetadataLocked(const ThumbnailKey &key) {
+	g_metadataQueue.push_back({key, Clock::now()});
+	if (!g_dispatcherRunning) {
+		g_dispatcherRunning = true;
+		Threading::newThread(runDispatcher);
+	}
+}
+
+// Serves the key from disk on a pool thread, falling back to the network if the file cannot be read or decoded
+static void loadFromDisk(const ThumbnailKey &key) {
+	Threading::SharedPool().Post([key]() {
+		DecodedImage image;
+		std::optional<std::string> png = SharedThumbnailDiskCache().get(key);
+		if (png && DecodeImage(png->data(), png->size(), image)) {
+			deliver(key, true, std::move(image));
+			return;
+		}
+		std::lock_guard<std::mutex> lock(g_mutex);
+		queueMetadataLocked(key);
+	});
+}
+
+namespace Thumbnails {
+	void Request(const ThumbnailKey &key, ThumbnailCallback onLoaded, int displayEdge) {
+		{
+			std::lock_guard<std::mutex> lock(g_mutex);
+			auto [it, inserted] = g_waiting.try_emplace(key);
+			it->second.callbacks.push_back(std::move(onLoaded));
+			if (inserted || displayEdge == 0) {
+				it->second.displayEdge = displayEdge;
+			} else if (it->second.displayEdge != 0) {
+				it->second.displayEdge = (std::max)(it->second.displayEdge, displayEdge);
+			}
+			if (!inserted) { return; }
+		}
+
+		// The disk cache is checked outside g_mutex; until its index has loaded in the background, this is a miss
+		if (SharedThumbnailDiskCache().contains(key)) {
+			loadFromDisk(key);
+			return;
+		}
+		std::lock_guard<std::mutex> lock(g_mutex);
+		queueMetadataLocked(key);
+	}
+} // namespace Thumbnails
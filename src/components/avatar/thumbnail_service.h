@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "core/image_decode.h"
+
+enum class ThumbnailType { Asset, Avatar };
+
+struct ThumbnailKey {
+		ThumbnailType type = ThumbnailType::Asset;
+		uint64_t targetId = 0;
+		std::string size; // As the thumbnails API spells it, e.g. "75x75"
+
+		bool operator==(const ThumbnailKey &other) const = default;
+};
+
+struct ThumbnailKeyHash {
+		size_t operator()(const ThumbnailKey &key) const {
+			size_t h = std::hash<uint64_t> {}(key.targetId);
+			h ^= std::hash<std::string> {}(key.size) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+			return h ^ static_cast<size_t>(key.type);
+		}
+};
+
+// Runs on the main thread with the decoded image, or with ok false once the thumbnail cannot be had
+using ThumbnailCallback = std::function<void(bool ok, DecodedImage image)>;
+
+// Thumbnail loading for the inventory and avatar views. Keys in the disk cache (thumbnail_cache.h) are served from it
+// without touching the network. Other requests made within a short window are grouped by type and
+// size into multi-id metadata calls, thumbnails the API still reports as Pending are polled again together, and images
+// are downloaded and decoded on the shared worker pool. Requests for a key already in flight only add a callback.
+namespace Thumbnails {
+	// Delivered images are shrunk to fit displayEdge x displayEdge pixels (0 keeps the size the API serves). Requests
+	// for the same key that are in flight together get the largest of their edges.
+	void Request(const ThumbnailKey &key, ThumbnailCallback onLoaded, int displayEdge = 0);
+} // namespace Thumbnails
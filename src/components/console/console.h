@@ -2,10 +2,14 @@
 
 #include <mutex>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "log_ring.h"
+
 namespace Console {
-	void Log(const std::string &message);
+	// Appends to the bounded console log; never allocates
+	void Log(Level level, std::string_view message);
 
 	void RenderConsoleTab();
 
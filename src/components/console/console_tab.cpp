@@ -1,33 +1,62 @@
 #include "console.h"
+#include "core/structured_log.h"
 #include <algorithm>
 #include <cctype>
 #include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <deque>
 #include <imgui.h>
-#include <iomanip>
 #include <mutex>
-#include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 using namespace ImGui;
 using namespace std;
 
-static vector<string> g_logMessages;
+// 16k records over 2 MB of text: roughly a few days of refresh cycles, after which the oldest lines fall off
+static constexpr size_t kMaxRecords = 16384;
+static constexpr size_t kArenaChunkSize = 64 * 1024;
+static constexpr size_t kArenaChunks = 32;
+
 static mutex g_logMutex;
-static string g_latestStatusMessage = "Ready.";
-static mutex g_statusMessageMutex;
+static const char *g_emptyStatusMessage = "Ready."; // Status shown while the ring is empty
 static char g_searchBuffer[256] = "";
 
-static string getCurrentTimestamp() {
-	auto now = chrono::system_clock::now();
-	auto in_time_t = chrono::system_clock::to_time_t(now);
+// Function-local so logging from other translation units' static initializers finds it constructed
+static Console::LogRing &logRing() {
+	static Console::LogRing ring(kMaxRecords, kArenaChunkSize, kArenaChunks);
+	return ring;
+}
+
+// Console filter state, owned by the UI thread; records are only read under g_logMutex
+static string g_filterTerm; // Lowercased term g_filterMatches was computed for
+static bool g_filterTimeTerm = false; // Term looks like a clock time, so timestamps are searched too
+static deque<uint64_t> g_filterMatches; // Sequence numbers of matching records, ascending
+static uint64_t g_filterScannedEnd = 0; // Records before this sequence have been checked
+static vector<string> g_visibleLines; // Formatted rows of the current clipper step, reused across frames
+
+// Writes "[HH:MM:SS] " for timestampMs; returns its length
+static size_t formatClock(int64_t timestampMs, char (&buffer)[16]) {
+	time_t seconds = static_cast<time_t>(timestampMs / 1000);
 	std::tm buf {};
+	localtime_s(&buf, &seconds);
+	return strftime(buffer, sizeof(buffer), "[%H:%M:%S] ", &buf);
+}
 
-	localtime_s(&buf, &in_time_t);
+// Appends "[HH:MM:SS] [LEVEL] message" to out
+static void appendFormattedRecord(const Console::LogRecord &record, string &out) {
+	char timestamp[16];
+	out.append(timestamp, formatClock(record.timestampMs, timestamp));
+	out += Console::LevelTag(record.level);
+	out += record.text;
+}
 
-	ostringstream ss;
-	ss << put_time(&buf, "%H:%M:%S");
-	return ss.str();
+static string formatRecord(const Console::LogRecord &record) {
+	string line;
+	appendFormattedRecord(record, line);
+	return line;
 }
 
 static string toLower(string s) {
@@ -35,22 +64,84 @@ static string toLower(string s) {
 	return s;
 }
 
+static bool looksLikeClockTime(string_view term) {
+	return term.find(':') != string_view::npos && all_of(term.begin(), term.end(), [](unsigned char c) {
+			   return isdigit(c) || c == ':';
+		   });
+}
+
+static bool recordMatchesFilter(const Console::LogRecord &record) {
+	if (record.folded.find(g_filterTerm) != string_view::npos) { return true; }
+	if (!g_filterTimeTerm) { return false; }
+	char timestamp[16];
+	return string_view(timestamp, formatClock(record.timestampMs, timestamp)).find(g_filterTerm) != string_view::npos;
+}
+
+// Brings g_filterMatches up to date with term and the ring; caller holds g_logMutex. Only records appended since the
+// last call are checked, and a term that extends the previous one just narrows the existing matches.
+static void updateFilter(string_view term) {
+	const Console::LogRing &ring = logRing();
+	Console::LogRecord record;
+
+	if (term != g_filterTerm) {
+		bool narrow = !g_filterTerm.empty() && term.find(g_filterTerm) != string_view::npos;
+		g_filterTerm.assign(term);
+		g_filterTimeTerm = looksLikeClockTime(term);
+		if (narrow) {
+			g_filterMatches.erase(
+				remove_if(
+					g_filterMatches.begin(),
+					g_filterMatches.end(),
+					[&](uint64_t seq) { return !ring.get(seq, record) || !recordMatchesFilter(record); }
+				),
+				g_filterMatches.end()
+			);
+		} else {
+			g_filterMatches.clear();
+			g_filterScannedEnd = ring.firstSequence();
+		}
+	}
+
+	while (!g_filterMatches.empty() && g_filterMatches.front() < ring.firstSequence()) { g_filterMatches.pop_front(); }
+	g_filterScannedEnd = (max)(g_filterScannedEnd, ring.firstSequence());
+	if (!g_filterTerm.empty()) {
+		for (uint64_t seq = g_filterScannedEnd; seq < ring.endSequence(); ++seq) {
+			if (ring.get(seq, record) && recordMatchesFilter(record)) { g_filterMatches.push_back(seq); }
+		}
+	}
+	g_filterScannedEnd = ring.endSequence();
+}
+
+// Rows shown for the current filter; caller holds g_logMutex
+static size_t filteredRowCount() { return g_filterTerm.empty() ? logRing().size() : g_filterMatches.size(); }
+
+static uint64_t filteredRowSequence(size_t row) {
+	return g_filterTerm.empty() ? logRing().firstSequence() + row : g_filterMatches[row];
+}
+
 namespace Console {
-	void Log(const string &message_content) {
-		string final_log_entry = "[" + getCurrentTimestamp() + "] " + message_content;
+	void Log(Level level, string_view message) {
+		int64_t nowMs = chrono::duration_cast<chrono::milliseconds>(chrono::system_clock::now().time_since_epoch())
+							.count();
 		{
 			lock_guard<mutex> lock(g_logMutex);
-			g_logMessages.push_back(final_log_entry);
+			logRing().append(level, nowMs, message);
 		}
-		{
-			lock_guard<mutex> statusLock(g_statusMessageMutex);
-			g_latestStatusMessage = final_log_entry;
+
+		StructuredLog::Level fileLevel = StructuredLog::Level::Info;
+		if (level == Level::Warn) {
+			fileLevel = StructuredLog::Level::Warn;
+		} else if (level == Level::Error) {
+			fileLevel = StructuredLog::Level::Error;
 		}
+		StructuredLog::Write(fileLevel, "app", message);
 	}
 
 	string GetLatestLogMessageForStatus() {
-		lock_guard<mutex> lock(g_statusMessageMutex);
-		return g_latestStatusMessage;
+		lock_guard<mutex> lock(g_logMutex);
+		LogRecord record;
+		if (!logRing().get(logRing().endSequence() - 1, record)) { return g_emptyStatusMessage; }
+		return formatRecord(record);
 	}
 
 	void RenderConsoleTab() {
@@ -73,20 +164,20 @@ namespace Console {
 		SameLine(0, style.ItemSpacing.x);
 		if (Button("Clear", ImVec2(clearButtonWidth, button_height))) {
 			lock_guard<mutex> lock(g_logMutex);
-			g_logMessages.clear();
+			logRing().clear();
 			g_searchBuffer[0] = '\0';
-			lock_guard<mutex> statusLock(g_statusMessageMutex);
-			g_latestStatusMessage = "Log cleared.";
+			g_emptyStatusMessage = "Log cleared.";
 		}
 		SameLine(0, style.ItemSpacing.x);
 		if (Button("Copy", ImVec2(copyButtonWidth, button_height))) {
 			string logsToCopy;
-			string searchTermLower = toLower(string(g_searchBuffer));
 			lock_guard<mutex> lock(g_logMutex);
-			for (const auto &msg : g_logMessages) {
-				if (searchTermLower.empty() || toLower(msg).find(searchTermLower) != string::npos) {
-					logsToCopy += msg + "\n";
-				}
+			updateFilter(toLower(string(g_searchBuffer)));
+			for (size_t row = 0, rows = filteredRowCount(); row < rows; ++row) {
+				LogRecord record;
+				if (!logRing().get(filteredRowSequence(row), record)) { continue; }
+				appendFormattedRecord(record, logsToCopy);
+				logsToCopy += '\n';
 			}
 			if (!logsToCopy.empty()) { SetClipboardText(logsToCopy.c_str()); }
 		}
@@ -106,46 +197,68 @@ namespace Console {
 					1,
 					ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_NoPadOuterX
 				)) {
-				lock_guard<mutex> lock(g_logMutex);
-				string searchTermLower = toLower(string(g_searchBuffer));
+				size_t rowCount = 0;
+				{
+					lock_guard<mutex> lock(g_logMutex);
+					updateFilter(toLower(string(g_searchBuffer)));
+					rowCount = filteredRowCount();
+				}
+
+				// Follow new messages unless the user has scrolled up
+				bool followTail = GetScrollY() >= GetScrollMaxY() - GetTextLineHeightWithSpacing() * 1.5f;
 
-				for (const auto &msg : g_logMessages) {
-					if (searchTermLower.empty() || toLower(msg).find(searchTermLower) != string::npos) {
+				// Only the rows in view are formatted and submitted, under the lock just long enough to copy them
+				ImGuiListClipper clipper;
+				clipper.Begin(static_cast<int>(rowCount));
+				while (clipper.Step()) {
+					size_t visible = static_cast<size_t>(clipper.DisplayEnd - clipper.DisplayStart);
+					if (g_visibleLines.size() < visible) { g_visibleLines.resize(visible); }
+					{
+						lock_guard<mutex> lock(g_logMutex);
+						for (size_t i = 0; i < visible; ++i) {
+							LogRecord record;
+							g_visibleLines[i].clear();
+							size_t row = static_cast<size_t>(clipper.DisplayStart) + i;
+							if (row < filteredRowCount() && logRing().get(filteredRowSequence(row), record)) {
+								appendFormattedRecord(record, g_visibleLines[i]);
+							}
+						}
+					}
+
+					for (size_t i = 0; i < visible; ++i) {
+						const string &msg = g_visibleLines[i];
 						TableNextRow();
 						TableNextColumn();
 
 						Spacing();
 
 						if (desired_text_indent > 0.0f) { Indent(desired_text_indent); }
-						TextUnformatted(msg.c_str());
+						TextUnformatted(msg.data(), msg.data() + msg.size());
 						if (desired_text_indent > 0.0f) { Unindent(desired_text_indent); }
 
 						Spacing();
 						Separator();
 					}
 				}
+
+				if (followTail) { SetScrollHereY(1.0f); }
 				EndTable();
 			}
 			PopStyleVar(1);
 		}
 
-		bool autoScrollDesired = true;
-		bool userHasScrolled = false;
-		if (GetScrollMaxY() > 0) {
-			if (GetScrollY() < GetScrollMaxY() - (GetTextLineHeightWithSpacing() * 1.5f)) { userHasScrolled = true; }
-		}
-		if (autoScrollDesired && !userHasScrolled) {
-			if (GetScrollY() >= GetScrollMaxY() - style.ItemSpacing.y || GetScrollMaxY() == 0.0f) {
-				SetScrollHereY(1.0f);
-			}
-		}
-
 		EndChild();
 		PopStyleVar(1);
 	}
 
 	std::vector<std::string> GetLogs() {
 		std::lock_guard<std::mutex> lock(g_logMutex);
-		return g_logMessages;
+		std::vector<std::string> logs;
+		logs.reserve(logRing().size());
+		for (uint64_t seq = logRing().firstSequence(); seq < logRing().endSequence(); ++seq) {
+			LogRecord record;
+			if (logRing().get(seq, record)) { logs.push_back(formatRecord(record)); }
+		}
+		return logs;
 	}
 } // namespace Console
@@ -0,0 +1,82 @@
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+#include "log_ring.h"
+
+namespace Console {
+	const char *LevelTag(Level level) {
+		switch (level) {
+			case Level::Info:
+				return "[INFO] ";
+			case Level::Warn:
+				return "[WARN] ";
+			case Level::Error:
+				return "[ERROR] ";
+			default:
+				return "";
+		}
+	}
+
+	// Longest LevelTag, reserved in every chunk so a maximal message plus its folded copy always fits
+	static constexpr size_t kMaxTagLength = 8;
+
+	LogRing::LogRing(size_t recordCapacity, size_t chunkSize, size_t chunkCount)
+		: m_chunkSize((std::max)(chunkSize, kMaxTagLength + 2)), m_chunkCount((std::max)(chunkCount, size_t {2})) {
+		m_slots.resize((std::max)(recordCapacity, size_t {1}));
+		m_arena.resize(m_chunkSize * m_chunkCount);
+	}
+
+	uint64_t LogRing::append(Level level, int64_t timestampMs, std::string_view text) {
+		const char *tag = LevelTag(level);
+		size_t tagLength = std::strlen(tag);
+		size_t length = (std::min)(text.size(), (m_chunkSize - kMaxTagLength) / 2);
+		size_t needed = length + tagLength + length;
+
+		if (m_chunkUsed + needed > m_chunkSize) {
+			// Records are written in chunk order, so everything still in the chunk being reused is at the head
+			m_chunk = static_cast<uint32_t>((m_chunk + 1) % m_chunkCount);
+			m_chunkUsed = 0;
+			while (m_first != m_end && slot(m_first).chunk == m_chunk) { ++m_first; }
+		}
+		if (m_end - m_first == m_slots.size()) { ++m_first; }
+
+		// Raw text followed by the lowercased tag + text that the console filter searches
+		char *out = m_arena.data() + m_chunk * m_chunkSize + m_chunkUsed;
+		std::memcpy(out, text.data(), length);
+		char *folded = out + length;
+		for (size_t i = 0; i < tagLength; ++i) {
+			folded[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(tag[i])));
+		}
+		for (size_t i = 0; i < length; ++i) {
+			folded[tagLength + i] = static_cast<char>(std::tolower(static_cast<unsigned char>(text[i])));
+		}
+		Slot &s = m_slots[m_end % m_slots.size()];
+		s.timestampMs = timestampMs;
+		s.chunk = m_chunk;
+		s.offset = static_cast<uint32_t>(m_chunkUsed);
+		s.length = static_cast<uint32_t>(length);
+		s.foldedLength = static_cast<uint32_t>(tagLength + length);
+		s.level = level;
+		m_chunkUsed += needed;
+		return m_end++;
+	}
+
+	bool LogRing::get(uint64_t sequence, LogRecord &out) const {
+		if (sequence < m_first || sequence >= m_end) { return false; }
+		const Slot &s = slot(sequence);
+		out.timestampMs = s.timestampMs;
+		out.sequence = sequence;
+		out.level = s.level;
+		const char *base = m_arena.data() + s.chunk * m_chunkSize + s.offset;
+		out.text = std::string_view(base, s.length);
+		out.folded = std::string_view(base + s.length, s.foldedLength);
+		return true;
+	}
+
+	void LogRing::clear() {
+		m_first = m_end;
+		m_chunk = 0;
+		m_chunkUsed = 0;
+	}
+} // namespace Console
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace Console {
+	enum class Level : uint8_t {
+		None, // Plain message without a level tag
+		Info,
+		Warn,
+		Error,
+	};
+
+	const char *LevelTag(Level level);
+
+	// A record as stored in the ring; text points into the ring's arena and is only valid until the next append
+	struct LogRecord {
+			int64_t timestampMs = 0; // UTC epoch milliseconds
+			uint64_t sequence = 0;
+			Level level = Level::None;
+			std::string_view text;
+			std::string_view folded; // Lowercased level tag + text, for case-insensitive filtering
+	};
+
+	// Fixed-capacity log storage. Record slots and message bytes are allocated once up front; when either runs out the
+	// oldest records are dropped, so memory stays bounded however long the app runs and appending never allocates.
+	// Messages live in a ring of fixed-size chunks: moving into a chunk evicts every record that still points at it.
+	// Each message is stored twice, as written and lowercased with its level tag, so filtering never re-folds text.
+	// Not synchronized; callers lock around it.
+	class LogRing {
+		public:
+			LogRing(size_t recordCapacity, size_t chunkSize, size_t chunkCount);
+
+			// Stores a copy of text (truncated to just under half a chunk) and returns its sequence number
+			uint64_t append(Level level, int64_t timestampMs, std::string_view text);
+
+			// Sequence numbers of live records are [firstSequence(), endSequence())
+			uint64_t firstSequence() const { return m_first; }
+
+			uint64_t endSequence() const { return m_end; }
+
+			size_t size() const { return static_cast<size_t>(m_end - m_first); }
+
+			bool empty() const { return m_end == m_first; }
+
+			// Returns false if sequence has been evicted or not written yet
+			bool get(uint64_t sequence, LogRecord &out) const;
+
+			// Drops every record; sequence numbers keep increasing
+			void clear();
+
+		private:
+			struct Slot {
+					int64_t timestampMs = 0;
+					uint32_t chunk = 0;
+					uint32_t offset = 0;
+					uint32_t length = 0;
+					uint32_t foldedLength = 0;
+					Level level = Level::None;
+			};
+
+			const Slot &slot(uint64_t sequence) const { return m_slots[sequence % m_slots.size()]; }
+
+			std::vector<Slot> m_slots;
+			std::vector<char> m_arena; // m_chunkCount chunks of m_chunkSize bytes
+			size_t m_chunkSize;
+			size_t m_chunkCount;
+			uint32_t m_chunk = 0; // Chunk currently being filled
+			size_t m_chunkUsed = 0;
+			uint64_t m_first = 0;
+			uint64_t m_end = 0;
+	};
+} // namespace Console
@@ -12,6 +12,7 @@ struct StandardJoinMenuParams {
 		bool enableLaunchInstance = true; // only applies if jobId not empty
 		std::function<void()> onLaunchGame; // optional
 		std::function<void()> onLaunchInstance; // optional
+		std::function<void()> onLaunchBestServer; // optional; the item is only shown when set
 		std::function<void()> onFillGame; // optional
 		std::function<void()> onFillInstance; // optional
 };
@@ -108,6 +109,12 @@ inline void RenderStandardJoinMenu(const StandardJoinMenuParams &p) {
 	if (ImGui::MenuItem("Game##Launch", nullptr, false, p.enableLaunchGame && hasGame)) {
 		if (p.onLaunchGame) { p.onLaunchGame(); }
 	}
+	if (p.onLaunchBestServer && ImGui::MenuItem("Best Server##Launch", nullptr, false, hasGame)) {
+		p.onLaunchBestServer();
+	}
+	if (p.onLaunchBestServer && ImGui::IsItemHovered()) {
+		ImGui::SetTooltip("Lowest-ping server with room for every selected account");
+	}
 	ImGui::PopStyleColor();
 	if (hasInstanceContext) {
 		ImGui::PushStyleColor(ImGuiCol_Text, kLaunchColor);
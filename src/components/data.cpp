@@ -56,6 +56,9 @@ int g_statusRefreshInterval = 1;
 bool g_checkUpdatesOnStartup = true;
 bool g_killRobloxOnLaunch = false;
 bool g_clearCacheOnLaunch = false;
+bool g_binaryLogFiles = false;
+bool g_gameSearchTypeAhead = false;
+int g_thumbnailMemoryBudgetMb = 128;
 
 vector<BYTE> encryptData(const string &plainText) {
 	DATA_BLOB DataIn;
@@ -342,6 +345,11 @@ namespace Data {
 			g_killRobloxOnLaunch = j.value("killRobloxOnLaunch", false);
 			g_clearCacheOnLaunch = j.value("clearCacheOnLaunch", false);
 			g_multiRobloxEnabled = j.value("multiRobloxEnabled", false);
+			g_binaryLogFiles = j.value("binaryLogFiles", false);
+			g_gameSearchTypeAhead = j.value("gameSearchTypeAhead", false);
+			g_thumbnailMemoryBudgetMb = j.value("thumbnailMemoryBudgetMb", 128);
+			// Same floor as the settings control; a hand-edited negative value would wrap when cast to size_t
+			if (g_thumbnailMemoryBudgetMb < 16) { g_thumbnailMemoryBudgetMb = 16; }
 			LOG_INFO("Default account ID = " + std::to_string(g_defaultAccountId));
 			LOG_INFO("Status refresh interval = " + std::to_string(g_statusRefreshInterval));
 			LOG_INFO("Check updates on startup = " + std::string(g_checkUpdatesOnStartup ? "true" : "false"));
@@ -358,6 +366,9 @@ namespace Data {
 		j["killRobloxOnLaunch"] = g_killRobloxOnLaunch;
 		j["clearCacheOnLaunch"] = g_clearCacheOnLaunch;
 		j["multiRobloxEnabled"] = g_multiRobloxEnabled;
+		j["binaryLogFiles"] = g_binaryLogFiles;
+		j["gameSearchTypeAhead"] = g_gameSearchTypeAhead;
+		j["thumbnailMemoryBudgetMb"] = g_thumbnailMemoryBudgetMb;
 		std::string path = MakePath(filename);
 		std::ofstream out {path};
 		if (!out.is_open()) {
@@ -371,6 +382,9 @@ namespace Data {
 		LOG_INFO("Saved killRobloxOnLaunch=" + std::string(g_killRobloxOnLaunch ? "true" : "false"));
 		LOG_INFO("Saved clearCacheOnLaunch=" + std::string(g_clearCacheOnLaunch ? "true" : "false"));
 		LOG_INFO("Saved multiRobloxEnabled=" + std::string(g_multiRobloxEnabled ? "true" : "false"));
+		LOG_INFO("Saved binaryLogFiles=" + std::string(g_binaryLogFiles ? "true" : "false"));
+		LOG_INFO("Saved gameSearchTypeAhead=" + std::string(g_gameSearchTypeAhead ? "true" : "false"));
+		LOG_INFO("Saved thumbnailMemoryBudgetMb=" + std::to_string(g_thumbnailMemoryBudgetMb));
 	}
 
 	void LoadFriends(const std::string &filename) {
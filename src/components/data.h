@@ -64,6 +64,9 @@ extern int g_statusRefreshInterval;
 extern bool g_checkUpdatesOnStartup;
 extern bool g_killRobloxOnLaunch;
 extern bool g_clearCacheOnLaunch;
+extern bool g_binaryLogFiles;
+extern bool g_gameSearchTypeAhead;
+extern int g_thumbnailMemoryBudgetMb;
 extern std::array<char, 128> s_jobIdBuffer;
 extern std::array<char, 128> s_playerBuffer;
 
@@ -4,17 +4,24 @@
 #include "network/roblox/hba.h"
 #include <algorithm>
 #include <atomic>
+#include <future>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+using std::async;
 using std::atomic;
-using std::find_if;
+using std::future;
 using std::move;
 using std::string;
+using std::unordered_map;
 using std::unordered_set;
 using std::vector;
 
+// Most user IDs the presence endpoint accepts per request
+static constexpr size_t kBatchSize = 100;
+
 static int presencePriority(const string &p) {
 	if (p == "InGame") { return 0; }
 	if (p == "InStudio") { return 1; }
@@ -23,6 +30,64 @@ static int presencePriority(const string &p) {
 }
 
 namespace FriendsActions {
+	bool SortsBefore(const FriendInfo &a, const FriendInfo &b) {
+		int pa = presencePriority(a.presence);
+		int pb = presencePriority(b.presence);
+		if (pa != pb) { return pa < pb; }
+
+		// If both are “InGame”, push friends whose joins are *off*
+		//      (lastLocation empty) *below* those whose joins are on.
+		if (pa == 0) {
+			// both “InGame”
+			bool aJoinOff = a.lastLocation.empty();
+			bool bJoinOff = b.lastLocation.empty();
+			if (aJoinOff != bJoinOff) {
+				return !aJoinOff; // joins‑ON first
+			}
+		}
+
+		// ── fallback: alphabetical display name / username, then id ────────────
+		const string &nameA_ref
+			= (a.displayName.empty() || a.displayName == a.username) ? a.username : a.displayName;
+		const string &nameB_ref
+			= (b.displayName.empty() || b.displayName == b.username) ? b.username : b.displayName;
+
+		if (nameA_ref.empty() && !nameB_ref.empty()) { return false; }
+		if (!nameA_ref.empty() && nameB_ref.empty()) { return true; }
+		if (nameA_ref.empty() && nameB_ref.empty()) { return a.id < b.id; }
+
+		return nameA_ref < nameB_ref;
+	}
+
+	void ApplyPresenceChanges(vector<FriendInfo> &friends, const vector<PresenceWatcher::Change> &changes) {
+		unordered_map<uint64_t, const Roblox::PresenceData *> changed;
+		changed.reserve(changes.size());
+		for (const auto &change : changes) { changed[change.userId] = &change.presence; }
+
+		// Changed rows are taken out, which leaves the rest in order, and put back where they now belong
+		vector<FriendInfo> moved;
+		size_t kept = 0;
+		for (size_t i = 0; i < friends.size(); ++i) {
+			auto it = changed.find(friends[i].id);
+			if (it == changed.end()) {
+				if (kept != i) { friends[kept] = move(friends[i]); }
+				++kept;
+				continue;
+			}
+			FriendInfo &f = friends[i];
+			f.presence = it->second->presence;
+			f.lastLocation = it->second->lastLocation;
+			f.placeId = it->second->placeId;
+			f.jobId = it->second->jobId;
+			moved.push_back(move(f));
+		}
+		friends.erase(friends.begin() + kept, friends.end());
+		for (auto &f : moved) {
+			auto at = std::upper_bound(friends.begin(), friends.end(), f, SortsBefore);
+			friends.insert(at, move(f));
+		}
+	}
+
 	void RefreshFullFriendsList(
 		int accountId,
 		const string &userId,
@@ -33,63 +98,50 @@ namespace FriendsActions {
 		loadingFlag = true;
 		LOG_INFO("Fetching friends list...");
 
-		auto list = Roblox::getFriends(userId, creds.toAuthConfig());
+		const Roblox::HBA::AuthConfig config = creds.toAuthConfig();
+		auto list = Roblox::getFriendList(userId, config);
 
+		// Position of each friend in list, for merging batch results without a scan per user
+		unordered_map<uint64_t, size_t> indexById;
+		indexById.reserve(list.size());
 		vector<uint64_t> ids;
 		ids.reserve(list.size());
-		for (const auto &f : list) { ids.push_back(f.id); }
-
-		for (auto &f : list) { f.presence = "Offline"; }
+		for (size_t i = 0; i < list.size(); ++i) {
+			list[i].presence = "Offline";
+			if (list[i].id != 0 && indexById.emplace(list[i].id, i).second) { ids.push_back(list[i].id); }
+		}
 
-		LOG_INFO("Fetching friend presences...");
+		LOG_INFO("Fetching friend names and presences...");
 
-		for (size_t i = 0; i < ids.size(); i += 100) {
-			size_t batchEnd = (std::min)(ids.size(), i + 100);
-			vector<uint64_t> batch_ids(ids.begin() + i, ids.begin() + batchEnd);
+		// Names come from the shared user directory, which fetches the ones it lacks in parallel 100-ID batches. Every
+		// presence batch is requested at once too, so the refresh takes about as long as the slowest request.
+		auto names = async(std::launch::async, [&ids]() { return Roblox::getUserProfiles(ids); });
+		vector<future<unordered_map<uint64_t, Roblox::PresenceData>>> presenceBatches;
+		for (size_t i = 0; i < ids.size(); i += kBatchSize) {
+			size_t batchEnd = (std::min)(ids.size(), i + kBatchSize);
+			vector<uint64_t> batchIds(ids.begin() + i, ids.begin() + batchEnd);
 
-			if (batch_ids.empty()) { continue; }
+			presenceBatches.push_back(
+				async(std::launch::async, [batchIds, config]() { return Roblox::getPresences(batchIds, config); })
+			);
+		}
 
-			auto presMap = Roblox::getPresences(batch_ids, creds.toAuthConfig());
+		Roblox::applyUserProfiles(list, names.get());
 
-			for (const auto &[uid, pdata] : presMap) {
-				auto it = find_if(list.begin(), list.end(), [&](const FriendInfo &f) { return f.id == uid; });
-				if (it == list.end()) { continue; }
+		for (auto &batch : presenceBatches) {
+			for (auto &[uid, pdata] : batch.get()) {
+				auto it = indexById.find(uid);
+				if (it == indexById.end()) { continue; }
 
-				it->presence = pdata.presence;
-				it->lastLocation = pdata.lastLocation;
-				it->placeId = pdata.placeId;
-				it->jobId = pdata.jobId;
+				FriendInfo &f = list[it->second];
+				f.presence = move(pdata.presence);
+				f.lastLocation = move(pdata.lastLocation);
+				f.placeId = pdata.placeId;
+				f.jobId = move(pdata.jobId);
 			}
 		}
 
-		sort(list.begin(), list.end(), [](const FriendInfo &a, const FriendInfo &b) {
-			int pa = presencePriority(a.presence);
-			int pb = presencePriority(b.presence);
-			if (pa != pb) { return pa < pb; }
-
-			// If both are “InGame”, push friends whose joins are *off*
-			//      (lastLocation empty) *below* those whose joins are on.
-			if (pa == 0) {
-				// both “InGame”
-				bool aJoinOff = a.lastLocation.empty();
-				bool bJoinOff = b.lastLocation.empty();
-				if (aJoinOff != bJoinOff) {
-					return !aJoinOff; // joins‑ON first
-				}
-			}
-
-			// ── fallback: alphabetical display name / username, then id ────────────
-			const string &nameA_ref
-				= (a.displayName.empty() || a.displayName == a.username) ? a.username : a.displayName;
-			const string &nameB_ref
-				= (b.displayName.empty() || b.displayName == b.username) ? b.username : b.displayName;
-
-			if (nameA_ref.empty() && !nameB_ref.empty()) { return false; }
-			if (!nameA_ref.empty() && nameB_ref.empty()) { return true; }
-			if (nameA_ref.empty() && nameB_ref.empty()) { return a.id < b.id; }
-
-			return nameA_ref < nameB_ref;
-		});
+		sort(list.begin(), list.end(), SortsBefore);
 
 		outFriendsList = move(list);
 
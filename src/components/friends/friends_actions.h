@@ -7,8 +7,15 @@
 #include "../data.h"
 #include "network/roblox.h"
 #include "network/roblox/hba.h"
+#include "presence_watcher.h"
 
 namespace FriendsActions {
+	// Order of the friends list: in game (joinable first), in Studio, online, offline, then by name
+	bool SortsBefore(const FriendInfo &a, const FriendInfo &b);
+
+	// Updates the friends the changes are about and moves only those rows, keeping a list sorted by SortsBefore sorted
+	void ApplyPresenceChanges(std::vector<FriendInfo> &friends, const std::vector<PresenceWatcher::Change> &changes);
+
 	void RefreshFullFriendsList(
 		int accountId,
 		const std::string &userId,
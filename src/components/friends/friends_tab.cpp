@@ -6,6 +6,7 @@
 #include <iterator>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -15,8 +16,10 @@
 #include "../data.h"
 #include "../games/games_utils.h"
 #include "./friends_actions.h"
+#include "./presence_watcher.h"
 #include "core/time_utils.h"
 #include "network/roblox.h"
+#include "network/roblox/user_directory.h"
 #include "system/launcher.hpp"
 #include "system/threading.h"
 #include "ui/confirm.h"
@@ -36,6 +39,7 @@ static atomic<bool> g_friendsLoading {false};
 static vector<FriendInfo> g_unfriended;
 
 static int g_lastAcctIdForFriends = -1;
+static bool g_friendsWereLoading = false;
 
 // Account whose friends list is currently being viewed. Defaults to the first
 // selected account but can be changed via the UI combo box.
@@ -135,6 +139,35 @@ static const char *presenceIcon(const string &p) {
 	return "";
 }
 
+// Presence of the listed friends is kept current by the watcher between full refreshes; it starts from the list the
+// refresh just loaded
+static void watchFriendsPresence(const AccountData &acct) {
+	unordered_map<uint64_t, Roblox::PresenceData> known;
+	known.reserve(g_friends.size());
+	for (const auto &f : g_friends) { known[f.id] = {f.presence, f.lastLocation, f.placeId, f.jobId}; }
+
+	int acctId = acct.id;
+	PresenceWatcher::Watch(
+		"friends",
+		move(known),
+		AccountUtils::credentialsFromAccount(acct).toAuthConfig(),
+		[acctId](const vector<PresenceWatcher::Change> &changes) {
+			if (acctId != g_lastAcctIdForFriends || g_friendsLoading.load()) { return; }
+			uint64_t selectedId = 0;
+			if (g_selectedFriendIdx >= 0 && g_selectedFriendIdx < static_cast<int>(g_friends.size())) {
+				selectedId = g_friends[g_selectedFriendIdx].id;
+			}
+			FriendsActions::ApplyPresenceChanges(g_friends, changes);
+			if (selectedId != 0) {
+				auto sel = find_if(g_friends.begin(), g_friends.end(), [&](const FriendInfo &f) {
+					return f.id == selectedId;
+				});
+				g_selectedFriendIdx = sel == g_friends.end() ? -1 : static_cast<int>(sel - g_friends.begin());
+			}
+		}
+	);
+}
+
 void RenderFriendsTab() {
 	if (g_selectedAccountIds.empty()) {
 		TextDisabled("Select an account in the Accounts tab to view its friends.");
@@ -176,6 +209,7 @@ void RenderFriendsTab() {
 	g_unfriended = g_unfriendedFriends[currentAcctId];
 
 	if (currentAcctId != g_lastAcctIdForFriends) {
+		PresenceWatcher::Unwatch("friends");
 		g_friends.clear();
 		g_selectedFriendIdx = -1;
 		g_selectedFriend = {};
@@ -206,6 +240,11 @@ void RenderFriendsTab() {
 			if (g_friendsViewMode == 1) { LoadIncomingRequests(creds, true); }
 		}
 	}
+
+	bool friendsLoading = g_friendsLoading.load();
+	if (g_friendsWereLoading && !friendsLoading) { watchFriendsPresence(acct); }
+	g_friendsWereLoading = friendsLoading;
+
 	{
 		float maxLabelWidth = 0.0f;
 		for (const auto &acc : g_accounts) {
@@ -359,8 +398,22 @@ void RenderFriendsTab() {
 			Threading::newThread([specs, creds]() {
 				try {
 					int sent = 0;
+					// Every username is resolved up front, in as few requests as the user directory can manage
+					vector<string> usernames;
+					for (const auto &sp : specs) {
+						if (!sp.isId) { usernames.push_back(sp.username); }
+					}
+					auto resolved = UserDirectory::LookupUsernames(usernames);
 					for (const auto &sp : specs) {
-						uint64_t uid = sp.isId ? sp.id : Roblox::getUserIdFromUsername(sp.username);
+						uint64_t uid = sp.id;
+						if (!sp.isId) {
+							auto found = resolved.find(sp.username);
+							if (found == resolved.end()) {
+								LOG_INFO("Username not found: " + sp.username);
+								continue;
+							}
+							uid = found->second.id;
+						}
 						string resp;
 						bool ok = Roblox::sendFriendRequest(to_string(uid), creds.toAuthConfig(), &resp);
 						if (ok) {
@@ -0,0 +1,255 @@
+#include "presence_watcher.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <map>
+#include <mutex>
+#include <unordered_set>
+#include <utility>
+
+#include "core/logging.hpp"
+#include "system/main_thread.h"
+#include "system/threading.h"
+
+using Clock = std::chrono::steady_clock;
+using PresenceMap = std::unordered_map<uint64_t, Roblox::PresenceData>;
+
+// Each cookie's time between cycles starts at kStartInterval, halves after a cycle that found changes down to
+// kMinInterval, and grows by half after a quiet one, or doubles after a failed request, up to kMaxInterval
+static constexpr Clock::duration kMinInterval = std::chrono::seconds(10);
+static constexpr Clock::duration kStartInterval = std::chrono::seconds(15);
+static constexpr Clock::duration kMaxInterval = std::chrono::seconds(60);
+// Sets asked with a cookie that fails this many cycles in a row are dropped
+static constexpr int kMaxFailedCycles = 5;
+// Most user IDs the presence endpoint accepts per request
+static constexpr size_t kBatchSize = 100;
+
+namespace {
+	struct WatchedSet {
+			Roblox::HBA::AuthConfig auth;
+			PresenceWatcher::ChangeCallback onChanged;
+			PresenceMap known;
+			uint64_t generation = 0; // Tells deliveries for a replaced set apart from ones for its successor
+	};
+
+	// Polling schedule of the users asked for with one cookie
+	struct CookieSchedule {
+			Clock::duration interval = kStartInterval;
+			Clock::time_point nextPoll;
+			int failedCycles = 0; // In a row
+	};
+
+	struct Batch {
+			std::vector<uint64_t> userIds;
+			Roblox::HBA::AuthConfig auth;
+	};
+} // namespace
+
+static std::mutex g_mutex;
+static std::condition_variable g_wake;
+static std::map<std::string, WatchedSet> g_sets;
+static std::unordered_map<std::string, CookieSchedule> g_schedules; // By cookie, for every cookie a set uses
+static uint64_t g_nextGeneration = 1;
+static bool g_pollerRunning = false;
+
+static bool samePresence(const Roblox::PresenceData &a, const Roblox::PresenceData &b) {
+	return a.presence == b.presence && a.placeId == b.placeId && a.jobId == b.jobId;
+}
+
+// Caller holds g_mutex; forgets the schedules of cookies no set uses any more
+static void pruneSchedulesLocked() {
+	std::erase_if(g_schedules, [](const auto &entry) {
+		return std::none_of(g_sets.begin(), g_sets.end(), [&](const auto &set) {
+			return set.second.auth.cookie == entry.first;
+		});
+	});
+}
+
+// Caller holds g_mutex; every watched user once, with the cookie of the first set watching them whose cookie is not
+// failing. Only users whose cookie is due by now are batched; owners maps each of them to that cookie.
+static std::vector<Batch> planBatchesLocked(Clock::time_point now, std::unordered_map<uint64_t, std::string> &owners) {
+	std::unordered_map<uint64_t, const WatchedSet *> ownerSets;
+	for (const auto &[name, set] : g_sets) {
+		bool failing = g_schedules[set.auth.cookie].failedCycles > 0;
+		for (const auto &[userId, state] : set.known) {
+			auto [it, inserted] = ownerSets.try_emplace(userId, &set);
+			if (!inserted && !failing && g_schedules[it->second->auth.cookie].failedCycles > 0) { it->second = &set; }
+		}
+	}
+
+	std::vector<Batch> batches;
+	std::unordered_map<std::string, size_t> filling; // Cookie -> batch being filled for it
+	for (const auto &[userId, set] : ownerSets) {
+		if (g_schedules[set->auth.cookie].nextPoll > now) { continue; }
+		owners[userId] = set->auth.cookie;
+		auto [it, inserted] = filling.try_emplace(set->auth.cookie, batches.size());
+		if (inserted || batches[it->second].userIds.size() >= kBatchSize) {
+			it->second = batches.size();
+			batches.push_back({{}, set->auth});
+		}
+		batches[it->second].userIds.push_back(userId);
+	}
+	return batches;
+}
+
+static void deliver(const std::string &name, uint64_t generation, std::vector<PresenceWatcher::Change> changes) {
+	MainThread::Post([name, generation, changes = std::move(changes)]() {
+		PresenceWatcher::ChangeCallback onChanged;
+		{
+			std::lock_guard<std::mutex> lock(g_mutex);
+			auto it = g_sets.find(name);
+			if (it == g_sets.end() || it->second.generation != generation) { return; }
+			onChanged = it->second.onChanged;
+		}
+		if (onChanged) { onChanged(changes); }
+	});
+}
+
+// Caller holds g_mutex; moves each cookie that was due to its next cycle. A due cookie without batches had all its
+// users asked for with other cookies, and keeps its interval.
+static void rescheduleLocked(
+	const std::vector<std::string> &due,
+	const std::vector<Batch> &batches,
+	const std::unordered_set<std::string> &failed,
+	const std::unordered_set<std::string> &changed
+) {
+	Clock::time_point now = Clock::now();
+	for (const auto &cookie : due) {
+		auto found = g_schedules.find(cookie);
+		if (found == g_schedules.end()) { continue; }
+		CookieSchedule &schedule = found->second;
+		auto polled = [&](const Batch &batch) { return batch.auth.cookie == cookie; };
+		if (std::none_of(batches.begin(), batches.end(), polled)) {
+			schedule.nextPoll = now + schedule.interval;
+			continue;
+		}
+		if (failed.count(cookie)) {
+			schedule.interval = (std::min)(kMaxInterval, schedule.interval * 2);
+			++schedule.failedCycles;
+		} else if (changed.count(cookie)) {
+			schedule.interval = (std::max)(kMinInterval, schedule.interval / 2);
+			schedule.failedCycles = 0;
+		} else {
+			schedule.interval = (std::min)(kMaxInterval, schedule.interval * 3 / 2);
+			schedule.failedCycles = 0;
+		}
+		schedule.nextPoll = now + schedule.interval;
+		if (schedule.failedCycles < kMaxFailedCycles) { continue; }
+
+		// Most likely an expired cookie; its sets come back when their owners watch them again after a refresh
+		for (auto it = g_sets.begin(); it != g_sets.end();) {
+			if (it->second.auth.cookie == cookie) {
+				LOG_WARN("Presence requests for '" + it->first + "' keep failing; no longer watching it");
+				it = g_sets.erase(it);
+			} else {
+				++it;
+			}
+		}
+	}
+	pruneSchedulesLocked();
+}
+
+static void runPoller() {
+	std::unique_lock<std::mutex> lock(g_mutex);
+	for (;;) {
+		for (;;) {
+			pruneSchedulesLocked();
+			if (g_sets.empty()) {
+				g_pollerRunning = false;
+				return;
+			}
+			Clock::time_point next = Clock::time_point::max();
+			for (const auto &[cookie, schedule] : g_schedules) { next = (std::min)(next, schedule.nextPoll); }
+			if (Clock::now() >= next) { break; }
+			g_wake.wait_until(lock, next);
+		}
+		Clock::time_point now = Clock::now();
+		std::vector<std::string> due;
+		for (const auto &[cookie, schedule] : g_schedules) {
+			if (schedule.nextPoll <= now) { due.push_back(cookie); }
+		}
+		std::unordered_map<uint64_t, std::string> owners;
+		std::vector<Batch> batches = planBatchesLocked(now, owners);
+		lock.unlock();
+
+		// Every due request is sent at once
+		std::vector<std::future<PresenceMap>> requests;
+		requests.reserve(batches.size());
+		for (const auto &batch : batches) {
+			requests.push_back(std::async(std::launch::async, [&batch]() -> PresenceMap {
+				// Console only: a dead cookie fails every cycle, and rescheduleLocked warns once when it gives up
+				try {
+					std::string error;
+					PresenceMap result = Roblox::getPresences(batch.userIds, batch.auth, &error);
+					if (!error.empty()) { LOG_INFO(error); }
+					return result;
+				} catch (const std::exception &e) {
+					LOG_INFO(std::string("Presence poll failed: ") + e.what());
+					return {};
+				}
+			}));
+		}
+		PresenceMap polled;
+		std::unordered_set<std::string> failed; // Cookies with a failed request this cycle
+		for (size_t i = 0; i < requests.size(); ++i) {
+			PresenceMap result = requests[i].get();
+			// A failed call returns nothing, and its users keep their last known state
+			if (result.empty()) { failed.insert(batches[i].auth.cookie); }
+			polled.merge(result);
+		}
+
+		lock.lock();
+		std::unordered_set<std::string> changed; // Cookies whose users changed
+		for (auto &[name, set] : g_sets) {
+			std::vector<PresenceWatcher::Change> changes;
+			for (auto &[userId, state] : set.known) {
+				auto it = polled.find(userId);
+				if (it == polled.end() || samePresence(state, it->second)) { continue; }
+				state = it->second;
+				changes.push_back({userId, it->second});
+				changed.insert(owners[userId]);
+			}
+			if (!changes.empty()) { deliver(name, set.generation, std::move(changes)); }
+		}
+		rescheduleLocked(due, batches, failed, changed);
+	}
+}
+
+namespace PresenceWatcher {
+	void Watch(
+		const std::string &name,
+		std::unordered_map<uint64_t, Roblox::PresenceData> known,
+		const Roblox::HBA::AuthConfig &auth,
+		ChangeCallback onChanged
+	) {
+		std::lock_guard<std::mutex> lock(g_mutex);
+		if (known.empty()) {
+			g_sets.erase(name);
+			g_wake.notify_all();
+			return;
+		}
+		g_sets[name] = {auth, std::move(onChanged), std::move(known), g_nextGeneration++};
+
+		// The caller has just fetched what it shows with this cookie, so its schedule starts over and the set's first
+		// poll is a normal cycle away
+		Clock::time_point firstPoll = Clock::now() + kStartInterval;
+		auto [it, inserted] = g_schedules.try_emplace(auth.cookie);
+		it->second.interval = kStartInterval;
+		it->second.failedCycles = 0;
+		it->second.nextPoll = inserted ? firstPoll : (std::min)(it->second.nextPoll, firstPoll);
+		if (!g_pollerRunning) {
+			g_pollerRunning = true;
+			Threading::newThread(runPoller);
+		} else {
+			g_wake.notify_all();
+		}
+	}
+
+	void Unwatch(const std::string &name) {
+		std::lock_guard<std::mutex> lock(g_mutex);
+		g_sets.erase(name);
+		g_wake.notify_all();
+	}
+} // namespace PresenceWatcher
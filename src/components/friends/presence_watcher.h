@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "network/roblox.h"
+#include "network/roblox/hba.h"
+
+// Keeps the presence of watched users current between full refreshes. Users are asked for in 100-user presence calls,
+// once even when several sets watch them, and each set is told only about its users whose presence, place or server
+// changed since the state it last saw. Every cookie the sets use runs its own cycles, which come quicker while its
+// users are changing and slow down while nothing is, or while its requests fail. Sets whose cookie keeps failing are
+// dropped until they are watched again.
+namespace PresenceWatcher {
+	struct Change {
+			uint64_t userId = 0;
+			Roblox::PresenceData presence;
+	};
+
+	// Runs on the main thread
+	using ChangeCallback = std::function<void(const std::vector<Change> &changes)>;
+
+	// Starts watching the set called name, replacing any set of that name. known holds the state the caller shows now
+	// for each watched user, and changes are reported against it. Presence is requested with auth.
+	void Watch(
+		const std::string &name,
+		std::unordered_map<uint64_t, Roblox::PresenceData> known,
+		const Roblox::HBA::AuthConfig &auth,
+		ChangeCallback onChanged
+	);
+
+	// Changes the set had found but not yet delivered are dropped
+	void Unwatch(const std::string &name);
+} // namespace PresenceWatcher
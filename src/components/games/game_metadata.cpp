@@ -0,0 +1,311 @@
+#include "game_metadata.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "../data.h"
+#include "core/logging.hpp"
+#include "system/threading.h"
+
+using nlohmann::json;
+
+static constexpr const char *kCacheFile = "game_cache.json";
+static constexpr int64_t kDetailTtlMs = 10LL * 60 * 1000;
+// Universes the endpoint did not return (or a failed batch) are retried sooner than a normal refresh
+static constexpr int64_t kMissingRetryMs = 60LL * 1000;
+// Older details are dropped when the disk cache is loaded; they would only show badly outdated counts
+static constexpr int64_t kDiskMaxAgeMs = 7LL * 24 * 60 * 60 * 1000;
+static constexpr size_t kDiskMaxDetails = 2000;
+// How long the worker waits for more requests before sending a batch
+static constexpr std::chrono::milliseconds kBatchWindow {30};
+
+namespace {
+	struct DetailEntry {
+			Roblox::GameDetail detail;
+			int64_t fetchedAtMs = 0;
+			bool found = false; // False for universes the endpoint did not return
+	};
+
+	struct PlaceEntry {
+			uint64_t universeId = 0; // 0 when the lookup failed
+			int64_t resolvedAtMs = 0;
+	};
+} // namespace
+
+static std::mutex g_mutex;
+static std::unordered_map<uint64_t, DetailEntry> g_details;
+static std::unordered_map<uint64_t, PlaceEntry> g_places;
+static std::unordered_set<uint64_t> g_pendingUniverses;
+static std::unordered_set<uint64_t> g_pendingPlaces;
+static std::unordered_set<uint64_t> g_inFlightUniverses;
+static std::unordered_set<uint64_t> g_inFlightPlaces;
+static bool g_loaded = false;
+static bool g_workerRunning = false;
+static uint64_t g_generation = 0;
+
+static int64_t nowMs() {
+	using namespace std::chrono;
+	return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+static json detailToJson(uint64_t universeId, const DetailEntry &entry) {
+	const Roblox::GameDetail &d = entry.detail;
+	return {
+		{"universeId", universeId},
+		{"fetchedAt", entry.fetchedAtMs},
+		{"name", d.name},
+		{"genre", d.genre},
+		{"genreL1", d.genreL1},
+		{"genreL2", d.genreL2},
+		{"description", d.description},
+		{"visits", d.visits},
+		{"favorites", d.favorites},
+		{"playing", d.playing},
+		{"maxPlayers", d.maxPlayers},
+		{"priceRobux", d.priceRobux},
+		{"created", d.createdIso},
+		{"updated", d.updatedIso},
+		{"creatorName", d.creatorName},
+		{"creatorId", d.creatorId},
+		{"creatorType", d.creatorType},
+		{"creatorVerified", d.creatorVerified}
+	};
+}
+
+static DetailEntry detailFromJson(const json &j) {
+	DetailEntry entry;
+	entry.fetchedAtMs = j.value("fetchedAt", 0LL);
+	entry.found = true;
+	Roblox::GameDetail &d = entry.detail;
+	d.name = j.value("name", "");
+	d.genre = j.value("genre", "");
+	d.genreL1 = j.value("genreL1", "");
+	d.genreL2 = j.value("genreL2", "");
+	d.description = j.value("description", "");
+	d.visits = j.value("visits", 0ULL);
+	d.favorites = j.value("favorites", 0ULL);
+	d.playing = j.value("playing", 0);
+	d.maxPlayers = j.value("maxPlayers", 0);
+	d.priceRobux = j.value("priceRobux", -1);
+	d.createdIso = j.value("created", "");
+	d.updatedIso = j.value("updated", "");
+	d.creatorName = j.value("creatorName", "");
+	d.creatorId = j.value("creatorId", 0ULL);
+	d.creatorType = j.value("creatorType", "");
+	d.creatorVerified = j.value("creatorVerified", false);
+	return entry;
+}
+
+// Caller holds g_mutex
+static void loadLocked() {
+	if (g_loaded) { return; }
+	g_loaded = true;
+
+	std::string path = Data::StorageFilePath(kCacheFile);
+	std::ifstream in {path};
+	if (!in.is_open()) { return; }
+	try {
+		json root;
+		in >> root;
+		int64_t oldest = nowMs() - kDiskMaxAgeMs;
+		for (const auto &j : root.value("details", json::array())) {
+			uint64_t universeId = j.value("universeId", 0ULL);
+			DetailEntry entry = detailFromJson(j);
+			if (universeId != 0 && entry.fetchedAtMs >= oldest) { g_details[universeId] = std::move(entry); }
+		}
+		for (const auto &j : root.value("places", json::array())) {
+			uint64_t placeId = j.value("placeId", 0ULL);
+			uint64_t universeId = j.value("universeId", 0ULL);
+			if (placeId != 0 && universeId != 0) { g_places[placeId] = {universeId, 0}; }
+		}
+		LOG_INFO(
+			"Loaded " + std::to_string(g_details.size()) + " cached games and " + std::to_string(g_places.size())
+			+ " places"
+		);
+	} catch (const std::exception &e) { LOG_ERROR("Could not parse " + path + ": " + e.what()); }
+}
+
+static void save() {
+	json details = json::array();
+	json places = json::array();
+	{
+		std::lock_guard<std::mutex> lock(g_mutex);
+		std::vector<std::pair<uint64_t, const DetailEntry *>> kept;
+		kept.reserve(g_details.size());
+		for (const auto &[universeId, entry] : g_details) {
+			if (entry.found) { kept.emplace_back(universeId, &entry); }
+		}
+		if (kept.size() > kDiskMaxDetails) {
+			auto newer = [](const auto &a, const auto &b) { return a.second->fetchedAtMs > b.second->fetchedAtMs; };
+			std::nth_element(kept.begin(), kept.begin() + kDiskMaxDetails, kept.end(), newer);
+			kept.resize(kDiskMaxDetails);
+		}
+		for (const auto &[universeId, entry] : kept) { details.push_back(detailToJson(universeId, *entry)); }
+		for (const auto &[placeId, entry] : g_places) {
+			if (entry.universeId != 0) { places.push_back({{"placeId", placeId}, {"universeId", entry.universeId}}); }
+		}
+	}
+
+	// Saved after every batch, so the cache is written to a temporary file and swapped in; a crash mid-write leaves
+	// the previous cache intact
+	std::string path = Data::StorageFilePath(kCacheFile);
+	std::string temp = path + ".tmp";
+	{
+		std::ofstream out(temp, std::ios::trunc);
+		if (!out.is_open()) {
+			LOG_ERROR("Could not open '" + temp + "' for writing");
+			return;
+		}
+		out << json {{"details", std::move(details)}, {"places", std::move(places)}}.dump();
+	}
+	std::error_code ec;
+	std::filesystem::rename(temp, path, ec);
+	if (ec) { LOG_ERROR("Could not save game cache: " + ec.message()); }
+}
+
+// Caller holds g_mutex
+static bool needsFetchLocked(uint64_t universeId, int64_t now) {
+	auto it = g_details.find(universeId);
+	if (it == g_details.end()) { return true; }
+	int64_t ttl = it->second.found ? kDetailTtlMs : kMissingRetryMs;
+	return now - it->second.fetchedAtMs > ttl;
+}
+
+// Caller holds g_mutex; returns true if the universe was newly queued
+static bool queueUniverseLocked(uint64_t universeId, int64_t now) {
+	if (universeId == 0 || g_inFlightUniverses.count(universeId) || !needsFetchLocked(universeId, now)) {
+		return false;
+	}
+	return g_pendingUniverses.insert(universeId).second;
+}
+
+// Caller holds g_mutex; places that resolved queue their universe instead
+static bool queuePlaceLocked(uint64_t placeId, int64_t now) {
+	if (placeId == 0 || g_inFlightPlaces.count(placeId)) { return false; }
+	auto it = g_places.find(placeId);
+	if (it == g_places.end() || (it->second.universeId == 0 && now - it->second.resolvedAtMs > kMissingRetryMs)) {
+		return g_pendingPlaces.insert(placeId).second;
+	}
+	return queueUniverseLocked(it->second.universeId, now);
+}
+
+static void runBatches() {
+	for (;;) {
+		std::this_thread::sleep_for(kBatchWindow);
+
+		std::vector<uint64_t> placeIds;
+		{
+			std::lock_guard<std::mutex> lock(g_mutex);
+			placeIds.assign(g_pendingPlaces.begin(), g_pendingPlaces.end());
+			g_inFlightPlaces.swap(g_pendingPlaces);
+			g_pendingPlaces.clear();
+		}
+
+		// The batch place endpoint needs an authenticated session, so places are resolved one at a time; each one
+		// is only ever looked up once.
+		std::vector<std::pair<uint64_t, uint64_t>> resolved;
+		for (uint64_t placeId : placeIds) { resolved.emplace_back(placeId, Roblox::getUniverseIdForPlace(placeId)); }
+
+		std::vector<uint64_t> universeIds;
+		{
+			std::lock_guard<std::mutex> lock(g_mutex);
+			int64_t now = nowMs();
+			for (const auto &[placeId, universeId] : resolved) {
+				g_places[placeId] = {universeId, now};
+				queueUniverseLocked(universeId, now);
+			}
+			g_inFlightPlaces.clear();
+			universeIds.assign(g_pendingUniverses.begin(), g_pendingUniverses.end());
+			g_inFlightUniverses.swap(g_pendingUniverses);
+			g_pendingUniverses.clear();
+			if (universeIds.empty() && resolved.empty()) {
+				g_workerRunning = false;
+				return;
+			}
+		}
+
+		auto details = universeIds.empty() ? std::unordered_map<uint64_t, Roblox::GameDetail> {}
+										   : Roblox::getGameDetails(universeIds);
+		{
+			std::lock_guard<std::mutex> lock(g_mutex);
+			int64_t now = nowMs();
+			for (uint64_t universeId : universeIds) {
+				DetailEntry &entry = g_details[universeId];
+				auto found = details.find(universeId);
+				if (found != details.end()) {
+					entry.detail = std::move(found->second);
+					entry.found = true;
+					entry.fetchedAtMs = now;
+				} else if (entry.found) {
+					// Keep showing the old detail, but retry on the shorter schedule
+					entry.fetchedAtMs = now - kDetailTtlMs + kMissingRetryMs;
+				} else {
+					entry.fetchedAtMs = now;
+				}
+			}
+			g_inFlightUniverses.clear();
+			++g_generation;
+		}
+		save();
+	}
+}
+
+// Caller holds g_mutex
+static void startWorkerLocked() {
+	if (g_workerRunning) { return; }
+	g_workerRunning = true;
+	Threading::newThread(runBatches);
+}
+
+namespace GameMetadata {
+	std::optional<Roblox::GameDetail> Detail(uint64_t universeId) {
+		if (universeId == 0) { return std::nullopt; }
+		std::lock_guard<std::mutex> lock(g_mutex);
+		loadLocked();
+		if (queueUniverseLocked(universeId, nowMs())) { startWorkerLocked(); }
+		auto it = g_details.find(universeId);
+		if (it == g_details.end() || !it->second.found) { return std::nullopt; }
+		return it->second.detail;
+	}
+
+	uint64_t UniverseForPlace(uint64_t placeId) {
+		if (placeId == 0) { return 0; }
+		std::lock_guard<std::mutex> lock(g_mutex);
+		loadLocked();
+		if (queuePlaceLocked(placeId, nowMs())) { startWorkerLocked(); }
+		auto it = g_places.find(placeId);
+		return it != g_places.end() ? it->second.universeId : 0;
+	}
+
+	void Request(const std::vector<uint64_t> &universeIds) {
+		std::lock_guard<std::mutex> lock(g_mutex);
+		loadLocked();
+		int64_t now = nowMs();
+		bool queued = false;
+		for (uint64_t universeId : universeIds) { queued |= queueUniverseLocked(universeId, now); }
+		if (queued) { startWorkerLocked(); }
+	}
+
+	void RequestPlaces(const std::vector<uint64_t> &placeIds) {
+		std::lock_guard<std::mutex> lock(g_mutex);
+		loadLocked();
+		int64_t now = nowMs();
+		bool queued = false;
+		for (uint64_t placeId : placeIds) { queued |= queuePlaceLocked(placeId, now); }
+		if (queued) { startWorkerLocked(); }
+	}
+
+	uint64_t Generation() {
+		std::lock_guard<std::mutex> lock(g_mutex);
+		return g_generation;
+	}
+} // namespace GameMetadata
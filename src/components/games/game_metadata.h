@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "network/roblox/games.h"
+
+// Game details and place -> universe lookups shared by the games, favorites and history views. Requests made within
+// a few milliseconds of each other are fetched as one batch on a background thread, and results are kept on disk in
+// game_cache.json so names show up immediately on the next start. Details are refetched once they are ten minutes
+// old; place -> universe lookups never change and are kept for good.
+namespace GameMetadata {
+	// Cached detail, possibly stale (a refresh is queued), or nullopt while the first fetch is pending
+	std::optional<Roblox::GameDetail> Detail(uint64_t universeId);
+
+	// Cached universe for the place, or 0 while the lookup is pending
+	uint64_t UniverseForPlace(uint64_t placeId);
+
+	// Queues every missing or stale universe for the next batch
+	void Request(const std::vector<uint64_t> &universeIds);
+
+	// Queues unresolved places; their universes' details are fetched in the same batch
+	void RequestPlaces(const std::vector<uint64_t> &placeIds);
+
+	// Changes whenever a batch lands, so views can refresh what they copied out
+	uint64_t Generation();
+} // namespace GameMetadata
@@ -2,6 +2,8 @@
 #include "games.h"
 #include "games_utils.h"
 #include <algorithm>
+#include <cctype>
+#include <chrono>
 #include <cmath>
 #include <imgui.h>
 #include <string>
@@ -17,9 +19,13 @@
 #include "../components.h"
 #include "../context_menus.h"
 #include "../servers/servers_utils.h"
+#include "game_metadata.h"
+#include "core/lru_cache.h"
 #include "core/status.h"
 #include "network/roblox.h"
 #include "system/launcher.hpp"
+#include "system/main_thread.h"
+#include "system/threading.h"
 #include "ui/modal_popup.h"
 #include "ui/webview.hpp"
 
@@ -43,7 +49,6 @@ static char searchBuffer[64] = "";
 static int selectedIndex = -1;
 static vector<GameInfo> gamesList;
 static vector<GameInfo> originalGamesList;
-static unordered_map<uint64_t, Roblox::GameDetail> gameDetailCache;
 
 static unordered_set<uint64_t> favoriteGameIds;
 static auto ICON_OPEN_LINK = "\xEF\x8A\xBB ";
@@ -52,6 +57,7 @@ static auto ICON_LAUNCH = "\xEF\x84\xB5 ";
 static auto ICON_SERVER = "\xEF\x88\xB3 ";
 static vector<GameInfo> favoriteGamesList;
 static bool hasLoadedFavorites = false;
+static uint64_t favoritesMetadataGeneration = UINT64_MAX; // GameMetadata generation the favorites last copied from
 static char renameBuffer[128] = "";
 static uint64_t renamingUniverseId = 0;
 
@@ -60,12 +66,28 @@ enum class GameSortMode { Relevance = 0, PlayersDesc, PlayersAsc, NameAsc, NameD
 static GameSortMode currentSortMode = GameSortMode::Relevance;
 static int sortComboIndex = 0;
 
+// Omni-search runs on a background thread and its results are applied on the UI thread, only if no newer search was
+// started meanwhile. Results are kept per normalized query, so repeating a recent search needs no request.
+static constexpr size_t kSearchCacheEntries = 32;
+static constexpr auto kSearchCacheTtl = std::chrono::minutes(5);
+static constexpr auto kTypeAheadDelay = std::chrono::milliseconds(400);
+static constexpr size_t kTypeAheadMinChars = 3;
+
+static LruCache<string, vector<GameInfo>> searchCache(kSearchCacheEntries, kSearchCacheTtl);
+static uint64_t searchGeneration = 0; // Bumped per search; results of older generations are dropped
+static bool searchInFlight = false;
+static string submittedQueryKey; // Normalized query of the latest search
+static string typedQueryKey; // Normalized contents of searchBuffer as of typedAt
+static std::chrono::steady_clock::time_point typedAt;
+
 static void SortGamesList();
 
 static void RenderGameSearch();
 
 static void RenderFavoritesList(float listWidth, float availableHeight);
 
+static void refreshFavoritesFromMetadata();
+
 static void RenderSearchResultsList(float listWidth, float availableHeight);
 
 static void RenderGameDetailsPanel(float panelWidth, float availableHeight);
@@ -95,6 +117,76 @@ static void SortGamesList() {
 	}
 }
 
+// Trimmed and lowercased; the cache key for a query
+static string normalizedQuery(const char *query) {
+	string key(query);
+	auto notSpace = [](unsigned char c) { return !std::isspace(c); };
+	key.erase(key.begin(), find_if(key.begin(), key.end(), notSpace));
+	key.erase(find_if(key.rbegin(), key.rend(), notSpace).base(), key.end());
+	for (char &c : key) { c = static_cast<char>(std::tolower(static_cast<unsigned char>(c))); }
+	return key;
+}
+
+static void applySearchResults(vector<GameInfo> results) {
+	selectedIndex = -1;
+	originalGamesList = std::move(results);
+	erase_if_local(originalGamesList, [&](const GameInfo &g) { return favoriteGameIds.count(g.universeId) != 0; });
+	SortGamesList();
+	// One batched detail request for the whole page, so selecting a result shows its details straight away
+	vector<uint64_t> universeIds;
+	universeIds.reserve(originalGamesList.size());
+	for (const auto &game : originalGamesList) { universeIds.push_back(game.universeId); }
+	GameMetadata::Request(universeIds);
+}
+
+static void submitSearch(const char *query) {
+	string key = normalizedQuery(query);
+	if (key.empty()) { return; }
+	submittedQueryKey = key;
+	// Supersedes a search still running; its response is cached but not shown
+	uint64_t generation = ++searchGeneration;
+
+	if (const vector<GameInfo> *cached = searchCache.find(key)) {
+		searchInFlight = false;
+		applySearchResults(*cached);
+		return;
+	}
+
+	searchInFlight = true;
+	Threading::newThread([query = string(query), key, generation]() {
+		vector<GameInfo> results;
+		try {
+			results = Roblox::searchGames(query);
+		} catch (const std::exception &e) { LOG_ERROR(string("Game search failed: ") + e.what()); }
+		MainThread::Post([key, generation, results = std::move(results)]() mutable {
+			// Empty results are usually a failed request, so they are not cached
+			if (!results.empty()) { searchCache.put(key, results); }
+			if (generation != searchGeneration) { return; }
+			searchInFlight = false;
+			applySearchResults(std::move(results));
+		});
+	});
+}
+
+static void cancelSearch() {
+	++searchGeneration;
+	searchInFlight = false;
+	submittedQueryKey.clear();
+}
+
+// Type-ahead: searches once the text has been left alone for kTypeAheadDelay
+static void pollTypeAhead() {
+	auto now = std::chrono::steady_clock::now();
+	string key = normalizedQuery(searchBuffer);
+	if (key != typedQueryKey) {
+		typedQueryKey = std::move(key);
+		typedAt = now;
+		return;
+	}
+	if (typedQueryKey.size() < kTypeAheadMinChars || typedQueryKey == submittedQueryKey) { return; }
+	if (now - typedAt >= kTypeAheadDelay) { submitSearch(searchBuffer); }
+}
+
 static void RenderGameSearch() {
 	ImGuiStyle &style = GetStyle();
 	const char *sortOptions[] = {"Relevance", "Players (Asc)", "Players (Desc)", "A-Z", "Z-A"};
@@ -112,19 +204,17 @@ static void RenderGameSearch() {
 	PopItemWidth();
 	SameLine(0, style.ItemSpacing.x);
 	if (Button(" \xEF\x80\x82  Search ", ImVec2(searchButtonWidth, 0)) && searchBuffer[0] != '\0') {
-		selectedIndex = -1;
-		originalGamesList = Roblox::searchGames(searchBuffer);
-		erase_if_local(originalGamesList, [&](const GameInfo &g) { return favoriteGameIds.count(g.universeId) != 0; });
-		SortGamesList();
-		gameDetailCache.clear();
+		submitSearch(searchBuffer);
+	} else if (g_gameSearchTypeAhead) {
+		pollTypeAhead();
 	}
 	SameLine(0, style.ItemSpacing.x);
 	if (Button(" \xEF\x87\xB8  Clear ", ImVec2(clearButtonWidth, 0))) {
+		cancelSearch();
 		searchBuffer[0] = '\0';
 		selectedIndex = -1;
 		originalGamesList.clear();
 		gamesList.clear();
-		gameDetailCache.clear();
 	}
 	SameLine(0, style.ItemSpacing.x);
 	PushItemWidth(comboWidth);
@@ -135,6 +225,28 @@ static void RenderGameSearch() {
 	PopItemWidth();
 }
 
+// Player counts for favorites come from the batched detail fetch; a favorite saved without a name takes the game's
+static void refreshFavoritesFromMetadata() {
+	uint64_t generation = GameMetadata::Generation();
+	if (generation == favoritesMetadataGeneration) { return; }
+	favoritesMetadataGeneration = generation;
+
+	bool renamed = false;
+	for (auto &game : favoriteGamesList) {
+		auto detail = GameMetadata::Detail(game.universeId);
+		if (!detail) { continue; }
+		game.playerCount = detail->playing;
+		if (game.name.empty() && !detail->name.empty()) {
+			game.name = detail->name;
+			for (auto &f : g_favorites) {
+				if (f.universeId == game.universeId) { f.name = detail->name; }
+			}
+			renamed = true;
+		}
+	}
+	if (renamed) { Data::SaveFavorites(); }
+}
+
 static void RenderFavoritesList(float listWidth, float availableHeight) {
 	if (!favoriteGamesList.empty()) {
 		for (int index = 0; index < static_cast<int>(favoriteGamesList.size()); ++index) {
@@ -145,6 +257,10 @@ static void RenderFavoritesList(float listWidth, float availableHeight) {
 			SameLine();
 			if (Selectable(game.name.c_str(), selectedIndex == -1000 - index)) { selectedIndex = -1000 - index; }
 
+			if (IsItemHovered() && game.playerCount > 0) {
+				SetTooltip("Players: %s", formatWithCommas(game.playerCount).c_str());
+			}
+
 			if (BeginPopupContextItem("FavoriteContext")) {
 				{
 					StandardJoinMenuParams menu {};
@@ -166,6 +282,7 @@ static void RenderFavoritesList(float listWidth, float availableHeight) {
 							thread([pid, accounts]() { launchRobloxSequential(pid, "", accounts); }).detach();
 						}
 					};
+					menu.onLaunchBestServer = [pid = game.placeId]() { LaunchSelectedIntoBestServer(pid); };
 					menu.onFillGame = [pid = game.placeId]() { FillJoinOptions(pid, ""); };
 					RenderStandardJoinMenu(menu);
 				}
@@ -230,6 +347,7 @@ static void RenderFavoritesList(float listWidth, float availableHeight) {
 }
 
 static void RenderSearchResultsList(float listWidth, float availableHeight) {
+	if (searchInFlight) { TextDisabled("Searching..."); }
 	for (int index = 0; index < static_cast<int>(gamesList.size()); ++index) {
 		const auto &game = gamesList[index];
 		if (favoriteGameIds.count(game.universeId) != 0) { continue; }
@@ -258,6 +376,7 @@ static void RenderSearchResultsList(float listWidth, float availableHeight) {
 						thread([pid, accounts]() { launchRobloxSequential(pid, "", accounts); }).detach();
 					}
 				};
+				menu.onLaunchBestServer = [pid = game.placeId]() { LaunchSelectedIntoBestServer(pid); };
 				menu.onFillGame = [pid = game.placeId]() { FillJoinOptions(pid, ""); };
 				RenderStandardJoinMenu(menu);
 			}
@@ -289,8 +408,12 @@ void RenderGamesTab() {
 			favoriteGameInfo.playerCount = 0;
 			favoriteGamesList.push_back(favoriteGameInfo);
 		}
+		vector<uint64_t> universeIds;
+		for (const auto &favoriteData : g_favorites) { universeIds.push_back(favoriteData.universeId); }
+		GameMetadata::Request(universeIds);
 		hasLoadedFavorites = true;
 	}
+	refreshFavoritesFromMetadata();
 
 	RenderGameSearch();
 
@@ -340,16 +463,8 @@ static void RenderGameDetailsPanel(float panelWidth, float availableHeight) {
 
 	if (currentGameInfo) {
 		const GameInfo &gameInfo = *currentGameInfo;
-		Roblox::GameDetail detailInfo;
-		auto cacheIterator = gameDetailCache.find(currentUniverseId);
-		if (cacheIterator == gameDetailCache.end()) {
-			if (currentUniverseId != 0) {
-				detailInfo = Roblox::getGameDetail(currentUniverseId);
-				gameDetailCache[currentUniverseId] = detailInfo;
-			}
-		} else {
-			detailInfo = cacheIterator->second;
-		}
+		// Empty until the background fetch lands; the panel fills in on a later frame
+		Roblox::GameDetail detailInfo = GameMetadata::Detail(currentUniverseId).value_or(Roblox::GameDetail {});
 
 		int serverCount
 			= detailInfo.maxPlayers > 0
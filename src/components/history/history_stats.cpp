@@ -0,0 +1,96 @@
+#include "history_stats.h"
+
+namespace {
+	enum MemberKind : uint32_t {
+		PlaceServer,
+		PlaceJob,
+		UniverseServer,
+		UniverseJob,
+		AccountPlace,
+	};
+
+	uint64_t serverKey(const GameSession &session) {
+		return (static_cast<uint64_t>(session.serverIp) << 16) | session.serverPort;
+	}
+} // namespace
+
+void HistoryStats::build(const HistoryStore &store) {
+	clear();
+	for (const auto &log : store.logs) { addLog(store, log); }
+}
+
+void HistoryStats::addLog(const HistoryStore &store, const LogInfo &log) {
+	for (uint32_t i = 0; i < log.sessionCount; ++i) { apply(log.userId, store.session(log, i), 1); }
+}
+
+void HistoryStats::removeLog(const HistoryStore &store, const LogInfo &log) {
+	for (uint32_t i = 0; i < log.sessionCount; ++i) { apply(log.userId, store.session(log, i), -1); }
+}
+
+const PlayStats *HistoryStats::place(uint64_t placeId) const {
+	auto it = m_places.find(placeId);
+	return it != m_places.end() ? &it->second : nullptr;
+}
+
+const PlayStats *HistoryStats::universe(uint64_t universeId) const {
+	auto it = m_universes.find(universeId);
+	return it != m_universes.end() ? &it->second : nullptr;
+}
+
+const AccountPlayStats *HistoryStats::account(uint64_t userId) const {
+	auto it = m_accounts.find(userId);
+	return it != m_accounts.end() ? &it->second : nullptr;
+}
+
+void HistoryStats::clear() {
+	m_places.clear();
+	m_universes.clear();
+	m_accounts.clear();
+	m_members.clear();
+}
+
+int HistoryStats::adjustMember(const MemberKey &key, int delta) {
+	if (delta > 0) { return ++m_members[key] == 1 ? 1 : 0; }
+
+	auto it = m_members.find(key);
+	if (it == m_members.end()) { return 0; }
+	if (--it->second > 0) { return 0; }
+	m_members.erase(it);
+	return -1;
+}
+
+void HistoryStats::bump(PlayStats &stats, const GameSession &session, int delta) {
+	stats.sessions += delta;
+	stats.playTimeMs += delta * static_cast<int64_t>(session.durationMs);
+	if (delta > 0 && session.timestampMs > stats.lastPlayedMs) { stats.lastPlayedMs = session.timestampMs; }
+}
+
+void HistoryStats::apply(uint64_t userId, const GameSession &session, int delta) {
+	bool hasServer = session.serverIp != 0;
+	bool hasJob = !session.jobId.empty();
+
+	// Each rollup only exists while it has sessions, so removals leave nothing behind
+	using RollupMap = std::unordered_map<uint64_t, PlayStats>;
+	auto rollup = [&](RollupMap &map, uint64_t id, uint32_t serverKind, uint32_t jobKind) {
+		if (id == 0) { return; }
+		if (delta < 0 && map.find(id) == map.end()) { return; }
+		PlayStats &stats = map[id];
+		bump(stats, session, delta);
+		if (hasServer) { stats.distinctServers += adjustMember({id, serverKey(session), 0, serverKind}, delta); }
+		if (hasJob) { stats.distinctJobs += adjustMember({id, session.jobId.hi, session.jobId.lo, jobKind}, delta); }
+		if (stats.sessions == 0) { map.erase(id); }
+	};
+	rollup(m_places, session.placeId, PlaceServer, PlaceJob);
+	rollup(m_universes, session.universeId, UniverseServer, UniverseJob);
+
+	if (userId == 0) { return; }
+	if (delta < 0 && m_accounts.find(userId) == m_accounts.end()) { return; }
+	AccountPlayStats &account = m_accounts[userId];
+	account.sessions += delta;
+	account.playTimeMs += delta * static_cast<int64_t>(session.durationMs);
+	if (delta > 0 && session.timestampMs > account.lastPlayedMs) { account.lastPlayedMs = session.timestampMs; }
+	if (session.placeId != 0) {
+		account.distinctPlaces += adjustMember({userId, session.placeId, 0, AccountPlace}, delta);
+	}
+	if (account.sessions == 0) { m_accounts.erase(userId); }
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "session_store.h"
+
+// Totals for one place or universe across every ingested log
+struct PlayStats {
+		uint32_t sessions = 0;
+		uint32_t distinctServers = 0; // Distinct server ip:port pairs
+		uint32_t distinctJobs = 0; // Distinct job IDs
+		int64_t playTimeMs = 0;
+		int64_t lastPlayedMs = 0; // High-water mark; not lowered when sessions are removed
+};
+
+// Totals for one account (log user ID) across every ingested log
+struct AccountPlayStats {
+		uint32_t sessions = 0;
+		uint32_t distinctPlaces = 0;
+		int64_t playTimeMs = 0;
+		int64_t lastPlayedMs = 0;
+};
+
+// Play-time and server rollups kept up to date as logs are ingested, so the History tab can answer "how long have I
+// played this place" without walking every session. Logs can be removed and re-added when the tailer replaces their
+// sessions; distinct counts are reference counted so they stay exact.
+class HistoryStats {
+	public:
+		// Rebuilds the rollups from every log of store
+		void build(const HistoryStore &store);
+
+		void addLog(const HistoryStore &store, const LogInfo &log);
+
+		// Undoes addLog; log must still reference the rows it was added with
+		void removeLog(const HistoryStore &store, const LogInfo &log);
+
+		const PlayStats *place(uint64_t placeId) const;
+
+		const PlayStats *universe(uint64_t universeId) const;
+
+		const AccountPlayStats *account(uint64_t userId) const;
+
+		size_t placeCount() const { return m_places.size(); }
+
+		void clear();
+
+	private:
+		// Reference-counted membership: (kind, owner) has seen value (a, b)
+		struct MemberKey {
+				uint64_t owner = 0;
+				uint64_t a = 0;
+				uint64_t b = 0;
+				uint32_t kind = 0;
+
+				bool operator==(const MemberKey &other) const {
+					return owner == other.owner && a == other.a && b == other.b && kind == other.kind;
+				}
+		};
+
+		struct MemberKeyHash {
+				size_t operator()(const MemberKey &key) const {
+					uint64_t h = key.owner * 0x9E3779B97F4A7C15ULL;
+					h ^= key.a + 0x7F4A7C159E3779B9ULL + (h << 6) + (h >> 2);
+					h ^= key.b + 0x94D049BB133111EBULL + (h << 6) + (h >> 2);
+					h ^= key.kind + (h << 6) + (h >> 2);
+					return static_cast<size_t>(h);
+				}
+		};
+
+		void apply(uint64_t userId, const GameSession &session, int delta);
+
+		// Adjusts the membership count and returns +1/-1 when the member appears/disappears, else 0
+		int adjustMember(const MemberKey &key, int delta);
+
+		static void bump(PlayStats &stats, const GameSession &session, int delta);
+
+		std::unordered_map<uint64_t, PlayStats> m_places;
+		std::unordered_map<uint64_t, PlayStats> m_universes;
+		std::unordered_map<uint64_t, AccountPlayStats> m_accounts;
+		std::unordered_map<MemberKey, uint32_t, MemberKeyHash> m_members;
+};
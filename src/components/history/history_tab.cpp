@@ -16,17 +16,24 @@
 
 #include "core/time_utils.h"
 #include "history.h"
+#include "history_stats.h"
 #include "history_utils.h"
 #include "log_parser.h"
+#include "log_watcher.h"
 #include "log_types.h"
+#include "search_index.h"
+#include "session_store.h"
 
 #include "../../ui.h"
 #include "../../utils/core/account_utils.h"
 #include "../accounts/accounts_join_ui.h"
 #include "../context_menus.h"
 #include "../data.h"
+#include "../games/game_metadata.h"
 #include "core/status.h"
+#include "core/structured_log.h"
 #include "system/launcher.hpp"
+#include "system/main_thread.h"
 #include "system/threading.h"
 #include "ui/confirm.h"
 #include "ui/modal_popup.h"
@@ -56,7 +63,10 @@ static auto ICON_TRASH = "\xEF\x87\xB8 ";
 static auto ICON_FOLDER = "\xEF\x81\xBB ";
 static auto ICON_JOIN = "\xEF\x8B\xB6 ";
 
-static vector<LogInfo> g_logs;
+static HistoryStore g_history;
+static LogSearchIndex g_search_index; // Mirrors g_history.logs, guarded by g_logs_mtx
+static HistoryStats g_history_stats; // Play-time rollups over g_history, guarded by g_logs_mtx
+static vector<LogWatcher::LogUpdate> g_pending_live_updates; // Tail updates that arrived during a rescan
 static atomic_bool g_logs_loading {false};
 static atomic_bool g_stop_log_watcher {false};
 static once_flag g_start_log_watcher_once;
@@ -64,6 +74,9 @@ static mutex g_logs_mtx;
 static char g_search_buffer[128] = ""; // Buffer to hold search text
 static vector<int> g_filtered_log_indices; // Indices of logs that match the search
 static bool g_search_active = false; // Flag to indicate if search is active
+static string g_last_search_term; // Lowercased term that produced g_filtered_log_indices
+static uint64_t g_history_generation = 0; // Bumped on every change to g_history, guarded by g_logs_mtx
+static uint64_t g_last_search_generation = 0; // g_history_generation that g_filtered_log_indices was computed against
 static bool g_should_scroll_to_selection = false; // Flag to auto-scroll to selection when search is cleared
 
 static void openLogsFolder() {
@@ -76,17 +89,21 @@ static void openLogsFolder() {
 }
 
 static void updateFilteredLogs() {
-	g_filtered_log_indices.clear();
+	bool wasActive = g_search_active;
 	g_search_active = (g_search_buffer[0] != '\0');
 
 	// Return early if logs are loading - don't apply filters during load
 	if (g_logs_loading.load()) {
 		g_search_buffer[0] = '\0'; // Clear search
 		g_search_active = false;
+		g_filtered_log_indices.clear();
+		g_last_search_term.clear();
 		return;
 	}
 
 	if (!g_search_active) {
+		g_filtered_log_indices.clear();
+		g_last_search_term.clear();
 		return; // No search active, no need to filter
 	}
 
@@ -94,74 +111,22 @@ static void updateFilteredLogs() {
 	string searchTerm = g_search_buffer;
 	transform(searchTerm.begin(), searchTerm.end(), searchTerm.begin(), ::tolower);
 
-	// Find logs matching the search term
+	// Find logs matching the search term. Over unchanged logs, a term that extends the previous one can only match a
+	// subset of the previous results, so typing further narrows the last result set instead of querying every log
+	// again. Once logs have been added or updated the previous results may miss matches, so every log is queried.
 	lock_guard<mutex> lk(g_logs_mtx);
-	for (int i = 0; i < static_cast<int>(g_logs.size()); ++i) {
-		const auto &log = g_logs[i];
-
-		// Skip installer logs
-		if (log.isInstallerLog) { continue; }
-
-		// Convert filename to lowercase for case-insensitive comparison
-		string filename = log.fileName;
-		transform(filename.begin(), filename.end(), filename.begin(), ::tolower);
-
-		// Check various fields for matches
-		bool found = false;
-
-		// Check filename
-		if (filename.find(searchTerm) != string::npos) { found = true; }
-
-		// Check full path
-		string path = log.fullPath;
-		transform(path.begin(), path.end(), path.begin(), ::tolower);
-		if (path.find(searchTerm) != string::npos) { found = true; }
-
-		// Check version
-		string version = log.version;
-		transform(version.begin(), version.end(), version.begin(), ::tolower);
-		if (version.find(searchTerm) != string::npos) { found = true; }
-
-		// Check placeId
-		string placeId = log.placeId;
-		if (placeId.find(searchTerm) != string::npos) { found = true; }
-
-		// Check jobId
-		string jobId = log.jobId;
-		if (jobId.find(searchTerm) != string::npos) { found = true; }
-
-		// Check universeId
-		string universeId = log.universeId;
-		if (universeId.find(searchTerm) != string::npos) { found = true; }
-
-		// Check user ID
-		string userId = log.userId;
-		if (userId.find(searchTerm) != string::npos) { found = true; }
-
-		// Check session data
-		for (const auto &session : log.sessions) {
-			if (session.placeId.find(searchTerm) != string::npos || session.jobId.find(searchTerm) != string::npos
-				|| session.universeId.find(searchTerm) != string::npos
-				|| session.serverIp.find(searchTerm) != string::npos) {
-				found = true;
-				break;
-			}
-		}
-
-		if (found) { g_filtered_log_indices.push_back(i); }
-	}
+	bool canNarrow = wasActive && !g_last_search_term.empty() && g_last_search_generation == g_history_generation
+				  && searchTerm != g_last_search_term && searchTerm.find(g_last_search_term) != string::npos;
+	vector<int> previous;
+	if (canNarrow) { previous.swap(g_filtered_log_indices); }
+	g_search_index.query(searchTerm, canNarrow ? &previous : nullptr, g_filtered_log_indices);
+	g_last_search_term = searchTerm;
+	g_last_search_generation = g_history_generation;
 
 	// If the current selection is no longer in the filtered list, deselect it
-	if (g_selected_log_idx != -1) {
-		bool selectionInFiltered = false;
-		for (int idx : g_filtered_log_indices) {
-			if (idx == g_selected_log_idx) {
-				selectionInFiltered = true;
-				break;
-			}
-		}
-
-		if (!selectionInFiltered) { g_selected_log_idx = -1; }
+	if (g_selected_log_idx != -1
+		&& !std::binary_search(g_filtered_log_indices.begin(), g_filtered_log_indices.end(), g_selected_log_idx)) {
+		g_selected_log_idx = -1;
 	}
 }
 
@@ -178,9 +143,67 @@ static void clearLogs() {
 	}
 	{
 		lock_guard<mutex> lk(g_logs_mtx);
-		g_logs.clear();
+		g_history.clear();
+		g_search_index.clear();
+		g_history_stats.clear();
 		g_selected_log_idx = -1;
+		++g_history_generation;
+	}
+}
+
+// Merges a tailed log into the store; caller holds g_logs_mtx. A live log's rows are almost always the last ones in the
+// session table, and are then rewritten in place. Otherwise new rows are appended and the log is repointed at them,
+// leaving its previous rows unreferenced until the next full refresh.
+static void applyLiveUpdate(const LogWatcher::LogUpdate &update) {
+	int index = -1;
+	for (int i = static_cast<int>(g_history.logs.size()) - 1; i >= 0; --i) {
+		if (g_history.logs[i].fileName == update.fileName) {
+			index = i;
+			break;
+		}
+	}
+	if (index < 0) {
+		if (update.timestampMs == 0 && update.version.empty()) { return; }
+		LogInfo logInfo;
+		logInfo.fileName = update.fileName;
+		logInfo.fullPath = update.fullPath;
+		logInfo.firstOutputLine = static_cast<uint32_t>(g_history.outputLines.size());
+		g_history.logs.push_back(std::move(logInfo));
+		index = static_cast<int>(g_history.logs.size()) - 1;
+	}
+
+	LogInfo &logInfo = g_history.logs[index];
+	if (logInfo.timestampMs == 0) { logInfo.timestampMs = update.timestampMs; }
+	if (logInfo.versionId == 0) { logInfo.versionId = g_history.strings.intern(update.version); }
+	if (logInfo.channelId == 0) { logInfo.channelId = g_history.strings.intern(update.channel); }
+	// Retract the log's previous sessions from the rollups before repointing it
+	g_history_stats.removeLog(g_history, logInfo);
+	if (logInfo.userId == 0) { logInfo.userId = update.userId; }
+
+	if (static_cast<size_t>(logInfo.firstSession) + logInfo.sessionCount == g_history.sessions.size()) {
+		g_history.sessions.truncate(logInfo.firstSession);
 	}
+	logInfo.firstSession = static_cast<uint32_t>(g_history.sessions.size());
+	logInfo.sessionCount = static_cast<uint32_t>(update.sessions.size());
+	for (const auto &session : update.sessions) { g_history.sessions.push(session); }
+
+	g_search_index.update(g_history, static_cast<size_t>(index));
+	g_history_stats.addLog(g_history, logInfo);
+	++g_history_generation;
+}
+
+static void onLiveLogUpdate(const LogWatcher::LogUpdate &update) {
+	{
+		lock_guard<mutex> lk(g_logs_mtx);
+		if (g_logs_loading.load()) {
+			g_pending_live_updates.push_back(update);
+			return;
+		}
+		applyLiveUpdate(update);
+	}
+	MainThread::Post([]() {
+		if (g_search_active) { updateFilteredLogs(); }
+	});
 }
 
 static void refreshLogs() {
@@ -189,35 +212,40 @@ static void refreshLogs() {
 	g_logs_loading = true;
 	Threading::newThread([]() {
 		LOG_INFO("Scanning Roblox logs folder...");
-		vector<LogInfo> tempLogs;
-		string dir = logsFolder();
-		if (!dir.empty() && fs::exists(dir)) {
-			for (const auto &entry : fs::directory_iterator(dir)) {
-				if (entry.is_regular_file()) {
-					string fName = entry.path().filename().string();
-					if (fName.length() > 4 && fName.substr(fName.length() - 4) == ".log") {
-						LogInfo logInfo;
-						logInfo.fileName = fName;
-						logInfo.fullPath = entry.path().string();
-						parseLogFile(logInfo);
-						if (!logInfo.timestamp.empty() || !logInfo.version.empty()) { tempLogs.push_back(logInfo); }
-					}
-				}
-			}
-		}
-
-		sort(tempLogs.begin(), tempLogs.end(), [](const LogInfo &a, const LogInfo &b) {
-			return b.timestamp < a.timestamp;
-		});
+		auto scanStart = std::chrono::steady_clock::now();
+		HistoryStore tempStore;
+		scanLogFolder(logsFolder(), tempStore);
+		size_t logCount = tempStore.logs.size();
+		size_t sessionCount = tempStore.sessions.size();
+
+		// Build the search index here so filtering on the UI thread never touches raw fields
+		LogSearchIndex tempIndex;
+		tempIndex.build(tempStore);
+		HistoryStats tempStats;
+		tempStats.build(tempStore);
 		{
 			lock_guard<mutex> lk(g_logs_mtx);
-			g_logs.clear();
-			g_logs = tempLogs;
+			g_history = std::move(tempStore);
+			g_search_index = std::move(tempIndex);
+			g_history_stats = std::move(tempStats);
 			g_selected_log_idx = -1;
+			++g_history_generation;
+
+			// Live updates are complete snapshots of their log, so replaying them over the fresh scan is safe
+			for (const auto &update : g_pending_live_updates) { applyLiveUpdate(update); }
+			g_pending_live_updates.clear();
+			g_logs_loading = false;
 		}
 
-		LOG_INFO("Log scan complete. Recreated logs cache with " + std::to_string(tempLogs.size()) + " logs.");
-		g_logs_loading = false;
+		LOG_INFO("Log scan complete. Recreated logs cache with " + std::to_string(logCount) + " logs.");
+		StructuredLog::Write(
+			StructuredLog::Level::Info,
+			"history",
+			"Log scan complete",
+			{{"logs", logCount},
+			 {"sessions", sessionCount},
+			 {"ms", std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - scanStart).count()}}
+		);
 
 		// Update filtered logs after refresh completes
 		updateFilteredLogs();
@@ -234,12 +262,18 @@ static void startLogWatcher() {
 	{
 		lock_guard<mutex> lk(g_logs_mtx);
 		// Clear logs instead of loading from cache - always start fresh
-		g_logs.clear();
+		g_history.clear();
+		g_search_index.clear();
+		g_history_stats.clear();
 	}
 	// Reset search state when starting
 	g_search_buffer[0] = '\0';
 	g_search_active = false;
 	g_filtered_log_indices.clear();
+	g_last_search_term.clear();
+
+	// New joins arrive from the tailer between refreshes
+	LogWatcher::Subscribe(onLiveLogUpdate);
 
 	refreshLogs();
 }
@@ -256,7 +290,14 @@ static void DisplayOptionalText(const char *label, const string &value) {
 	}
 }
 
-static void DisplayLogDetails(const LogInfo &logInfo) {
+static string describePlayStats(const PlayStats &stats) {
+	return to_string(stats.sessions) + (stats.sessions == 1 ? " session, " : " sessions, ")
+		 + formatPlayTime(stats.playTimeMs) + " played, " + to_string(stats.distinctServers)
+		 + (stats.distinctServers == 1 ? " server, " : " servers, ") + to_string(stats.distinctJobs)
+		 + (stats.distinctJobs == 1 ? " job" : " jobs");
+}
+
+static void DisplayLogDetails(const HistoryStore &store, const HistoryStats &stats, const LogInfo &logInfo) {
 	float desiredTextIndent = 8.0f;
 
 	ImGuiTableFlags tableFlags = ImGuiTableFlags_BordersInnerH | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit;
@@ -271,6 +312,7 @@ static void DisplayLogDetails(const LogInfo &logInfo) {
 		labels.push_back("Version:");
 		labels.push_back("Channel:");
 		labels.push_back("User ID:");
+		labels.push_back("Played:");
 		float mx = 0.0f;
 		for (const char *lbl : labels) { mx = (std::max)(mx, CalcTextSize(lbl).x); }
 		historyLabelColumnWidth = (std::max)(historyLabelColumnWidth, mx + GetFontSize() + GetFontSize());
@@ -317,21 +359,29 @@ static void DisplayLogDetails(const LogInfo &logInfo) {
 			EndPopup();
 		}
 
-		string timeStr = friendlyTimestamp(logInfo.timestamp);
 		// Add relative in info panel for richer context
-		time_t tAbs = parseIsoTimestamp(logInfo.timestamp);
-		string timeWithRel = (tAbs ? formatAbsoluteWithRelativeLocal(tAbs) : timeStr);
-		addRow("Time:", timeWithRel);
-		addRow("Version:", logInfo.version);
-		addRow("Channel:", logInfo.channel);
-		addRow("User ID:", logInfo.userId);
+		time_t tAbs = static_cast<time_t>(logInfo.timestampMs / 1000);
+		addRow("Time:", tAbs ? formatAbsoluteWithRelativeLocal(tAbs) : string {});
+		addRow("Version:", store.version(logInfo));
+		addRow("Channel:", store.channel(logInfo));
+		addRow("User ID:", logInfo.userId ? to_string(logInfo.userId) : string {});
+
+		// Totals for this account across every log, not just this one
+		if (const AccountPlayStats *account = stats.account(logInfo.userId)) {
+			addRow(
+				"Played:",
+				to_string(account->sessions) + (account->sessions == 1 ? " session, " : " sessions, ")
+					+ formatPlayTime(account->playTimeMs) + " across " + to_string(account->distinctPlaces)
+					+ (account->distinctPlaces == 1 ? " place" : " places")
+			);
+		}
 
 		EndTable();
 	}
 	PopStyleVar();
 
 	// Display game instances section
-	if (!logInfo.sessions.empty()) {
+	if (logInfo.sessionCount > 0) {
 		Spacing();
 		Spacing();
 		Spacing();
@@ -348,16 +398,46 @@ static void DisplayLogDetails(const LogInfo &logInfo) {
 
 		ImGuiTreeNodeFlags baseFlags = ImGuiTreeNodeFlags_DefaultOpen;
 
+		// Game names for every instance come from one batched lookup; already cached games queue nothing
+		{
+			vector<uint64_t> universeIds;
+			vector<uint64_t> placeIds;
+			for (uint32_t i = 0; i < logInfo.sessionCount; i++) {
+				const GameSession session = store.session(logInfo, i);
+				if (session.universeId) {
+					universeIds.push_back(session.universeId);
+				} else if (session.placeId) {
+					placeIds.push_back(session.placeId);
+				}
+			}
+			GameMetadata::Request(universeIds);
+			GameMetadata::RequestPlaces(placeIds);
+		}
+
 		// Display each game instance with alternating colors
 		ImGui::PushStyleVar(ImGuiStyleVar_ChildRounding, 3.0f);
 
-		for (size_t i = 0; i < logInfo.sessions.size(); i++) {
-			const auto &session = logInfo.sessions[i];
+		for (uint32_t i = 0; i < logInfo.sessionCount; i++) {
+			const GameSession session = store.session(logInfo, i);
+
+			// Decode the compact columns once for display
+			const string placeIdStr = session.placeId ? to_string(session.placeId) : string {};
+			const string jobIdStr = formatJobGuid(session.jobId);
+			const string universeIdStr = session.universeId ? to_string(session.universeId) : string {};
+			const string serverIpStr = formatIpv4(session.serverIp);
+			const string serverPortStr = session.serverPort ? to_string(session.serverPort) : string {};
+			const string durationStr = session.durationMs ? formatPlayTime(session.durationMs) : string {};
+			const PlayStats *placeStats = stats.place(session.placeId);
+			const string placeStatsStr = placeStats ? describePlayStats(*placeStats) : string {};
+			const uint64_t gameUniverseId
+				= session.universeId ? session.universeId : GameMetadata::UniverseForPlace(session.placeId);
+			const auto gameDetail = GameMetadata::Detail(gameUniverseId);
+			const string gameNameStr = gameDetail ? gameDetail->name : string {};
 
 			// Create a session title with timestamp
 			string sessionTitle;
-			if (!session.timestamp.empty()) {
-				string friendlyTime = friendlyTimestamp(session.timestamp);
+			if (session.timestampMs != 0) {
+				string friendlyTime = friendlyTimestamp(session.timestampMs);
 				sessionTitle = friendlyTime; // Removed the refresh icon
 			} else {
 				sessionTitle = "Game Instance " + to_string(i + 1); // Removed the refresh icon
@@ -387,11 +467,14 @@ static void DisplayLogDetails(const LogInfo &logInfo) {
 					float instLabelWidth = GetFontSize() * 7.5f;
 					{
 						vector<const char *> ilabels;
-						if (!session.placeId.empty()) { ilabels.push_back("Place ID:"); }
-						if (!session.jobId.empty()) { ilabels.push_back("Job ID:"); }
-						if (!session.universeId.empty()) { ilabels.push_back("Universe ID:"); }
-						if (!session.serverIp.empty()) { ilabels.push_back("Server IP:"); }
-						if (!session.serverPort.empty()) { ilabels.push_back("Server Port:"); }
+						if (!gameNameStr.empty()) { ilabels.push_back("Game:"); }
+						if (!placeIdStr.empty()) { ilabels.push_back("Place ID:"); }
+						if (!jobIdStr.empty()) { ilabels.push_back("Job ID:"); }
+						if (!universeIdStr.empty()) { ilabels.push_back("Universe ID:"); }
+						if (!serverIpStr.empty()) { ilabels.push_back("Server IP:"); }
+						if (!serverPortStr.empty()) { ilabels.push_back("Server Port:"); }
+						if (!durationStr.empty()) { ilabels.push_back("Duration:"); }
+						if (!placeStatsStr.empty()) { ilabels.push_back("Place Totals:"); }
 						float mx = 0.0f;
 						for (const char *lbl : ilabels) { mx = (std::max)(mx, CalcTextSize(lbl).x); }
 						instLabelWidth = (std::max)(instLabelWidth, mx + GetFontSize() + GetFontSize());
@@ -399,8 +482,26 @@ static void DisplayLogDetails(const LogInfo &logInfo) {
 					TableSetupColumn("##field", ImGuiTableColumnFlags_WidthFixed, instLabelWidth);
 					TableSetupColumn("##value", ImGuiTableColumnFlags_WidthStretch);
 
+					// Game
+					if (!gameNameStr.empty()) {
+						TableNextRow();
+						TableSetColumnIndex(0);
+						TextUnformatted("Game:");
+
+						TableSetColumnIndex(1);
+						PushID("GameName");
+						Indent(10.0f);
+						TextWrapped("%s", gameNameStr.c_str());
+						Unindent(10.0f);
+						if (BeginPopupContextItem("CopyGameName")) {
+							if (MenuItem("Copy")) { SetClipboardText(gameNameStr.c_str()); }
+							EndPopup();
+						}
+						PopID();
+					}
+
 					// Place ID
-					if (!session.placeId.empty()) {
+					if (!placeIdStr.empty()) {
 						TableNextRow();
 						TableSetColumnIndex(0);
 						TextUnformatted("Place ID:");
@@ -408,17 +509,17 @@ static void DisplayLogDetails(const LogInfo &logInfo) {
 						TableSetColumnIndex(1);
 						PushID("PlaceID");
 						Indent(10.0f); // Add padding before the value
-						TextWrapped("%s", session.placeId.c_str());
+						TextWrapped("%s", placeIdStr.c_str());
 						Unindent(10.0f);
 						if (BeginPopupContextItem("CopyPlaceID")) {
-							if (MenuItem("Copy")) { SetClipboardText(session.placeId.c_str()); }
+							if (MenuItem("Copy")) { SetClipboardText(placeIdStr.c_str()); }
 							EndPopup();
 						}
 						PopID();
 					}
 
 					// Job ID
-					if (!session.jobId.empty()) {
+					if (!jobIdStr.empty()) {
 						TableNextRow();
 						TableSetColumnIndex(0);
 						TextUnformatted("Job ID:");
@@ -426,17 +527,17 @@ static void DisplayLogDetails(const LogInfo &logInfo) {
 						TableSetColumnIndex(1);
 						PushID("JobID");
 						Indent(10.0f); // Add padding before the value
-						TextWrapped("%s", session.jobId.c_str());
+						TextWrapped("%s", jobIdStr.c_str());
 						Unindent(10.0f);
 						if (BeginPopupContextItem("CopyJobID")) {
-							if (MenuItem("Copy")) { SetClipboardText(session.jobId.c_str()); }
+							if (MenuItem("Copy")) { SetClipboardText(jobIdStr.c_str()); }
 							EndPopup();
 						}
 						PopID();
 					}
 
 					// Universe ID
-					if (!session.universeId.empty()) {
+					if (!universeIdStr.empty()) {
 						TableNextRow();
 						TableSetColumnIndex(0);
 						TextUnformatted("Universe ID:");
@@ -444,17 +545,17 @@ static void DisplayLogDetails(const LogInfo &logInfo) {
 						TableSetColumnIndex(1);
 						PushID("UniverseID");
 						Indent(10.0f); // Add padding before the value
-						TextWrapped("%s", session.universeId.c_str());
+						TextWrapped("%s", universeIdStr.c_str());
 						Unindent(10.0f);
 						if (BeginPopupContextItem("CopyUniverseID")) {
-							if (MenuItem("Copy")) { SetClipboardText(session.universeId.c_str()); }
+							if (MenuItem("Copy")) { SetClipboardText(universeIdStr.c_str()); }
 							EndPopup();
 						}
 						PopID();
 					}
 
 					// Server IP
-					if (!session.serverIp.empty()) {
+					if (!serverIpStr.empty()) {
 						TableNextRow();
 						TableSetColumnIndex(0);
 						TextUnformatted("Server IP:");
@@ -462,17 +563,17 @@ static void DisplayLogDetails(const LogInfo &logInfo) {
 						TableSetColumnIndex(1);
 						PushID("ServerIP");
 						Indent(10.0f);
-						TextWrapped("%s", session.serverIp.c_str());
+						TextWrapped("%s", serverIpStr.c_str());
 						Unindent(10.0f);
 						if (BeginPopupContextItem("CopyServerIP")) {
-							if (MenuItem("Copy")) { SetClipboardText(session.serverIp.c_str()); }
+							if (MenuItem("Copy")) { SetClipboardText(serverIpStr.c_str()); }
 							EndPopup();
 						}
 						PopID();
 					}
 
 					// Server Port
-					if (!session.serverPort.empty()) {
+					if (!serverPortStr.empty()) {
 						TableNextRow();
 						TableSetColumnIndex(0);
 						TextUnformatted("Server Port:");
@@ -480,27 +581,48 @@ static void DisplayLogDetails(const LogInfo &logInfo) {
 						TableSetColumnIndex(1);
 						PushID("ServerPort");
 						Indent(10.0f);
-						TextWrapped("%s", session.serverPort.c_str());
+						TextWrapped("%s", serverPortStr.c_str());
 						Unindent(10.0f);
 						if (BeginPopupContextItem("CopyServerPort")) {
-							if (MenuItem("Copy")) { SetClipboardText(session.serverPort.c_str()); }
+							if (MenuItem("Copy")) { SetClipboardText(serverPortStr.c_str()); }
 							EndPopup();
 						}
 						PopID();
 					}
 
+					// Duration, until the next join or the end of the log
+					if (!durationStr.empty()) {
+						TableNextRow();
+						TableSetColumnIndex(0);
+						TextUnformatted("Duration:");
+
+						TableSetColumnIndex(1);
+						Indent(10.0f);
+						TextWrapped("%s", durationStr.c_str());
+						Unindent(10.0f);
+					}
+
+					// Totals for this place across every log
+					if (!placeStatsStr.empty()) {
+						TableNextRow();
+						TableSetColumnIndex(0);
+						TextUnformatted("Place Totals:");
+
+						TableSetColumnIndex(1);
+						Indent(10.0f);
+						TextWrapped("%s", placeStatsStr.c_str());
+						Unindent(10.0f);
+					}
+
 					EndTable();
 				}
 
 				// Launch button for this specific instance
-				bool canLaunch = !session.placeId.empty() && !session.jobId.empty() && !g_selectedAccountIds.empty();
+				bool canLaunch = session.placeId != 0 && !session.jobId.empty() && !g_selectedAccountIds.empty();
 				if (canLaunch) {
 					Spacing();
 					if (Button((string(ICON_JOIN) + " Launch Instance##" + to_string(i)).c_str())) {
-						uint64_t place_id_val = 0;
-						try {
-							place_id_val = stoull(session.placeId);
-						} catch (...) {}
+						uint64_t place_id_val = session.placeId;
 
 						if (place_id_val > 0) {
 							vector<Roblox::HBA::AuthCredentials> accounts;
@@ -514,7 +636,7 @@ static void DisplayLogDetails(const LogInfo &logInfo) {
 							}
 							if (!accounts.empty()) {
 								LOG_INFO("Launching game instance from history...");
-								thread([place_id_val, jobId = session.jobId, accounts]() {
+								thread([place_id_val, jobId = jobIdStr, accounts]() {
 									launchRobloxSequential(place_id_val, jobId, accounts);
 								}).detach();
 							} else {
@@ -530,17 +652,11 @@ static void DisplayLogDetails(const LogInfo &logInfo) {
 							("LaunchButtonCtx##" + to_string(i)).c_str(),
 							ImGuiPopupFlags_MouseButtonRight
 						)) {
-						uint64_t pid = 0;
-						try {
-							pid = stoull(session.placeId);
-						} catch (...) { pid = 0; }
+						uint64_t pid = session.placeId;
 						StandardJoinMenuParams menu {};
 						menu.placeId = pid;
-						// universeId is a string in logs; try to parse
-						try {
-							menu.universeId = session.universeId.empty() ? 0ULL : stoull(session.universeId);
-						} catch (...) { menu.universeId = 0; }
-						menu.jobId = session.jobId;
+						menu.universeId = session.universeId;
+						menu.jobId = jobIdStr;
 						menu.onLaunchGame = [pid]() {
 							if (pid == 0 || g_selectedAccountIds.empty()) { return; }
 							vector<Roblox::HBA::AuthCredentials> accounts;
@@ -556,7 +672,7 @@ static void DisplayLogDetails(const LogInfo &logInfo) {
 								thread([pid, accounts]() { launchRobloxSequential(pid, "", accounts); }).detach();
 							}
 						};
-						menu.onLaunchInstance = [pid, jid = session.jobId]() {
+						menu.onLaunchInstance = [pid, jid = jobIdStr]() {
 							if (pid == 0 || jid.empty() || g_selectedAccountIds.empty()) { return; }
 							vector<Roblox::HBA::AuthCredentials> accounts;
 							for (int id : g_selectedAccountIds) {
@@ -574,7 +690,7 @@ static void DisplayLogDetails(const LogInfo &logInfo) {
 						menu.onFillGame = [pid]() {
 							if (pid) { FillJoinOptions(pid, ""); }
 						};
-						menu.onFillInstance = [pid, jid = session.jobId]() {
+						menu.onFillInstance = [pid, jid = jobIdStr]() {
 							if (pid) { FillJoinOptions(pid, jid); }
 						};
 						RenderStandardJoinMenu(menu);
@@ -662,13 +778,13 @@ void RenderHistoryTab() {
 	BeginChild("##HistoryList", ImVec2(listWidth, 0), true);
 	{
 		lock_guard<mutex> lk(g_logs_mtx);
-		string lastDay;
+		int64_t lastDayIndex = -1;
 		string lastVersion;
 		bool indented = false;
 
 		// Determine which logs to display - all or filtered
 		const vector<int> &indices = g_search_active ? g_filtered_log_indices : vector<int>();
-		int numLogsToDisplay = g_search_active ? indices.size() : g_logs.size();
+		int numLogsToDisplay = g_search_active ? indices.size() : g_history.logs.size();
 
 		// Helper to get the log index based on whether we're filtering or not
 		auto getLogIndex = [&](int i) -> int { return g_search_active ? indices[i] : i; };
@@ -679,22 +795,24 @@ void RenderHistoryTab() {
 			g_should_scroll_to_selection = false;
 		}
 
-		for (int i = 0; i < numLogsToDisplay; ++i) {
+		// Logs are stored oldest first; show the newest at the top
+		for (int i = numLogsToDisplay - 1; i >= 0; --i) {
 			int logIndex = getLogIndex(i);
-			const auto &logInfo = g_logs[logIndex];
+			const auto &logInfo = g_history.logs[logIndex];
 
 			// Skip installer logs
 			if (logInfo.isInstallerLog) { continue; }
 
-			string thisDay = logInfo.timestamp.size() >= 10 ? logInfo.timestamp.substr(0, 10) : "Unknown";
+			// Compare UTC day numbers and only format the header text when it changes
+			int64_t thisDayIndex = logInfo.timestampMs > 0 ? logInfo.timestampMs / 86400000LL : 0;
 
-			if (thisDay != lastDay) {
+			if (thisDayIndex != lastDayIndex) {
 				if (indented) { Unindent(); }
-				string header = thisDay;
+				string header = logDayLabel(logInfo);
 				SeparatorText(header.c_str());
 				Indent(); // Back to default indentation
 				indented = true;
-				lastDay = thisDay;
+				lastDayIndex = thisDayIndex;
 			}
 
 			PushID(logIndex);
@@ -728,8 +846,8 @@ void RenderHistoryTab() {
 	PopStyleVar();
 	if (g_selected_log_idx >= 0) {
 		lock_guard<mutex> lk(g_logs_mtx);
-		if (g_selected_log_idx < static_cast<int>(g_logs.size())) {
-			const auto &logInfo = g_logs[g_selected_log_idx];
+		if (g_selected_log_idx < static_cast<int>(g_history.logs.size())) {
+			const auto &logInfo = g_history.logs[g_selected_log_idx];
 
 			// Calculate space for buttons at bottom
 			float contentHeight = GetContentRegionAvail().y;
@@ -738,7 +856,7 @@ void RenderHistoryTab() {
 
 			// Details panel in a child window
 			BeginChild("##DetailsContent", ImVec2(0, detailsHeight), false);
-			DisplayLogDetails(logInfo);
+			DisplayLogDetails(g_history, g_history_stats, logInfo);
 			EndChild();
 
 			Separator();
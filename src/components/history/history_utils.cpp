@@ -1,25 +1,54 @@
 #define _CRT_SECURE_NO_WARNINGS
+#include <cstdio>
 #include <ctime>
-#include <iomanip>
-#include <sstream>
 #include <string>
 
 #include "core/time_utils.h"
 #include "history_utils.h"
 #include "log_types.h"
 
-std::string friendlyTimestamp(const std::string &isoTimestamp) {
-	if (isoTimestamp.empty()) { return isoTimestamp; }
-	return formatAbsoluteFromIso(isoTimestamp);
+std::string friendlyTimestamp(int64_t timestampMs) {
+	if (timestampMs == 0) { return {}; }
+	return formatAbsoluteLocal(static_cast<time_t>(timestampMs / 1000));
 }
 
 std::string niceLabel(const LogInfo &logInfo) {
-	if (logInfo.timestamp.size() >= 19) {
-		time_t t = parseIsoTimestamp(logInfo.timestamp);
-		if (t != static_cast<time_t>(-1) && t != 0) {
-			// For list entries, show time-only as date headers already separate days
-			return formatTimeOnlyLocal(t);
-		}
+	if (logInfo.timestampMs != 0) {
+		// For list entries, show time-only as date headers already separate days
+		return formatTimeOnlyLocal(static_cast<time_t>(logInfo.timestampMs / 1000));
 	}
 	return logInfo.fileName;
 }
+
+std::string logDayLabel(const LogInfo &logInfo) {
+	if (logInfo.timestampMs == 0) { return "Unknown"; }
+	time_t t = static_cast<time_t>(logInfo.timestampMs / 1000);
+	std::tm utcTm {};
+#if defined(_WIN32)
+	gmtime_s(&utcTm, &t);
+#else
+	gmtime_r(&t, &utcTm);
+#endif
+	char buffer[32];
+	std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d", utcTm.tm_year + 1900, utcTm.tm_mon + 1, utcTm.tm_mday);
+	return buffer;
+}
+
+std::string formatPlayTime(int64_t durationMs) {
+	int64_t seconds = durationMs > 0 ? durationMs / 1000 : 0;
+	char buffer[32];
+	if (seconds >= 3600) {
+		std::snprintf(
+			buffer,
+			sizeof(buffer),
+			"%lldh %02lldm",
+			static_cast<long long>(seconds / 3600),
+			static_cast<long long>(seconds / 60 % 60)
+		);
+	} else if (seconds >= 60) {
+		std::snprintf(buffer, sizeof(buffer), "%lldm", static_cast<long long>(seconds / 60));
+	} else {
+		std::snprintf(buffer, sizeof(buffer), "%llds", static_cast<long long>(seconds));
+	}
+	return buffer;
+}
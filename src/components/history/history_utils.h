@@ -1,8 +1,15 @@
 #pragma once
 
 #include "log_types.h"
+#include <cstdint>
 #include <string>
 
-std::string friendlyTimestamp(const std::string &isoTimestamp);
+std::string friendlyTimestamp(int64_t timestampMs);
 
 std::string niceLabel(const LogInfo &logInfo);
+
+// UTC calendar day of a log ("YYYY-MM-DD"), used for the list's date headers
+std::string logDayLabel(const LogInfo &logInfo);
+
+// Compact play-time text ("2h 05m", "12m", "45s")
+std::string formatPlayTime(int64_t durationMs);
@@ -1,19 +1,19 @@
 #define _CRT_SECURE_NO_WARNINGS
 #include <algorithm>
 #include <cctype>
+#include <charconv>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
-#include <regex>
 #include <string>
 #include <string_view>
+#include <system_error>
 #include <vector>
 
+#include "core/time_utils.h"
 #include "log_parser.h"
 
 namespace fs = std::filesystem;
-using std::regex;
-using std::regex_match;
 using std::string;
 using std::string_view;
 using std::vector;
@@ -23,227 +23,235 @@ string logsFolder() {
 	return localAppDataPath ? string(localAppDataPath) + "\\Roblox\\logs" : string {};
 }
 
-void parseLogFile(LogInfo &logInfo) {
-	using namespace std::string_view_literals;
-
-	// Skip installer logs - they contain "RobloxPlayerInstaller" in the filename
-	if (logInfo.fileName.find("RobloxPlayerInstaller") != string::npos) {
-		logInfo.isInstallerLog = true;
-		return;
-	}
-
-	constexpr size_t kMaxRead = 512 * 1024; // halfMB
-	std::ifstream fileInputStream(logInfo.fullPath, std::ios::binary);
-	if (!fileInputStream) { return; }
-
-	string fileBuffer(kMaxRead, '\0');
-	fileInputStream.read(fileBuffer.data(), kMaxRead);
-	fileBuffer.resize(static_cast<size_t>(fileInputStream.gcount()));
-	string_view log_data_view(fileBuffer);
+static uint32_t sessionDuration(const GameSession &session, int64_t untilMs) {
+	if (session.timestampMs == 0 || untilMs <= session.timestampMs) { return 0; }
+	return static_cast<uint32_t>((std::min<int64_t>)(untilMs - session.timestampMs, UINT32_MAX));
+}
 
-	auto nextLinePos = [&log_data_view](size_t currentPosition) -> size_t {
-		size_t newlinePosition = log_data_view.find('\n', currentPosition);
-		return newlinePosition == string_view::npos ? log_data_view.size() : newlinePosition;
-	};
+// Reads the run of decimal digits starting at valueStartIndex; returns 0 if there is none
+static uint64_t parseDigitsAt(string_view lineView, size_t valueStartIndex) {
+	if (valueStartIndex >= lineView.size()) { return 0; }
+	uint64_t value = 0;
+	std::from_chars(lineView.data() + valueStartIndex, lineView.data() + lineView.size(), value);
+	return value;
+}
 
-	// Track the current game session we're building
-	GameSession *currentSession = nullptr;
-	string currentTimestamp;
+void LogLineParser::feedLine(string_view line) {
+	using namespace std::string_view_literals;
 
-	for (size_t currentScanPosition = 0; currentScanPosition < log_data_view.size();) {
-		size_t endOfLineIndex = nextLinePos(currentScanPosition);
-		string_view currentLineView = log_data_view.substr(currentScanPosition, endOfLineIndex - currentScanPosition);
+	if (!line.empty() && line.back() == '\r') { line.remove_suffix(1); }
 
-		if (!currentLineView.empty() && currentLineView.back() == '\r') { currentLineView.remove_suffix(1); }
+	// Track timestamps for all lines to associate with sessions
+	if (line.length() >= 20 && std::isdigit(static_cast<unsigned char>(line[0]))) {
+		size_t timestampZIndex = line.find('Z');
+		if (timestampZIndex != string_view::npos && timestampZIndex < 30) {
+			// Found a timestamp line
+			int64_t parsedMs = parseIsoTimestampMillis(line.substr(0, timestampZIndex + 1));
+			if (parsedMs != 0) {
+				m_currentTimestampMs = parsedMs;
 
-		// Track timestamps for all lines to associate with sessions
-		if (currentLineView.length() >= 20 && !currentLineView.empty() && std::isdigit(currentLineView[0])) {
-			size_t timestampZIndex = currentLineView.find('Z');
-			if (timestampZIndex != string_view::npos && timestampZIndex < 30) {
-				// Found a timestamp line
-				currentTimestamp = string(currentLineView.substr(0, timestampZIndex + 1));
+				// The open session lasts at least until the latest line
+				if (!m_sessions.empty()) {
+					m_sessions.back().durationMs = sessionDuration(m_sessions.back(), parsedMs);
+				}
 
 				// Set the initial timestamp for the log if it's not set yet
-				if (logInfo.timestamp.empty()) { logInfo.timestamp = currentTimestamp; }
+				if (m_timestampMs == 0) { m_timestampMs = m_currentTimestampMs; }
 			}
 		}
+	}
 
-		// Still collect output lines for compatibility with data saving/loading
-		if (currentLineView.find("[FLog::Output]"sv) != string_view::npos) {
-			logInfo.outputLines.emplace_back(currentLineView);
-		}
+	// Output lines go into the shared arena instead of one allocation each
+	if (m_outputSink != nullptr && line.find("[FLog::Output]"sv) != string_view::npos) {
+		m_outputSink->outputLines.push_back({m_outputSink->outputArena.size(), static_cast<uint32_t>(line.size())});
+		m_outputSink->outputArena.append(line);
+	}
 
-		if (logInfo.channel.empty()) {
-			constexpr auto channelToken = "The channel is "sv;
-			auto channelTokenIndex = currentLineView.find(channelToken);
-			if (channelTokenIndex != string_view::npos) {
-				size_t valueStartIndex = channelTokenIndex + channelToken.length();
-				auto valueEndIndex = currentLineView.find_first_of(" \t\n\r"sv, valueStartIndex);
-				logInfo.channel = string(currentLineView.substr(
-					valueStartIndex,
-					(valueEndIndex == string_view::npos ? currentLineView.length() : valueEndIndex) - valueStartIndex
-				));
-			}
+	if (m_channel.empty()) {
+		constexpr auto channelToken = "The channel is "sv;
+		auto channelTokenIndex = line.find(channelToken);
+		if (channelTokenIndex != string_view::npos) {
+			size_t valueStartIndex = channelTokenIndex + channelToken.length();
+			auto valueEndIndex = line.find_first_of(" \t\n\r"sv, valueStartIndex);
+			m_channel = string(line.substr(
+				valueStartIndex,
+				(valueEndIndex == string_view::npos ? line.length() : valueEndIndex) - valueStartIndex
+			));
 		}
+	}
 
-		if (logInfo.version.empty()) {
-			constexpr auto versionToken = "\"version\":\""sv;
-			auto versionTokenIndex = currentLineView.find(versionToken);
-			if (versionTokenIndex != string_view::npos) {
-				size_t valueStartIndex = versionTokenIndex + versionToken.length();
-				auto valueEndIndex = currentLineView.find('"', valueStartIndex);
-				if (valueEndIndex != string_view::npos) {
-					logInfo.version = string(currentLineView.substr(valueStartIndex, valueEndIndex - valueStartIndex));
-				}
+	if (m_version.empty()) {
+		constexpr auto versionToken = "\"version\":\""sv;
+		auto versionTokenIndex = line.find(versionToken);
+		if (versionTokenIndex != string_view::npos) {
+			size_t valueStartIndex = versionTokenIndex + versionToken.length();
+			auto valueEndIndex = line.find('"', valueStartIndex);
+			if (valueEndIndex != string_view::npos) {
+				m_version = string(line.substr(valueStartIndex, valueEndIndex - valueStartIndex));
 			}
 		}
+	}
 
-		if (logInfo.joinTime.empty()) {
-			constexpr auto joinTimeToken = "join_time:"sv;
-			auto joinTimeTokenIndex = currentLineView.find(joinTimeToken);
-			if (joinTimeTokenIndex != string_view::npos) {
-				size_t valueStartIndex = joinTimeTokenIndex + joinTimeToken.length();
-				auto valueEndIndex = currentLineView.find_first_not_of("0123456789."sv, valueStartIndex);
-				logInfo.joinTime = string(currentLineView.substr(
-					valueStartIndex,
-					(valueEndIndex == string_view::npos ? currentLineView.length() : valueEndIndex) - valueStartIndex
-				));
+	// Detect new game session by job ID
+	constexpr auto jobIdToken = "Joining game '"sv;
+	auto jobIdTokenIndex = line.find(jobIdToken);
+	if (jobIdTokenIndex != string_view::npos) {
+		size_t valueStartIndex = jobIdTokenIndex + jobIdToken.length();
+		auto valueEndIndex = line.find('\'', valueStartIndex); // Find closing quote
+		if (valueEndIndex != string_view::npos) {
+			string_view guidCandidateView
+				= line.substr(valueStartIndex, valueEndIndex - valueStartIndex);
+
+			JobGuid jobId;
+			if (parseJobGuid(guidCandidateView, jobId)) {
+				// Found a new game session
+				GameSession newSession;
+				newSession.timestampMs = m_currentTimestampMs;
+				newSession.jobId = jobId;
+
+				m_sessions.push_back(newSession);
 			}
 		}
+	}
 
-		// Detect new game session by job ID
-		static const regex s_guid_regex(R"([0-9a-fA-F]{8}-(?:[0-9a-fA-F]{4}-){3}[0-9a-fA-F]{12})");
-		constexpr auto jobIdToken = "Joining game '"sv;
-		auto jobIdTokenIndex = currentLineView.find(jobIdToken);
-		if (jobIdTokenIndex != string_view::npos) {
-			size_t valueStartIndex = jobIdTokenIndex + jobIdToken.length();
-			auto valueEndIndex = currentLineView.find('\'', valueStartIndex); // Find closing quote
-			if (valueEndIndex != string_view::npos) {
-				string_view guidCandidateView
-					= currentLineView.substr(valueStartIndex, valueEndIndex - valueStartIndex);
+	// Look for place ID
+	constexpr auto placeToken = "place "sv;
+	auto placeTokenIndex = line.find(placeToken);
+	if (placeTokenIndex != string_view::npos && !m_sessions.empty()) {
+		uint64_t placeId = parseDigitsAt(line, placeTokenIndex + placeToken.length());
+		if (placeId != 0) { m_sessions.back().placeId = placeId; }
+	}
 
-				string jobId;
-				if (regex_match(guidCandidateView.begin(), guidCandidateView.end(), s_guid_regex)) {
-					jobId = string(guidCandidateView);
+	// Look for universe ID
+	constexpr auto universeToken = "universeid:"sv;
+	auto universeTokenIndex = line.find(universeToken);
+	if (universeTokenIndex != string_view::npos && !m_sessions.empty()) {
+		uint64_t universeId = parseDigitsAt(line, universeTokenIndex + universeToken.length());
+		if (universeId != 0) { m_sessions.back().universeId = universeId; }
+	}
 
-					// Found a new game session
-					GameSession newSession;
-					newSession.timestamp = currentTimestamp;
-					newSession.jobId = jobId;
+	// Look for server information
+	constexpr auto serverToken = "UDMUX Address = "sv;
+	auto serverTokenIndex = line.find(serverToken);
+	if (serverTokenIndex != string_view::npos && !m_sessions.empty()) {
+		size_t valueStartIndex = serverTokenIndex + serverToken.length();
+		constexpr auto portPrefixToken = ", Port = "sv;
+		auto valueEndIndex = line.find(portPrefixToken, valueStartIndex);
+		if (valueEndIndex != string_view::npos) {
+			uint32_t ip = 0;
+			uint64_t port = parseDigitsAt(line, valueEndIndex + portPrefixToken.length());
+			if (parseIpv4(line.substr(valueStartIndex, valueEndIndex - valueStartIndex), ip) && port != 0
+				&& port <= 0xFFFF) {
+				m_sessions.back().serverIp = ip;
+				m_sessions.back().serverPort = static_cast<uint16_t>(port);
+			}
+		}
+	}
 
-					// Add this new session
-					logInfo.sessions.push_back(newSession);
-					currentSession = &logInfo.sessions.back();
+	if (m_userId == 0) {
+		constexpr auto userIdToken = "userId = "sv;
+		auto userIdTokenIndex = line.find(userIdToken);
+		if (userIdTokenIndex != string_view::npos) {
+			m_userId = parseDigitsAt(line, userIdTokenIndex + userIdToken.length());
+		}
+	}
+}
 
-					// For backward compatibility
-					if (logInfo.jobId.empty()) { logInfo.jobId = jobId; }
-				}
-			}
+size_t LogLineParser::feed(string_view data, bool final) {
+	size_t currentScanPosition = 0;
+	while (currentScanPosition < data.size()) {
+		size_t endOfLineIndex = data.find('\n', currentScanPosition);
+		if (endOfLineIndex == string_view::npos) {
+			if (!final) { break; }
+			endOfLineIndex = data.size();
 		}
+		feedLine(data.substr(currentScanPosition, endOfLineIndex - currentScanPosition));
+		currentScanPosition = (std::min)(endOfLineIndex + 1, data.size());
+	}
+	return currentScanPosition;
+}
 
-		// Look for place ID
-		constexpr auto placeToken = "place "sv;
-		auto placeTokenIndex = currentLineView.find(placeToken);
-		if (placeTokenIndex != string_view::npos && currentSession != nullptr) {
-			size_t valueStartIndex = placeTokenIndex + placeToken.length();
-			auto valueEndIndex = currentLineView.find_first_not_of("0123456789"sv, valueStartIndex);
-			string placeId = string(currentLineView.substr(
-				valueStartIndex,
-				(valueEndIndex == string_view::npos ? currentLineView.length() : valueEndIndex) - valueStartIndex
-			));
+void LogLineParser::reset() {
+	m_timestampMs = 0;
+	m_currentTimestampMs = 0;
+	m_version.clear();
+	m_channel.clear();
+	m_userId = 0;
+	m_sessions.clear();
+}
 
-			// If we have a current session, associate this place ID with it
-			if (!placeId.empty()) {
-				currentSession->placeId = placeId;
+void parseLogFile(LogInfo &logInfo, HistoryStore &store) {
+	// Point the ranges at the end of the store first, so a log that is skipped or cannot be read owns no rows and
+	// discarding it leaves earlier logs alone
+	logInfo.firstSession = static_cast<uint32_t>(store.sessions.size());
+	logInfo.firstOutputLine = static_cast<uint32_t>(store.outputLines.size());
 
-				// For backward compatibility
-				if (logInfo.placeId.empty()) { logInfo.placeId = placeId; }
-			}
-		}
+	// Skip installer logs - they contain "RobloxPlayerInstaller" in the filename
+	if (isInstallerLogName(logInfo.fileName)) {
+		logInfo.isInstallerLog = true;
+		return;
+	}
 
-		// Look for universe ID
-		constexpr auto universeToken = "universeid:"sv;
-		auto universeTokenIndex = currentLineView.find(universeToken);
-		if (universeTokenIndex != string_view::npos && currentSession != nullptr) {
-			size_t valueStartIndex = universeTokenIndex + universeToken.length();
-			auto valueEndIndex = currentLineView.find_first_not_of("0123456789"sv, valueStartIndex);
-			string universeId = string(currentLineView.substr(
-				valueStartIndex,
-				(valueEndIndex == string_view::npos ? currentLineView.length() : valueEndIndex) - valueStartIndex
-			));
+	// The whole file is read, in chunks, so a full scan finds every session the live watcher has shown for it
+	constexpr size_t kReadChunk = 1024 * 1024;
+	std::ifstream fileInputStream(logInfo.fullPath, std::ios::binary);
+	if (!fileInputStream) { return; }
 
-			// If we have a current session, associate this universe ID with it
-			if (!universeId.empty()) {
-				currentSession->universeId = universeId;
+	LogLineParser parser(&store);
+	string fileBuffer;
+	for (;;) {
+		size_t carried = fileBuffer.size();
+		fileBuffer.resize(carried + kReadChunk);
+		fileInputStream.read(fileBuffer.data() + carried, static_cast<std::streamsize>(kReadChunk));
+		size_t got = static_cast<size_t>(fileInputStream.gcount());
+		fileBuffer.resize(carried + got);
+		if (got == 0) { break; }
+		fileBuffer.erase(0, parser.feed(fileBuffer, false));
+	}
+	parser.feed(fileBuffer, true);
 
-				// For backward compatibility
-				if (logInfo.universeId.empty()) { logInfo.universeId = universeId; }
-			}
-		}
+	logInfo.timestampMs = parser.timestampMs();
+	logInfo.versionId = store.strings.intern(parser.version());
+	logInfo.channelId = store.strings.intern(parser.channel());
+	logInfo.userId = parser.userId();
+	logInfo.outputLineCount = static_cast<uint32_t>(store.outputLines.size()) - logInfo.firstOutputLine;
 
-		// Look for server information
-		constexpr auto serverToken = "UDMUX Address = "sv;
-		auto serverTokenIndex = currentLineView.find(serverToken);
-		if (serverTokenIndex != string_view::npos && currentSession != nullptr) {
-			size_t valueStartIndex = serverTokenIndex + serverToken.length();
-			auto valueEndIndex = currentLineView.find(", Port = "sv, valueStartIndex);
-			if (valueEndIndex != string_view::npos) {
-				string ip = string(currentLineView.substr(valueStartIndex, valueEndIndex - valueStartIndex));
-
-				constexpr auto portPrefixToken = ", Port = "sv;
-				size_t portValueStartIndex = valueEndIndex + portPrefixToken.length();
-				auto portValueEndIndex = currentLineView.find_first_not_of("0123456789"sv, portValueStartIndex);
-				string port = string(currentLineView.substr(
-					portValueStartIndex,
-					(portValueEndIndex == string_view::npos ? currentLineView.length() : portValueEndIndex)
-						- portValueStartIndex
-				));
-
-				// If we have a current session, associate this server info with it
-				if (!ip.empty() && !port.empty()) {
-					currentSession->serverIp = ip;
-					currentSession->serverPort = port;
-
-					// For backward compatibility
-					if (logInfo.serverIp.empty()) {
-						logInfo.serverIp = ip;
-						logInfo.serverPort = port;
-					}
-				}
-			}
-		}
+	// Sessions are gathered as rows first so they can be sorted before landing in the columnar table
+	vector<GameSession> sessions = parser.sessions();
+	sortSessionsNewestFirst(sessions);
 
-		if (logInfo.userId.empty()) {
-			constexpr auto userIdToken = "userId = "sv;
-			auto userIdTokenIndex = currentLineView.find(userIdToken);
-			if (userIdTokenIndex != string_view::npos) {
-				size_t valueStartIndex = userIdTokenIndex + userIdToken.length();
-				auto valueEndIndex = currentLineView.find_first_not_of("0123456789"sv, valueStartIndex);
-				logInfo.userId = string(currentLineView.substr(
-					valueStartIndex,
-					(valueEndIndex == string_view::npos ? currentLineView.length() : valueEndIndex) - valueStartIndex
-				));
-			}
-		}
+	logInfo.sessionCount = static_cast<uint32_t>(sessions.size());
+	for (const auto &session : sessions) { store.sessions.push(session); }
+}
 
-		currentScanPosition = endOfLineIndex + 1;
+void scanLogFolder(const string &dir, HistoryStore &store) {
+	std::error_code ec;
+	if (dir.empty() || !fs::exists(dir, ec)) { return; }
+
+	for (const auto &entry : fs::directory_iterator(dir, ec)) {
+		if (!entry.is_regular_file(ec)) { continue; }
+		string fName = entry.path().filename().string();
+		if (fName.length() <= 4 || fName.compare(fName.length() - 4, 4, ".log") != 0) { continue; }
+
+		LogInfo logInfo;
+		logInfo.fileName = fName;
+		logInfo.fullPath = entry.path().string();
+		parseLogFile(logInfo, store);
+		if (logInfo.timestampMs != 0 || logInfo.versionId != 0) {
+			store.logs.push_back(std::move(logInfo));
+		} else {
+			store.discardParsed(logInfo);
+		}
 	}
 
-	// If we didn't find any sessions but have jobId/placeId from old parsing logic,
-	// create a synthetic session for backward compatibility
-	if (logInfo.sessions.empty() && (!logInfo.jobId.empty() || !logInfo.placeId.empty())) {
-		GameSession backwardCompatSession;
-		backwardCompatSession.timestamp = logInfo.timestamp;
-		backwardCompatSession.jobId = logInfo.jobId;
-		backwardCompatSession.placeId = logInfo.placeId;
-		backwardCompatSession.universeId = logInfo.universeId;
-		backwardCompatSession.serverIp = logInfo.serverIp;
-		backwardCompatSession.serverPort = logInfo.serverPort;
-		logInfo.sessions.push_back(backwardCompatSession);
-	}
+	store.sortLogsByTime();
+}
+
+bool isInstallerLogName(string_view fileName) { return fileName.find("RobloxPlayerInstaller") != string_view::npos; }
 
+void sortSessionsNewestFirst(vector<GameSession> &sessions) {
 	// Sort sessions in descending order of timestamps (newest first, oldest last)
-	std::sort(logInfo.sessions.begin(), logInfo.sessions.end(), [](const GameSession &a, const GameSession &b) {
-		return a.timestamp > b.timestamp;
+	std::stable_sort(sessions.begin(), sessions.end(), [](const GameSession &a, const GameSession &b) {
+		return a.timestampMs > b.timestampMs;
 	});
 }
@@ -1,8 +1,55 @@
 #pragma once
 
 #include "log_types.h"
+#include "session_store.h"
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <vector>
 
-void parseLogFile(LogInfo &logInfo);
+// Line-at-a-time Roblox log parser, shared by full folder scans and live tailing.
+class LogLineParser {
+	public:
+		// When outputSink is set, [FLog::Output] lines are copied into its arena
+		explicit LogLineParser(HistoryStore *outputSink = nullptr): m_outputSink(outputSink) {}
+
+		void feedLine(std::string_view line);
+
+		// Feeds every complete line of data and returns the bytes consumed; with final set, a trailing line
+		// without '\n' is consumed too
+		size_t feed(std::string_view data, bool final);
+
+		void reset();
+
+		int64_t timestampMs() const { return m_timestampMs; }
+
+		const std::string &version() const { return m_version; }
+
+		const std::string &channel() const { return m_channel; }
+
+		uint64_t userId() const { return m_userId; }
+
+		// Sessions in the order they were joined
+		const std::vector<GameSession> &sessions() const { return m_sessions; }
+
+	private:
+		HistoryStore *m_outputSink;
+		int64_t m_timestampMs = 0; // First timestamp seen
+		int64_t m_currentTimestampMs = 0; // Latest timestamp seen, stamped onto new sessions
+		std::string m_version;
+		std::string m_channel;
+		uint64_t m_userId = 0;
+		std::vector<GameSession> m_sessions;
+};
+
+// Parses logInfo.fullPath, appending its sessions and output lines to store
+void parseLogFile(LogInfo &logInfo, HistoryStore &store);
+
+// Parses every .log file in dir into store and sorts the logs oldest first
+void scanLogFolder(const std::string &dir, HistoryStore &store);
+
+bool isInstallerLogName(std::string_view fileName);
+
+void sortSessionsNewestFirst(std::vector<GameSession> &sessions);
 
 std::string logsFolder();
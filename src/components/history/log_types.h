@@ -1,38 +1,45 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
-#include <vector>
 
-// Structure for a single game session within a log
+// Binary form of a job GUID (xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx), high 64 bits first
+struct JobGuid {
+		uint64_t hi = 0;
+		uint64_t lo = 0;
+
+		bool empty() const { return hi == 0 && lo == 0; }
+
+		bool operator==(const JobGuid &other) const { return hi == other.hi && lo == other.lo; }
+};
+
+// A single game session within a log. Stored column-wise in SessionTable; this is the row view.
 struct GameSession {
-		std::string timestamp; // When this session started (ISO UTC)
-		std::string jobId; // Session-specific job ID
-		std::string placeId; // Place ID for this session
-		std::string universeId; // Universe ID for this session
-		std::string serverIp; // Server IP for this session
-		std::string serverPort; // Server port for this session
+		int64_t timestampMs = 0; // When this session started (UTC epoch milliseconds, 0 = unknown)
+		JobGuid jobId; // Session-specific job ID
+		uint64_t placeId = 0; // Place ID for this session
+		uint64_t universeId = 0; // Universe ID for this session
+		uint32_t serverIp = 0; // Server IPv4 address, host byte order
+		uint16_t serverPort = 0; // Server port for this session
+		uint32_t durationMs = 0; // Until the next join or the last line of the log
 };
 
 struct LogInfo {
 		std::string fileName;
 		std::string fullPath;
-		std::string timestamp; // First timestamp in log (ISO UTC)
-		std::string version; // Roblox client version
-		std::string channel; // Channel (production, etc.)
-		std::string userId; // User ID (same across sessions)
-		bool isInstallerLog; // Flag for installer logs that should be filtered
-
-		// Multiple game sessions within a single log file
-		std::vector<GameSession> sessions;
-
-		// For backward compatibility
-		std::string joinTime; // raw string (deprecated)
-		std::string jobId; // First job ID found (deprecated)
-		std::string placeId; // First place ID found (deprecated)
-		std::string universeId; // First universe ID found (deprecated)
-		std::string serverIp; // First server IP found (deprecated)
-		std::string serverPort; // First server port found (deprecated)
-		std::vector<std::string> outputLines; // captured [FLog::Output] lines
-
-		LogInfo(): isInstallerLog(false) {} // Initialize to false by default
+		int64_t timestampMs = 0; // First timestamp in log (UTC epoch milliseconds)
+		uint32_t versionId = 0; // Roblox client version, interned in HistoryStore::strings
+		uint32_t channelId = 0; // Channel (production, etc.), interned in HistoryStore::strings
+		uint64_t userId = 0; // User ID (same across sessions)
+		bool isInstallerLog = false; // Flag for installer logs that should be filtered
+
+		// Multiple game sessions within a single log file, rows [firstSession, firstSession + sessionCount)
+		// of HistoryStore::sessions, newest first
+		uint32_t firstSession = 0;
+		uint32_t sessionCount = 0;
+
+		// Captured [FLog::Output] lines, entries [firstOutputLine, firstOutputLine + outputLineCount)
+		// of HistoryStore::outputLines
+		uint32_t firstOutputLine = 0;
+		uint32_t outputLineCount = 0;
 };
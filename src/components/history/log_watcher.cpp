@@ -0,0 +1,299 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "core/logging.hpp"
+#include "log_parser.h"
+#include "log_watcher.h"
+
+#ifdef _WIN32
+#	include <windows.h>
+#endif
+
+namespace fs = std::filesystem;
+using std::string;
+using std::vector;
+using Clock = std::chrono::steady_clock;
+
+// Files that have not grown for this long are no longer tailed
+static constexpr auto kActiveWindow = std::chrono::minutes(15);
+// Polling fallback cadence for growth checks
+static constexpr auto kPollInterval = std::chrono::milliseconds(250);
+// Folder rescans for new files when change notifications are unavailable
+static constexpr auto kPollRescanInterval = std::chrono::seconds(2);
+// Safety net when change notifications are available, in case one is missed
+static constexpr auto kNativeRescanInterval = std::chrono::seconds(30);
+static constexpr size_t kMaxReadPerTick = 4 * 1024 * 1024;
+// The open session's duration grows with every timestamped line; on its own that is republished at most this often
+static constexpr auto kDurationRepublishInterval = std::chrono::minutes(1);
+
+struct TailedFile {
+		string fullPath;
+		uint64_t offset = 0;
+		string partial; // Bytes after the last complete line
+		LogLineParser parser;
+		Clock::time_point lastActivity {};
+		Clock::time_point lastPublish {};
+		bool durationPending = false; // A session's duration changed since the last publish
+};
+
+static std::mutex s_listenersMutex;
+static std::map<int, LogWatcher::Listener> s_listeners;
+static int s_nextListenerId = 1;
+
+static std::mutex s_latestMutex;
+static std::unordered_map<uint64_t, GameSession> s_latestByUser;
+
+static std::mutex s_controlMutex;
+static std::condition_variable s_wakeCv;
+static std::atomic_bool s_stop {false};
+static std::thread s_thread;
+#ifdef _WIN32
+static HANDLE s_stopEvent = nullptr;
+#endif
+
+// Durations are left out; they change with nearly every line and are republished on their own schedule
+static bool sameSession(const GameSession &a, const GameSession &b) {
+	return a.timestampMs == b.timestampMs && a.jobId == b.jobId && a.placeId == b.placeId
+		&& a.universeId == b.universeId && a.serverIp == b.serverIp && a.serverPort == b.serverPort;
+}
+
+static void publish(const string &fileName, TailedFile &file, vector<GameSession> changed) {
+	file.lastPublish = Clock::now();
+	file.durationPending = false;
+
+	LogWatcher::LogUpdate update;
+	update.fileName = fileName;
+	update.fullPath = file.fullPath;
+	update.timestampMs = file.parser.timestampMs();
+	update.version = file.parser.version();
+	update.channel = file.parser.channel();
+	update.userId = file.parser.userId();
+	update.sessions = file.parser.sessions();
+	sortSessionsNewestFirst(update.sessions);
+	update.changed = std::move(changed);
+
+	if (update.userId != 0 && !update.sessions.empty()) {
+		std::lock_guard<std::mutex> lock(s_latestMutex);
+		auto &latest = s_latestByUser[update.userId];
+		if (update.sessions.front().timestampMs >= latest.timestampMs) { latest = update.sessions.front(); }
+	}
+
+	vector<LogWatcher::Listener> listeners;
+	{
+		std::lock_guard<std::mutex> lock(s_listenersMutex);
+		for (const auto &[id, listener] : s_listeners) { listeners.push_back(listener); }
+	}
+	for (const auto &listener : listeners) { listener(update); }
+}
+
+// Reads whatever was appended since the last poll and parses only those bytes
+static void readAppended(const string &fileName, TailedFile &file) {
+	std::error_code ec;
+	uint64_t size = fs::file_size(file.fullPath, ec);
+	if (ec) { return; }
+
+	if (size < file.offset) {
+		// Truncated or replaced; start over
+		file.parser.reset();
+		file.partial.clear();
+		file.offset = 0;
+	}
+	if (size == file.offset) { return; }
+
+	std::ifstream in(file.fullPath, std::ios::binary);
+	if (!in) { return; }
+	in.seekg(static_cast<std::streamoff>(file.offset));
+
+	size_t toRead = static_cast<size_t>((std::min<uint64_t>)(size - file.offset, kMaxReadPerTick));
+	size_t carried = file.partial.size();
+	file.partial.resize(carried + toRead);
+	in.read(file.partial.data() + carried, static_cast<std::streamsize>(toRead));
+	size_t got = static_cast<size_t>(in.gcount());
+	file.partial.resize(carried + got);
+	file.offset += got;
+	if (got == 0) { return; }
+	file.lastActivity = Clock::now();
+
+	vector<GameSession> before = file.parser.sessions();
+	size_t consumed = file.parser.feed(file.partial, false);
+	file.partial.erase(0, consumed);
+
+	const auto &after = file.parser.sessions();
+	vector<GameSession> changed;
+	for (size_t i = 0; i < after.size(); ++i) {
+		if (i >= before.size() || !sameSession(before[i], after[i])) {
+			changed.push_back(after[i]);
+		} else if (before[i].durationMs != after[i].durationMs) {
+			file.durationPending = true;
+		}
+	}
+	if (!changed.empty()) { publish(fileName, file, std::move(changed)); }
+}
+
+static void pollFile(const string &fileName, TailedFile &file) {
+	readAppended(fileName, file);
+	if (file.durationPending && Clock::now() - file.lastPublish >= kDurationRepublishInterval) {
+		publish(fileName, file, {});
+	}
+}
+
+// Starts tailing logs that were written recently and drops ones that went quiet or disappeared
+static void scanFolder(const string &folder, std::unordered_map<string, TailedFile> &files) {
+	auto now = Clock::now();
+	std::error_code ec;
+	if (!fs::exists(folder, ec)) {
+		files.clear();
+		return;
+	}
+
+	auto fileNow = fs::file_time_type::clock::now();
+	for (const auto &entry : fs::directory_iterator(folder, ec)) {
+		if (!entry.is_regular_file(ec) || entry.path().extension() != ".log") { continue; }
+		string fileName = entry.path().filename().string();
+		if (isInstallerLogName(fileName) || files.count(fileName)) { continue; }
+
+		auto lastWrite = entry.last_write_time(ec);
+		if (ec || fileNow - lastWrite > kActiveWindow) { continue; }
+
+		TailedFile file;
+		file.fullPath = entry.path().string();
+		file.lastActivity = now;
+		files.emplace(std::move(fileName), std::move(file));
+	}
+
+	for (auto it = files.begin(); it != files.end();) {
+		if (now - it->second.lastActivity > kActiveWindow || !fs::exists(it->second.fullPath, ec)) {
+			// The log went quiet; its sessions' final durations go out before it stops being tailed
+			if (it->second.durationPending) { publish(it->first, it->second, {}); }
+			it = files.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+static void watchLoop(string folder) {
+	std::unordered_map<string, TailedFile> files;
+	bool rescan = true;
+	auto lastScan = Clock::now();
+
+#ifdef _WIN32
+	// One handle for new/renamed/deleted files (needs a rescan), one for writes (only tailed files need a look)
+	std::wstring widePath = fs::path(folder).wstring();
+	HANDLE nameHandle = FindFirstChangeNotificationW(widePath.c_str(), FALSE, FILE_NOTIFY_CHANGE_FILE_NAME);
+	HANDLE writeHandle = FindFirstChangeNotificationW(
+		widePath.c_str(),
+		FALSE,
+		FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE
+	);
+	bool native = nameHandle != INVALID_HANDLE_VALUE && writeHandle != INVALID_HANDLE_VALUE && s_stopEvent;
+	if (!native) { LOG_INFO("Log watcher: change notifications unavailable, falling back to polling"); }
+#else
+	bool native = false;
+#endif
+
+	while (!s_stop.load()) {
+		auto now = Clock::now();
+		if (rescan || now - lastScan >= (native ? kNativeRescanInterval : kPollRescanInterval)) {
+			scanFolder(folder, files);
+			lastScan = now;
+			rescan = false;
+		}
+		for (auto &[fileName, file] : files) { pollFile(fileName, file); }
+
+#ifdef _WIN32
+		if (native) {
+			// Growth is still checked every poll interval: NTFS may defer size updates for files held open
+			HANDLE handles[] = {s_stopEvent, nameHandle, writeHandle};
+			DWORD waitResult = WaitForMultipleObjects(
+				3,
+				handles,
+				FALSE,
+				static_cast<DWORD>(std::chrono::duration_cast<std::chrono::milliseconds>(kPollInterval).count())
+			);
+			if (waitResult == WAIT_OBJECT_0 + 1) {
+				rescan = true;
+				FindNextChangeNotification(nameHandle);
+			} else if (waitResult == WAIT_OBJECT_0 + 2) {
+				FindNextChangeNotification(writeHandle);
+			} else if (waitResult == WAIT_FAILED) {
+				native = false;
+			}
+			continue;
+		}
+#endif
+		std::unique_lock<std::mutex> lock(s_controlMutex);
+		s_wakeCv.wait_for(lock, kPollInterval, [] { return s_stop.load(); });
+	}
+
+#ifdef _WIN32
+	if (nameHandle != INVALID_HANDLE_VALUE) { FindCloseChangeNotification(nameHandle); }
+	if (writeHandle != INVALID_HANDLE_VALUE) { FindCloseChangeNotification(writeHandle); }
+#endif
+}
+
+namespace LogWatcher {
+	int Subscribe(Listener listener) {
+		std::lock_guard<std::mutex> lock(s_listenersMutex);
+		int id = s_nextListenerId++;
+		s_listeners.emplace(id, std::move(listener));
+		return id;
+	}
+
+	void Unsubscribe(int id) {
+		std::lock_guard<std::mutex> lock(s_listenersMutex);
+		s_listeners.erase(id);
+	}
+
+	void Start(const string &folder) {
+		std::lock_guard<std::mutex> lock(s_controlMutex);
+		if (folder.empty() || s_thread.joinable()) { return; }
+
+		s_stop = false;
+#ifdef _WIN32
+		s_stopEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+#endif
+		s_thread = std::thread(watchLoop, folder);
+		LOG_INFO("Watching Roblox logs for new sessions");
+	}
+
+	void Stop() {
+		{
+			std::lock_guard<std::mutex> lock(s_controlMutex);
+			if (!s_thread.joinable()) { return; }
+			s_stop = true;
+		}
+		s_wakeCv.notify_all();
+#ifdef _WIN32
+		if (s_stopEvent) { SetEvent(s_stopEvent); }
+#endif
+		s_thread.join();
+#ifdef _WIN32
+		if (s_stopEvent) {
+			CloseHandle(s_stopEvent);
+			s_stopEvent = nullptr;
+		}
+#endif
+	}
+
+	bool LatestSessionForUser(uint64_t userId, GameSession &out) {
+		std::lock_guard<std::mutex> lock(s_latestMutex);
+		auto it = s_latestByUser.find(userId);
+		if (it == s_latestByUser.end()) { return false; }
+		out = it->second;
+		return true;
+	}
+} // namespace LogWatcher
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "log_types.h"
+
+// Tails the Roblox logs that are currently being written and publishes their sessions as soon as new lines land,
+// so nothing has to wait for a full History refresh or poll the presence API to learn about a join.
+namespace LogWatcher {
+	struct LogUpdate {
+			std::string fileName;
+			std::string fullPath;
+			int64_t timestampMs = 0; // First timestamp in log (UTC epoch milliseconds)
+			std::string version;
+			std::string channel;
+			uint64_t userId = 0;
+			std::vector<GameSession> sessions; // Every session of the log so far, newest first
+			std::vector<GameSession> changed; // Sessions that started or gained details; empty when only durations grew
+	};
+
+	using Listener = std::function<void(const LogUpdate &)>;
+
+	// Listeners run on the watcher thread
+	int Subscribe(Listener listener);
+
+	void Unsubscribe(int id);
+
+	// Starts watching folder; uses directory change notifications where available and polling otherwise
+	void Start(const std::string &folder);
+
+	void Stop();
+
+	// Most recent session seen in a live log written by userId
+	bool LatestSessionForUser(uint64_t userId, GameSession &out);
+} // namespace LogWatcher
@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <initializer_list>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "search_index.h"
+
+using std::string;
+using std::string_view;
+using std::vector;
+
+static void appendField(string &arena, string_view value) {
+	if (value.empty()) { return; }
+	for (char c : value) { arena.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c)))); }
+	arena.push_back('\n');
+}
+
+static void appendNumber(string &arena, uint64_t value) {
+	if (value == 0) { return; }
+	char buffer[24];
+	auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+	arena.append(buffer, result.ptr);
+	arena.push_back('\n');
+}
+
+// Packs an n-gram (n = 2 or 3) into a map key; the top byte keeps bigrams and trigrams apart
+static uint32_t gramKey(string_view text, size_t pos, size_t n) {
+	uint32_t key = static_cast<uint32_t>(n) << 24;
+	for (size_t i = 0; i < n; ++i) {
+		key |= static_cast<uint32_t>(static_cast<unsigned char>(text[pos + i])) << (8 * (n - 1 - i));
+	}
+	return key;
+}
+
+// Distinct n-grams of text that do not straddle a field separator
+static void collectGrams(string_view text, size_t n, vector<uint32_t> &keys) {
+	if (text.size() < n) { return; }
+	for (size_t i = 0; i + n <= text.size(); ++i) {
+		if (text.substr(i, n).find('\n') != string_view::npos) { continue; }
+		keys.push_back(gramKey(text, i, n));
+	}
+}
+
+static vector<uint32_t> distinctGrams(string_view text, std::initializer_list<size_t> sizes) {
+	vector<uint32_t> keys;
+	keys.reserve(text.size() * sizes.size());
+	for (size_t n : sizes) { collectGrams(text, n, keys); }
+	std::sort(keys.begin(), keys.end());
+	keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+	return keys;
+}
+
+void LogSearchIndex::build(const HistoryStore &store) {
+	clear();
+	m_blobs.reserve(store.logs.size());
+	for (size_t i = 0; i < store.logs.size(); ++i) { update(store, i); }
+}
+
+void LogSearchIndex::update(const HistoryStore &store, size_t index) {
+	if (index > m_blobs.size() || index >= store.logs.size()) { return; }
+	bool reindex = index < m_blobs.size();
+	if (!reindex) { m_blobs.emplace_back(); }
+
+	// Re-indexed logs only ever gain sessions, so the postings they already have stay valid
+	const LogInfo &log = store.logs[index];
+	string text;
+	appendField(text, log.fileName);
+	appendField(text, log.fullPath);
+	appendField(text, store.version(log));
+	appendNumber(text, log.userId);
+	for (uint32_t i = 0; i < log.sessionCount; ++i) {
+		GameSession session = store.session(log, i);
+		appendNumber(text, session.placeId);
+		appendField(text, formatJobGuid(session.jobId));
+		appendNumber(text, session.universeId);
+		appendField(text, formatIpv4(session.serverIp));
+	}
+
+	Blob &blobInfo = m_blobs[index];
+	if (reindex && blobInfo.offset + blobInfo.length == m_arena.size()) {
+		// The old text is last in the arena, so the new one replaces it whatever its length
+		m_arena.resize(blobInfo.offset);
+		m_arena += text;
+	} else if (reindex && text.size() <= blobInfo.length) {
+		m_arena.replace(blobInfo.offset, text.size(), text);
+		m_abandonedBytes += blobInfo.length - text.size();
+	} else {
+		if (reindex) { m_abandonedBytes += blobInfo.length; }
+		blobInfo.offset = m_arena.size();
+		m_arena += text;
+	}
+	blobInfo.length = static_cast<uint32_t>(text.size());
+
+	if (m_abandonedBytes > kCompactMinBytes && m_abandonedBytes > m_arena.size() / 2) { compact(); }
+
+	addGrams(index);
+}
+
+void LogSearchIndex::compact() {
+	string arena;
+	arena.reserve(m_arena.size() - m_abandonedBytes);
+	for (size_t i = 0; i < m_blobs.size(); ++i) {
+		string_view text = blob(i);
+		m_blobs[i].offset = arena.size();
+		arena.append(text);
+	}
+	m_arena.swap(arena);
+	m_abandonedBytes = 0;
+}
+
+void LogSearchIndex::addGrams(size_t index) {
+	uint32_t logIndex = static_cast<uint32_t>(index);
+	for (uint32_t key : distinctGrams(blob(index), {2, 3})) {
+		auto &postings = m_grams[key];
+		if (postings.empty() || postings.back() < logIndex) {
+			postings.push_back(logIndex);
+			continue;
+		}
+		auto it = std::lower_bound(postings.begin(), postings.end(), logIndex);
+		if (it == postings.end() || *it != logIndex) { postings.insert(it, logIndex); }
+	}
+}
+
+void LogSearchIndex::query(string_view term, const vector<int> *narrowFrom, vector<int> &out) const {
+	out.clear();
+	if (term.empty()) { return; }
+
+	vector<uint32_t> candidates;
+	bool haveCandidates = false;
+
+	if (term.size() >= 2) {
+		vector<const vector<uint32_t> *> lists;
+		for (uint32_t key : distinctGrams(term, {term.size() >= 3 ? size_t(3) : size_t(2)})) {
+			auto it = m_grams.find(key);
+			if (it == m_grams.end()) { return; }
+			lists.push_back(&it->second);
+		}
+
+		// Intersect smallest-first so the working set shrinks as quickly as possible
+		std::sort(lists.begin(), lists.end(), [](const auto *a, const auto *b) { return a->size() < b->size(); });
+		if (!lists.empty()) {
+			candidates = *lists.front();
+			vector<uint32_t> scratch;
+			for (size_t i = 1; i < lists.size() && !candidates.empty(); ++i) {
+				scratch.clear();
+				std::set_intersection(
+					candidates.begin(),
+					candidates.end(),
+					lists[i]->begin(),
+					lists[i]->end(),
+					std::back_inserter(scratch)
+				);
+				candidates.swap(scratch);
+			}
+			haveCandidates = true;
+		}
+	}
+
+	if (narrowFrom) {
+		if (haveCandidates) {
+			vector<uint32_t> narrowed;
+			auto it = candidates.begin();
+			for (int idx : *narrowFrom) {
+				it = std::lower_bound(it, candidates.end(), static_cast<uint32_t>(idx));
+				if (it == candidates.end()) { break; }
+				if (*it == static_cast<uint32_t>(idx)) { narrowed.push_back(*it); }
+			}
+			candidates.swap(narrowed);
+		} else {
+			candidates.assign(narrowFrom->begin(), narrowFrom->end());
+		}
+	} else if (!haveCandidates) {
+		candidates.reserve(m_blobs.size());
+		for (uint32_t i = 0; i < m_blobs.size(); ++i) { candidates.push_back(i); }
+	}
+
+	// N-gram hits are only candidates; confirm the full term against the text
+	for (uint32_t idx : candidates) {
+		if (idx < m_blobs.size() && blob(idx).find(term) != string_view::npos) { out.push_back(static_cast<int>(idx)); }
+	}
+}
+
+void LogSearchIndex::clear() {
+	m_arena.clear();
+	m_blobs.clear();
+	m_grams.clear();
+	m_abandonedBytes = 0;
+}
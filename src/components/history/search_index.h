@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "session_store.h"
+
+// Lowercased per-log search text plus a bigram/trigram inverted index over it. Built off the UI thread when logs are
+// ingested so the History tab filter never has to format or lowercase anything per keystroke.
+class LogSearchIndex {
+	public:
+		// Indexes every log of store; log positions in the index match store.logs
+		void build(const HistoryStore &store);
+
+		// Re-indexes one log after its sessions changed (or appends it if index == size())
+		void update(const HistoryStore &store, size_t index);
+
+		/**
+		 * Finds logs whose searchable fields contain term
+		 * @param term Lowercased search term
+		 * @param narrowFrom Optional sorted candidate set (e.g. the previous results for a shorter term)
+		 * @param out Receives matching log indices in ascending order
+		 */
+		void query(std::string_view term, const std::vector<int> *narrowFrom, std::vector<int> &out) const;
+
+		size_t size() const { return m_blobs.size(); }
+
+		void clear();
+
+	private:
+		struct Blob {
+				uint64_t offset = 0;
+				uint32_t length = 0;
+		};
+
+		std::string_view blob(size_t index) const {
+			return std::string_view(m_arena).substr(m_blobs[index].offset, m_blobs[index].length);
+		}
+
+		// The arena is rewritten without abandoned text once that passes this size and half the arena
+		static constexpr size_t kCompactMinBytes = 1024 * 1024;
+
+		void addGrams(size_t index);
+
+		void compact();
+
+		std::string m_arena; // '\n'-separated lowercased fields of every log
+		size_t m_abandonedBytes = 0; // Arena bytes no blob refers to any more
+		std::vector<Blob> m_blobs;
+		std::unordered_map<uint32_t, std::vector<uint32_t>> m_grams; // 2/3-gram -> sorted log indices
+};
@@ -0,0 +1,193 @@
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+#include "session_store.h"
+
+using std::string;
+using std::string_view;
+
+uint32_t StringPool::intern(string_view value) {
+	if (value.empty()) { return 0; }
+	if (auto it = m_ids.find(value); it != m_ids.end()) { return it->second; }
+
+	uint32_t id = static_cast<uint32_t>(m_strings.size());
+	m_strings.emplace_back(value);
+	m_ids.emplace(m_strings.back(), id);
+	return id;
+}
+
+void StringPool::clear() {
+	m_strings.assign(1, string {});
+	m_ids.clear();
+}
+
+void SessionTable::push(const GameSession &session) {
+	timestampMs.push_back(session.timestampMs);
+	jobId.push_back(session.jobId);
+	placeId.push_back(session.placeId);
+	universeId.push_back(session.universeId);
+	serverIp.push_back(session.serverIp);
+	serverPort.push_back(session.serverPort);
+	durationMs.push_back(session.durationMs);
+}
+
+GameSession SessionTable::row(size_t index) const {
+	GameSession session;
+	if (index >= size()) { return session; }
+	session.timestampMs = timestampMs[index];
+	session.jobId = jobId[index];
+	session.placeId = placeId[index];
+	session.universeId = universeId[index];
+	session.serverIp = serverIp[index];
+	session.serverPort = serverPort[index];
+	session.durationMs = durationMs[index];
+	return session;
+}
+
+void SessionTable::reserve(size_t count) {
+	timestampMs.reserve(count);
+	jobId.reserve(count);
+	placeId.reserve(count);
+	universeId.reserve(count);
+	serverIp.reserve(count);
+	serverPort.reserve(count);
+	durationMs.reserve(count);
+}
+
+void SessionTable::truncate(size_t count) {
+	if (count >= size()) { return; }
+	timestampMs.resize(count);
+	jobId.resize(count);
+	placeId.resize(count);
+	universeId.resize(count);
+	serverIp.resize(count);
+	serverPort.resize(count);
+	durationMs.resize(count);
+}
+
+void SessionTable::clear() {
+	timestampMs.clear();
+	jobId.clear();
+	placeId.clear();
+	universeId.clear();
+	serverIp.clear();
+	serverPort.clear();
+	durationMs.clear();
+}
+
+string_view HistoryStore::outputLine(const LogInfo &log, uint32_t index) const {
+	if (index >= log.outputLineCount) { return {}; }
+	const TextSpan &span = outputLines[log.firstOutputLine + index];
+	return string_view(outputArena).substr(span.offset, span.length);
+}
+
+void HistoryStore::discardParsed(const LogInfo &log) {
+	sessions.truncate(log.firstSession);
+	if (log.firstOutputLine < outputLines.size()) {
+		outputArena.resize(outputLines[log.firstOutputLine].offset);
+		outputLines.resize(log.firstOutputLine);
+	}
+}
+
+void HistoryStore::sortLogsByTime() {
+	// Logs only reference session/output ranges, so reordering them leaves the columns untouched
+	std::stable_sort(logs.begin(), logs.end(), [](const LogInfo &a, const LogInfo &b) {
+		return a.timestampMs < b.timestampMs;
+	});
+}
+
+void HistoryStore::clear() {
+	logs.clear();
+	sessions.clear();
+	strings.clear();
+	outputArena.clear();
+	outputLines.clear();
+}
+
+static int hexValue(char c) {
+	if (c >= '0' && c <= '9') { return c - '0'; }
+	if (c >= 'a' && c <= 'f') { return c - 'a' + 10; }
+	if (c >= 'A' && c <= 'F') { return c - 'A' + 10; }
+	return -1;
+}
+
+bool parseJobGuid(string_view text, JobGuid &out) {
+	if (text.size() != 36 || text[8] != '-' || text[13] != '-' || text[18] != '-' || text[23] != '-') {
+		return false;
+	}
+
+	JobGuid guid;
+	int nibbles = 0;
+	for (char c : text) {
+		if (c == '-') { continue; }
+		int v = hexValue(c);
+		if (v < 0) { return false; }
+		uint64_t &half = nibbles < 16 ? guid.hi : guid.lo;
+		half = (half << 4) | static_cast<uint64_t>(v);
+		++nibbles;
+	}
+	if (nibbles != 32) { return false; }
+
+	out = guid;
+	return true;
+}
+
+string formatJobGuid(const JobGuid &guid) {
+	if (guid.empty()) { return {}; }
+	char buffer[37];
+	std::snprintf(
+		buffer,
+		sizeof(buffer),
+		"%08x-%04x-%04x-%04x-%012llx",
+		static_cast<unsigned>(guid.hi >> 32),
+		static_cast<unsigned>((guid.hi >> 16) & 0xFFFF),
+		static_cast<unsigned>(guid.hi & 0xFFFF),
+		static_cast<unsigned>(guid.lo >> 48),
+		static_cast<unsigned long long>(guid.lo & 0xFFFFFFFFFFFFULL)
+	);
+	return string(buffer, 36);
+}
+
+bool parseIpv4(string_view text, uint32_t &out) {
+	uint32_t address = 0;
+	int octets = 0;
+	size_t pos = 0;
+	while (octets < 4) {
+		if (pos >= text.size()) { return false; }
+		uint32_t value = 0;
+		size_t digits = 0;
+		while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9' && digits < 3) {
+			value = value * 10 + static_cast<uint32_t>(text[pos] - '0');
+			++pos;
+			++digits;
+		}
+		if (digits == 0 || value > 255) { return false; }
+		address = (address << 8) | value;
+		++octets;
+		if (octets < 4) {
+			if (pos >= text.size() || text[pos] != '.') { return false; }
+			++pos;
+		}
+	}
+	if (pos != text.size()) { return false; }
+
+	out = address;
+	return true;
+}
+
+string formatIpv4(uint32_t address) {
+	if (address == 0) { return {}; }
+	char buffer[16];
+	int len = std::snprintf(
+		buffer,
+		sizeof(buffer),
+		"%u.%u.%u.%u",
+		(address >> 24) & 0xFF,
+		(address >> 16) & 0xFF,
+		(address >> 8) & 0xFF,
+		address & 0xFF
+	);
+	return string(buffer, static_cast<size_t>(len));
+}
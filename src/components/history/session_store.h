@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "log_types.h"
+
+// Deduplicating string storage; id 0 is always the empty string.
+class StringPool {
+	public:
+		StringPool() = default;
+
+		// Views in m_ids point into m_strings, so copies would dangle; moves keep the deque's storage
+		StringPool(const StringPool &) = delete;
+		StringPool &operator=(const StringPool &) = delete;
+		StringPool(StringPool &&) = default;
+		StringPool &operator=(StringPool &&) = default;
+
+		uint32_t intern(std::string_view value);
+
+		const std::string &get(uint32_t id) const {
+			return id < m_strings.size() ? m_strings[id] : m_strings.front();
+		}
+
+		size_t size() const { return m_strings.size(); }
+
+		void clear();
+
+	private:
+		// deque keeps element addresses stable on growth, so the map can key on views into it
+		std::deque<std::string> m_strings {std::string {}};
+		std::unordered_map<std::string_view, uint32_t> m_ids;
+};
+
+// Column-oriented storage for every game session of every log.
+struct SessionTable {
+		std::vector<int64_t> timestampMs;
+		std::vector<JobGuid> jobId;
+		std::vector<uint64_t> placeId;
+		std::vector<uint64_t> universeId;
+		std::vector<uint32_t> serverIp;
+		std::vector<uint16_t> serverPort;
+		std::vector<uint32_t> durationMs;
+
+		size_t size() const { return timestampMs.size(); }
+
+		void push(const GameSession &session);
+
+		GameSession row(size_t index) const;
+
+		void reserve(size_t count);
+
+		void truncate(size_t count);
+
+		void clear();
+};
+
+// Offset/length pair into HistoryStore::outputArena
+struct TextSpan {
+		uint64_t offset = 0;
+		uint32_t length = 0;
+};
+
+// Everything the History tab knows about the logs folder.
+struct HistoryStore {
+		std::vector<LogInfo> logs; // Sorted oldest first, so live logs append at the end
+		SessionTable sessions;
+		StringPool strings; // Versions and channels
+		std::string outputArena; // Concatenated [FLog::Output] lines
+		std::vector<TextSpan> outputLines;
+
+		GameSession session(const LogInfo &log, uint32_t index) const { return sessions.row(log.firstSession + index); }
+
+		std::string_view outputLine(const LogInfo &log, uint32_t index) const;
+
+		const std::string &version(const LogInfo &log) const { return strings.get(log.versionId); }
+
+		const std::string &channel(const LogInfo &log) const { return strings.get(log.channelId); }
+
+		// Drops the sessions and output lines of log, which must be the most recently parsed one
+		void discardParsed(const LogInfo &log);
+
+		void sortLogsByTime();
+
+		void clear();
+};
+
+// Parses a canonical GUID; returns false (leaving out untouched) on malformed input
+bool parseJobGuid(std::string_view text, JobGuid &out);
+
+std::string formatJobGuid(const JobGuid &guid);
+
+// Parses dotted-quad IPv4; returns false on malformed input
+bool parseIpv4(std::string_view text, uint32_t &out);
+
+std::string formatIpv4(uint32_t address);
@@ -0,0 +1,132 @@
+#include "server_crawler.h"
+#include "server_page_cache.h"
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+
+#include "core/logging.hpp"
+#include "system/threading.h"
+
+using Clock = std::chrono::steady_clock;
+
+static bool isSuccess(int status) { return status >= 200 && status < 300; }
+
+static bool isRetryable(int status) { return status == 0 || status == 429 || status >= 500; }
+
+// Sleeps until deadline in short slices; returns false if cancelled meanwhile
+static bool waitUntil(Clock::time_point deadline, const std::atomic<bool> &cancelled) {
+	constexpr auto kSlice = std::chrono::milliseconds(50);
+	while (!cancelled.load(std::memory_order_relaxed)) {
+		Clock::time_point now = Clock::now();
+		if (now >= deadline) { return true; }
+		std::this_thread::sleep_for((std::min)(Clock::duration(kSlice), deadline - now));
+	}
+	return false;
+}
+
+static Roblox::ServerPage
+fetchPage(const ServerCrawler::PageFetcher &fetch, uint64_t placeId, const std::string &cursor) {
+	try {
+		return fetch(placeId, cursor);
+	} catch (const std::exception &) { return Roblox::ServerPage {}; }
+}
+
+ServerCrawler::ServerCrawler(ServerPageCache *cache, PageFetcher fetcher):
+	m_cache(cache),
+	m_fetcher(fetcher ? std::move(fetcher) : PageFetcher([](uint64_t placeId, const std::string &cursor) {
+		return Roblox::getPublicServersPage(placeId, cursor);
+	})) {}
+
+void ServerCrawler::start(uint64_t placeId, PageSink onPage, DoneCallback onDone, ServerCrawlOptions options) {
+	cancel();
+	auto cancelled = std::make_shared<std::atomic<bool>>(false);
+	auto running = std::make_shared<std::atomic<bool>>(true);
+	m_cancelled = cancelled;
+	m_running = running;
+
+	Threading::newThread([placeId,
+						  cache = m_cache,
+						  fetch = m_fetcher,
+						  onPage = std::move(onPage),
+						  onDone = std::move(onDone),
+						  options,
+						  cancelled,
+						  running]() {
+		ServerCrawlResult result = crawl(placeId, cache, fetch, onPage, options, *cancelled);
+		running->store(false);
+		if (onDone) { onDone(result); }
+	});
+}
+
+void ServerCrawler::cancel() {
+	if (m_cancelled) { m_cancelled->store(true); }
+}
+
+bool ServerCrawler::running() const { return m_running && m_running->load(); }
+
+ServerCrawlResult ServerCrawler::crawl(
+	uint64_t placeId,
+	ServerPageCache *cache,
+	const PageFetcher &fetch,
+	const PageSink &onPage,
+	const ServerCrawlOptions &options,
+	const std::atomic<bool> &cancelled
+) {
+	ServerCrawlResult result;
+	std::string cursor;
+	std::unordered_set<std::string> seenCursors;
+	Clock::time_point nextRequest = Clock::now();
+
+	while (result.pages < options.maxPages) {
+		if (cancelled.load()) {
+			result.cancelled = true;
+			break;
+		}
+
+		Roblox::ServerPage page;
+		if (cache && cache->get(placeId, cursor, page)) {
+			++result.cachedPages;
+		} else {
+			for (int attempt = 0;; ++attempt) {
+				if (!waitUntil(nextRequest, cancelled)) { break; }
+				page = fetchPage(fetch, placeId, cursor);
+				nextRequest = Clock::now() + options.minRequestInterval;
+				if (isSuccess(page.statusCode) || !isRetryable(page.statusCode) || attempt >= options.maxRetries) {
+					break;
+				}
+				nextRequest = Clock::now() + options.retryDelay * (1 << (std::min)(attempt, 6));
+			}
+			if (cancelled.load()) {
+				result.cancelled = true;
+				break;
+			}
+			if (!isSuccess(page.statusCode)) {
+				result.failed = true;
+				result.failedStatus = page.statusCode;
+				LOG_WARN(
+					"Server list stopped after " + std::to_string(result.pages) + " pages: "
+					+ (page.statusCode ? "HTTP " + std::to_string(page.statusCode) : std::string("network error"))
+				);
+				break;
+			}
+			if (cache) { cache->put(placeId, cursor, page); }
+		}
+
+		++result.pages;
+		result.servers += page.data.size();
+		if (onPage && !onPage(page)) {
+			result.stopped = true;
+			break;
+		}
+		// A cursor seen before would loop forever; treat it as the end of the listing
+		if (page.nextCursor.empty() || !seenCursors.insert(page.nextCursor).second) {
+			result.complete = true;
+			break;
+		}
+		cursor = page.nextCursor;
+	}
+	return result;
+}
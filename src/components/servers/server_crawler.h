@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "network/roblox/games.h"
+
+class ServerPageCache;
+
+struct ServerCrawlOptions {
+		size_t maxPages = 1000; // 100 servers per page
+		std::chrono::milliseconds minRequestInterval {250}; // Spacing between requests to stay under the rate limit
+		int maxRetries = 5; // Per page, for HTTP 429, 5xx and network errors
+		std::chrono::milliseconds retryDelay {1000}; // Doubles after each failed attempt on the same page
+};
+
+struct ServerCrawlResult {
+		size_t pages = 0;
+		size_t servers = 0; // Rows over all pages; a server that moved between pages is counted twice
+		size_t cachedPages = 0; // Pages served from the page cache
+		bool complete = false; // Reached the last page
+		bool stopped = false; // The page sink asked to stop
+		bool cancelled = false;
+		bool failed = false; // A page kept failing after its retries
+		int failedStatus = 0; // HTTP status of that page, 0 for a network error
+};
+
+// Walks every public server page of a place by following nextPageCursor. Pages come from the cache while fresh and
+// are fetched otherwise, spaced by minRequestInterval and retried with backoff when rate limited.
+class ServerCrawler {
+	public:
+		using PageFetcher = std::function<Roblox::ServerPage(uint64_t placeId, const std::string &cursor)>;
+		// Called on the crawling thread for each page, in cursor order; returning false ends the crawl
+		using PageSink = std::function<bool(const Roblox::ServerPage &page)>;
+		// Called on the crawling thread once the crawl ends, also after cancel()
+		using DoneCallback = std::function<void(const ServerCrawlResult &result)>;
+
+		// cache may be null; fetcher defaults to Roblox::getPublicServersPage
+		explicit ServerCrawler(ServerPageCache *cache, PageFetcher fetcher = {});
+
+		// Cancels the running crawl, if any, and starts a new one on a background thread
+		void start(uint64_t placeId, PageSink onPage, DoneCallback onDone, ServerCrawlOptions options = {});
+
+		void cancel();
+
+		bool running() const;
+
+		// The crawl itself, on the calling thread
+		static ServerCrawlResult crawl(
+			uint64_t placeId,
+			ServerPageCache *cache,
+			const PageFetcher &fetch,
+			const PageSink &onPage,
+			const ServerCrawlOptions &options,
+			const std::atomic<bool> &cancelled
+		);
+
+	private:
+		ServerPageCache *m_cache;
+		PageFetcher m_fetcher;
+		std::shared_ptr<std::atomic<bool>> m_cancelled; // Of the latest crawl, shared with its thread
+		std::shared_ptr<std::atomic<bool>> m_running;
+};
@@ -0,0 +1,129 @@
+#include "server_finder.h"
+#include "server_page_cache.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "core/logging.hpp"
+#include "core/status.h"
+#include "system/launcher.hpp"
+#include "system/threading.h"
+
+// A launch waits on the search, and ping-only scoring gives the finder no bound to stop on, so it reads at most this
+// many pages (about half a second of request spacing) before launching or falling back to a plain game join
+static constexpr size_t kLaunchSearchPages = 3;
+
+static bool worseScore(const ScoredServer &a, const ScoredServer &b) { return a.score > b.score; }
+
+bool ServerScoring::eligible(const PublicServerInfo &server) const {
+	return !server.jobId.empty() && server.maximumPlayers - server.currentPlayers >= minFreeSlots;
+}
+
+double ServerScoring::score(const PublicServerInfo &server) const {
+	double fps = (std::min)(server.averageFps, kMaxFps);
+	int freeSlots = (std::max)(0, server.maximumPlayers - server.currentPlayers);
+	return fpsWeight * fps + freeSlotWeight * freeSlots - pingWeight * server.averagePing;
+}
+
+BestServerFinder::BestServerFinder(ServerScoring scoring, size_t k): m_scoring(scoring), m_k(k ? k : 1) {
+	m_heap.reserve(m_k);
+}
+
+bool BestServerFinder::addPage(const Roblox::ServerPage &page) {
+	for (const auto &server : page.data) {
+		++m_scanned;
+		m_capacity = (std::max)(m_capacity, server.maximumPlayers);
+		if (!m_scoring.eligible(server)) { continue; }
+
+		ScoredServer candidate {server, m_scoring.score(server)};
+		if (m_heap.size() < m_k) {
+			m_heap.push_back(std::move(candidate));
+			std::push_heap(m_heap.begin(), m_heap.end(), worseScore);
+		} else if (candidate.score > m_heap.front().score) {
+			std::pop_heap(m_heap.begin(), m_heap.end(), worseScore);
+			m_heap.back() = std::move(candidate);
+			std::push_heap(m_heap.begin(), m_heap.end(), worseScore);
+		}
+	}
+	if (page.data.empty()) { return true; }
+
+	m_playersFloor = (std::max)(m_playersFloor, page.data.back().currentPlayers);
+	int freeSlotsBound = m_capacity - m_playersFloor;
+	if (freeSlotsBound < m_scoring.minFreeSlots) { return false; }
+	if (m_heap.size() < m_k) { return true; }
+
+	// Best a later server can do: no ping, full FPS and as many open slots as the fullest-so-far listing allows
+	double bound = m_scoring.fpsWeight * ServerScoring::kMaxFps + m_scoring.freeSlotWeight * freeSlotsBound;
+	return bound > m_heap.front().score;
+}
+
+std::vector<ScoredServer> BestServerFinder::results() const {
+	std::vector<ScoredServer> best = m_heap;
+	std::sort_heap(best.begin(), best.end(), worseScore);
+	return best;
+}
+
+void FindBestServers(
+	uint64_t placeId,
+	ServerScoring scoring,
+	size_t k,
+	std::function<void(const BestServerSearch &search)> onDone,
+	ServerCrawlOptions options,
+	std::function<void(size_t scanned)> onProgress
+) {
+	auto finder = std::make_shared<BestServerFinder>(scoring, k);
+	// The crawl's thread holds everything it needs, so the crawler object itself can go out of scope
+	ServerCrawler crawler(&SharedServerPageCache());
+	crawler.start(
+		placeId,
+		[finder, onProgress = std::move(onProgress)](const Roblox::ServerPage &page) {
+			bool more = finder->addPage(page);
+			if (onProgress) { onProgress(finder->scanned()); }
+			return more;
+		},
+		[finder, onDone = std::move(onDone)](const ServerCrawlResult &result) {
+			if (onDone) { onDone({finder->results(), finder->scanned(), result}); }
+		},
+		options
+	);
+}
+
+void LaunchIntoBestServer(uint64_t placeId, std::vector<Roblox::HBA::AuthCredentials> accounts) {
+	if (accounts.empty()) { return; }
+
+	ServerScoring scoring;
+	scoring.minFreeSlots = static_cast<int>(accounts.size());
+	ServerCrawlOptions options;
+	options.maxPages = kLaunchSearchPages;
+
+	LOG_INFO("Looking for the best server...");
+	Status::Set("Looking for the best server...");
+	FindBestServers(
+		placeId,
+		scoring,
+		1,
+		[placeId, accounts = std::move(accounts)](const BestServerSearch &search) {
+			if (search.servers.empty()) {
+				LOG_INFO(
+					"No server with " + std::to_string(accounts.size()) + " free slots among "
+					+ std::to_string(search.scanned) + " checked; joining the game instead"
+				);
+				Status::Set("No server with room found; joining the game");
+				launchRobloxSequential(placeId, "", accounts);
+				return;
+			}
+			const PublicServerInfo &best = search.servers.front().server;
+			LOG_INFO(
+				"Joining server " + best.jobId + " (" + std::to_string(static_cast<int>(best.averagePing + 0.5))
+				+ " ms, " + std::to_string(best.currentPlayers) + "/" + std::to_string(best.maximumPlayers)
+				+ " players, " + std::to_string(search.scanned) + " servers checked)"
+			);
+			Status::Set("Joining the best server (" + std::to_string(search.scanned) + " servers checked)");
+			launchRobloxSequential(placeId, best.jobId, accounts);
+		},
+		options,
+		[](size_t scanned) { Status::Set("Looking for the best server (" + std::to_string(scanned) + " checked)..."); }
+	);
+}
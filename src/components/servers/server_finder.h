@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "network/roblox/games.h"
+#include "network/roblox/hba.h"
+#include "server_crawler.h"
+
+// How candidate servers are ranked; higher scores are better. Weights are expected to be non-negative.
+struct ServerScoring {
+		static constexpr double kMaxFps = 60.0; // Server FPS is capped here, both for scoring and for bounds
+
+		int minFreeSlots = 1; // Servers with fewer open slots are never candidates
+		double pingWeight = 1.0; // Subtracted per ms of average ping
+		double fpsWeight = 0.0; // Added per frame per second
+		double freeSlotWeight = 0.0; // Added per open slot
+
+		bool eligible(const PublicServerInfo &server) const;
+
+		double score(const PublicServerInfo &server) const;
+};
+
+struct ScoredServer {
+		PublicServerInfo server;
+		double score = 0.0;
+};
+
+// Keeps the k best eligible servers from pages fed in listing order, in a min-heap so the worst kept server is the
+// one to beat. Pages are expected in ascending player count (getPublicServersPage asks for sortOrder=Asc), so later
+// servers never have more open slots than the last one seen; that bounds what any later server can score, and
+// addPage reports when the bound can no longer beat the heap or no later server can have minFreeSlots open.
+class BestServerFinder {
+	public:
+		BestServerFinder(ServerScoring scoring, size_t k);
+
+		// Returns false once no later page can contain a better candidate
+		bool addPage(const Roblox::ServerPage &page);
+
+		// Best first
+		std::vector<ScoredServer> results() const;
+
+		size_t scanned() const { return m_scanned; }
+
+	private:
+		ServerScoring m_scoring;
+		size_t m_k;
+		std::vector<ScoredServer> m_heap; // Min-heap on score
+		int m_playersFloor = 0; // Later servers have at least this many players
+		int m_capacity = 0; // Largest maximumPlayers seen
+		size_t m_scanned = 0;
+};
+
+struct BestServerSearch {
+		std::vector<ScoredServer> servers; // Best first, at most k
+		size_t scanned = 0;
+		ServerCrawlResult crawl;
+};
+
+/**
+ * Streams the place's public server pages (fresh ones from the shared page cache) through a BestServerFinder on a
+ * background thread, stopping as soon as the finder has its answer.
+ * @param onDone Runs on the background thread
+ * @param onProgress Optional; runs on the background thread after each page with the servers scanned so far
+ */
+void FindBestServers(
+	uint64_t placeId,
+	ServerScoring scoring,
+	size_t k,
+	std::function<void(const BestServerSearch &search)> onDone,
+	ServerCrawlOptions options = {},
+	std::function<void(size_t scanned)> onProgress = {}
+);
+
+// Join-menu action: launches the accounts into the lowest-ping server with room for all of them among the first few
+// pages, or into the game when none of those has room. Progress is shown in the status bar.
+void LaunchIntoBestServer(uint64_t placeId, std::vector<Roblox::HBA::AuthCredentials> accounts);
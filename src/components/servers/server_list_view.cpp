@@ -0,0 +1,122 @@
+#include "server_list_view.h"
+
+#include <algorithm>
+#include <cctype>
+#include <utility>
+
+static std::string searchKey(const PublicServerInfo &srv) {
+	std::string key = srv.jobId + ' ' + std::to_string(srv.currentPlayers) + '/' + std::to_string(srv.maximumPlayers)
+					+ ' ' + std::to_string(static_cast<int>(srv.averagePing + 0.5)) + "ms "
+					+ std::to_string(static_cast<int>(srv.averageFps + 0.5));
+	for (char &c : key) { c = static_cast<char>(std::tolower(static_cast<unsigned char>(c))); }
+	return key;
+}
+
+// Ties fall back to row index, so every order is total and merging appended rows gives the same result as a full sort
+static bool
+rowLess(const std::vector<PublicServerInfo> &rows, ServerSortMode mode, bool byJobId, uint32_t a, uint32_t b) {
+	const PublicServerInfo &x = rows[a];
+	const PublicServerInfo &y = rows[b];
+	switch (mode) {
+	case ServerSortMode::PingAsc:
+		if (x.averagePing != y.averagePing) { return x.averagePing < y.averagePing; }
+		break;
+	case ServerSortMode::PingDesc:
+		if (x.averagePing != y.averagePing) { return x.averagePing > y.averagePing; }
+		break;
+	case ServerSortMode::PlayersAsc:
+		if (x.currentPlayers != y.currentPlayers) { return x.currentPlayers < y.currentPlayers; }
+		break;
+	case ServerSortMode::PlayersDesc:
+		if (x.currentPlayers != y.currentPlayers) { return x.currentPlayers > y.currentPlayers; }
+		break;
+	case ServerSortMode::None:
+	default:
+		if (byJobId && x.jobId != y.jobId) { return x.jobId < y.jobId; }
+		break;
+	}
+	return a < b;
+}
+
+void ServerListView::clear() { assign({}); }
+
+void ServerListView::assign(std::vector<PublicServerInfo> servers) {
+	m_rows = std::move(servers);
+	m_keys.clear();
+	m_keys.reserve(m_rows.size());
+	m_byJobId.clear();
+	for (uint32_t i = 0; i < m_rows.size(); ++i) {
+		m_keys.push_back(searchKey(m_rows[i]));
+		m_byJobId.emplace(m_rows[i].jobId, i);
+	}
+	m_orderedRows.fill(0);
+	m_visibleValid = false;
+}
+
+void ServerListView::upsert(PublicServerInfo server) {
+	auto [it, inserted] = m_byJobId.try_emplace(server.jobId, static_cast<uint32_t>(m_rows.size()));
+	if (inserted) {
+		m_keys.push_back(searchKey(server));
+		m_rows.push_back(std::move(server));
+	} else {
+		// An existing row may move in any order, so the orders are rebuilt from scratch
+		m_keys[it->second] = searchKey(server);
+		m_rows[it->second] = std::move(server);
+		m_orderedRows.fill(0);
+	}
+	m_visibleValid = false;
+}
+
+void ServerListView::setQuery(std::string_view lowerQuery) {
+	if (lowerQuery == m_query) { return; }
+	// A longer term only removes rows, so the current result is narrowed in place when the order stays the same
+	bool narrow = m_visibleValid && !m_query.empty() && lowerQuery.find(m_query) != std::string_view::npos;
+	m_query.assign(lowerQuery);
+	if (narrow) {
+		std::erase_if(m_visible, [&](uint32_t index) { return !matches(index); });
+	} else {
+		m_visibleValid = false;
+	}
+}
+
+void ServerListView::setSortMode(ServerSortMode mode) {
+	if (mode == m_mode) { return; }
+	m_mode = mode;
+	m_visibleValid = false;
+}
+
+size_t ServerListView::orderSlot() const {
+	if (m_mode == ServerSortMode::None && !m_query.empty()) { return kJobIdOrder; }
+	return static_cast<size_t>(m_mode);
+}
+
+const std::vector<uint32_t> &ServerListView::order(size_t slot) {
+	std::vector<uint32_t> &indices = m_orders[slot];
+	size_t covered = m_orderedRows[slot];
+	if (covered == m_rows.size()) { return indices; }
+
+	ServerSortMode mode = slot == kJobIdOrder ? ServerSortMode::None : static_cast<ServerSortMode>(slot);
+	auto less = [&](uint32_t a, uint32_t b) { return rowLess(m_rows, mode, slot == kJobIdOrder, a, b); };
+	indices.resize(covered);
+	for (size_t i = covered; i < m_rows.size(); ++i) { indices.push_back(static_cast<uint32_t>(i)); }
+	auto appended = indices.begin() + static_cast<std::ptrdiff_t>(covered);
+	std::sort(appended, indices.end(), less);
+	std::inplace_merge(indices.begin(), appended, indices.end(), less);
+	m_orderedRows[slot] = m_rows.size();
+	return indices;
+}
+
+const std::vector<uint32_t> &ServerListView::visible() {
+	if (m_visibleValid) { return m_visible; }
+	const std::vector<uint32_t> &indices = order(orderSlot());
+	if (m_query.empty()) {
+		m_visible = indices;
+	} else {
+		m_visible.clear();
+		for (uint32_t index : indices) {
+			if (matches(index)) { m_visible.push_back(index); }
+		}
+	}
+	m_visibleValid = true;
+	return m_visible;
+}
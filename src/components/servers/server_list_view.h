@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "../components.h"
+
+enum class ServerSortMode { None = 0, PingAsc, PingDesc, PlayersAsc, PlayersDesc };
+
+// The rows of the servers table with everything needed to show them filtered and sorted, kept between frames. Each
+// row's search text is built once when the row is stored, and each sort order is computed once and kept until the
+// rows change; appended rows are merged into the existing orders instead of resorting. visible() only does work
+// after the rows, query or sort mode changed. Owned by the UI thread.
+class ServerListView {
+	public:
+		void clear();
+
+		// Replaces every row
+		void assign(std::vector<PublicServerInfo> servers);
+
+		// Adds a server, or updates the row with the same job id
+		void upsert(PublicServerInfo server);
+
+		// Lowercased search term; rows match when their "jobId players/max pingms fps" text contains it
+		void setQuery(std::string_view lowerQuery);
+
+		void setSortMode(ServerSortMode mode);
+
+		// Indices of matching rows in display order
+		const std::vector<uint32_t> &visible();
+
+		const PublicServerInfo &row(uint32_t index) const { return m_rows[index]; }
+
+		size_t size() const { return m_rows.size(); }
+
+		bool empty() const { return m_rows.empty(); }
+
+	private:
+		// The sort modes, plus job id order used for search results when no sort is chosen
+		static constexpr size_t kJobIdOrder = 5;
+		static constexpr size_t kOrderCount = 6;
+
+		size_t orderSlot() const;
+
+		const std::vector<uint32_t> &order(size_t slot);
+
+		bool matches(uint32_t index) const { return m_keys[index].find(m_query) != std::string::npos; }
+
+		std::vector<PublicServerInfo> m_rows;
+		std::vector<std::string> m_keys; // Lowercased search text per row
+		std::unordered_map<std::string, uint32_t> m_byJobId;
+
+		std::array<std::vector<uint32_t>, kOrderCount> m_orders;
+		std::array<size_t, kOrderCount> m_orderedRows {}; // Rows m_orders[slot] covers; the rest were appended since
+
+		std::string m_query;
+		ServerSortMode m_mode = ServerSortMode::None;
+		std::vector<uint32_t> m_visible;
+		bool m_visibleValid = false;
+};
@@ -0,0 +1,109 @@
+#include "server_page_cache.h"
+
+#include <utility>
+
+// A page per 100 servers; a place's listing is refetched once it is a minute old
+static constexpr size_t kSharedCachePages = 1000;
+static constexpr auto kSharedCacheTtl = std::chrono::seconds(60);
+
+ServerPageCache &SharedServerPageCache() {
+	static ServerPageCache cache(kSharedCachePages, kSharedCacheTtl);
+	return cache;
+}
+
+ServerPageCache::ServerPageCache(size_t maxPages, Clock::duration ttl):
+	m_maxPages(maxPages ? maxPages : 1),
+	m_ttl(ttl) {}
+
+std::string ServerPageCache::keyOf(uint64_t placeId, const std::string &cursor) {
+	return std::to_string(placeId) + ':' + cursor;
+}
+
+ServerPageCache::EntryList::iterator
+ServerPageCache::findFresh(uint64_t placeId, const std::string &cursor, Clock::time_point now) {
+	auto found = m_index.find(keyOf(placeId, cursor));
+	if (found == m_index.end()) { return m_entries.end(); }
+	EntryList::iterator it = found->second;
+	if (now - it->fetchedAt > m_ttl) {
+		eraseLocked(it);
+		return m_entries.end();
+	}
+	m_entries.splice(m_entries.begin(), m_entries, it);
+	return it;
+}
+
+void ServerPageCache::eraseLocked(EntryList::iterator it) {
+	m_index.erase(keyOf(it->placeId, it->cursor));
+	m_entries.erase(it);
+	++m_generation;
+}
+
+bool ServerPageCache::get(uint64_t placeId, const std::string &cursor, Roblox::ServerPage &out) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto it = findFresh(placeId, cursor, Clock::now());
+	if (it == m_entries.end()) { return false; }
+	out = it->page;
+	return true;
+}
+
+bool ServerPageCache::contains(uint64_t placeId, const std::string &cursor) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return findFresh(placeId, cursor, Clock::now()) != m_entries.end();
+}
+
+void ServerPageCache::put(uint64_t placeId, const std::string &cursor, Roblox::ServerPage page) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	std::string key = keyOf(placeId, cursor);
+	auto found = m_index.find(key);
+	if (found != m_index.end()) {
+		m_entries.erase(found->second);
+		m_index.erase(found);
+	}
+
+	m_entries.push_front({placeId, cursor, std::move(page), Clock::now()});
+	m_index.emplace(std::move(key), m_entries.begin());
+	++m_generation;
+	while (m_entries.size() > m_maxPages) { eraseLocked(std::prev(m_entries.end())); }
+}
+
+void ServerPageCache::forEachPage(uint64_t placeId, const std::function<void(const Roblox::ServerPage &)> &fn) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	Clock::time_point now = Clock::now();
+	for (auto it = m_entries.begin(); it != m_entries.end();) {
+		auto next = std::next(it);
+		if (it->placeId == placeId) {
+			if (now - it->fetchedAt > m_ttl) {
+				eraseLocked(it);
+			} else {
+				fn(it->page);
+			}
+		}
+		it = next;
+	}
+}
+
+void ServerPageCache::erasePlace(uint64_t placeId) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (auto it = m_entries.begin(); it != m_entries.end();) {
+		auto next = std::next(it);
+		if (it->placeId == placeId) { eraseLocked(it); }
+		it = next;
+	}
+}
+
+void ServerPageCache::clear() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_entries.clear();
+	m_index.clear();
+	++m_generation;
+}
+
+size_t ServerPageCache::size() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_entries.size();
+}
+
+uint64_t ServerPageCache::generation() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_generation;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "network/roblox/games.h"
+
+// Public server pages keyed by place and cursor, shared by the page browser and the crawler. A page expires ttl after
+// it was fetched, so each place's listing is refetched once it is stale; past maxPages the least recently used page
+// is evicted. All methods lock, so background fetches can fill the cache directly.
+class ServerPageCache {
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		ServerPageCache(size_t maxPages, Clock::duration ttl);
+
+		// Copies a fresh page into out; expired pages are dropped and reported as missing
+		bool get(uint64_t placeId, const std::string &cursor, Roblox::ServerPage &out);
+
+		bool contains(uint64_t placeId, const std::string &cursor);
+
+		void put(uint64_t placeId, const std::string &cursor, Roblox::ServerPage page);
+
+		// Calls fn for each fresh page of placeId with the cache locked; fn must not call back into the cache
+		void forEachPage(uint64_t placeId, const std::function<void(const Roblox::ServerPage &)> &fn);
+
+		void erasePlace(uint64_t placeId);
+
+		void clear();
+
+		size_t size() const;
+
+		// Changes whenever a page is added or removed
+		uint64_t generation() const;
+
+	private:
+		struct Entry {
+				uint64_t placeId = 0;
+				std::string cursor;
+				Roblox::ServerPage page;
+				Clock::time_point fetchedAt;
+		};
+
+		using EntryList = std::list<Entry>;
+
+		static std::string keyOf(uint64_t placeId, const std::string &cursor);
+
+		// Caller holds m_mutex; returns m_entries.end() for missing or expired pages
+		EntryList::iterator findFresh(uint64_t placeId, const std::string &cursor, Clock::time_point now);
+
+		void eraseLocked(EntryList::iterator it);
+
+		mutable std::mutex m_mutex;
+		EntryList m_entries; // Most recently used first
+		std::unordered_map<std::string, EntryList::iterator> m_index;
+		uint64_t m_generation = 0;
+		size_t m_maxPages;
+		Clock::duration m_ttl;
+};
+
+// The cache shared by the servers tab, its crawler and the best-server finder
+ServerPageCache &SharedServerPageCache();
@@ -1,5 +1,8 @@
 #define _CRT_SECURE_NO_WARNINGS
 #include "servers.h"
+#include "server_crawler.h"
+#include "server_list_view.h"
+#include "server_page_cache.h"
 #include "servers_utils.h"
 
 #include "imgui_internal.h"
@@ -12,6 +15,7 @@
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -23,6 +27,8 @@
 #include "core/status.h"
 #include "network/roblox.h"
 #include "system/launcher.hpp"
+#include "system/main_thread.h"
+#include "system/threading.h"
 #include "ui/modal_popup.h"
 
 using namespace ImGui;
@@ -30,20 +36,18 @@ using std::all_of;
 using std::exception;
 using std::find_if;
 using std::pair;
-using std::sort;
 using std::string;
 using std::thread;
 using std::to_string;
 using std::unordered_map;
+using std::unordered_set;
 using std::vector;
 
-enum class ServerSortMode { None = 0, PingAsc, PingDesc, PlayersAsc, PlayersDesc };
-
 static ServerSortMode g_serverSortMode = ServerSortMode::None;
 static int g_serverSortComboIndex = 0;
 
-static vector<PublicServerInfo> s_cachedServers;
-static unordered_map<string, Roblox::ServerPage> g_pageCache;
+static vector<PublicServerInfo> s_cachedServers; // Current page
+static uint64_t g_pageVersion_servers = 0; // Bumped whenever s_cachedServers is replaced
 
 static string g_currCursor_servers;
 static string g_nextCursor_servers;
@@ -54,39 +58,204 @@ static char s_placeIdBuffer[32] {};
 
 static uint64_t g_current_placeId_servers = 0;
 
-static bool matchesQuery(const PublicServerInfo &srv, const string &qLower) {
-	string hay = srv.jobId + ' ' + to_string(srv.currentPlayers) + '/' + to_string(srv.maximumPlayers) + ' '
-			   + to_string(static_cast<int>(srv.averagePing + 0.5)) + "ms "
-			   + to_string(static_cast<int>(srv.averageFps + 0.5));
-	string lowerHay = toLower(hay);
-	return lowerHay.find(qLower) != string::npos;
+static void setCurrentPage(vector<PublicServerInfo> servers) {
+	s_cachedServers = std::move(servers);
+	++g_pageVersion_servers;
 }
 
-static void fetchPageServers(uint64_t placeId, const string &cursor = {}) {
-	try {
-		if (placeId != g_current_placeId_servers) {
-			g_pageCache.clear();
-			g_current_placeId_servers = placeId;
+static void showPage(const string &cursor, const Roblox::ServerPage &page);
+
+// Page fetches run on background threads and report back through MainThread::Post, so the page state in this file is
+// only touched on the UI thread
+static bool g_loadingServers = false; // A page the user asked for is on its way
+static string g_pendingCursor_servers; // Cursor of that page
+static unordered_set<string> g_inFlightCursors; // Fetches running for g_current_placeId_servers
+static uint64_t g_placeGeneration_servers = 0; // Bumped on place change; results from older generations are dropped
+
+// Crawl of every page of g_current_placeId_servers; while g_crawlMode is set the table lists g_crawlView
+static ServerCrawler g_crawler(&SharedServerPageCache());
+static bool g_crawlMode = false;
+static bool g_crawlRunning = false;
+static uint64_t g_crawlGeneration = 0; // Bumped per crawl; pages from an older crawl are dropped
+static ServerListView g_crawlView;
+static size_t g_crawledPages = 0;
+static ServerCrawlResult g_lastCrawl;
+
+// The current page, or while searching every cached page of the place; rebuilt when its source changes
+static ServerListView g_pageView;
+static bool g_pageViewSearching = false;
+static uint64_t g_pageViewStamp = ~0ull; // g_pageVersion_servers or the cache generation it was built from
+
+static void onPageFetched(uint64_t generation, const string &cursor, Roblox::ServerPage page, bool failed) {
+	if (generation != g_placeGeneration_servers) { return; }
+	g_inFlightCursors.erase(cursor);
+
+	if (g_loadingServers && cursor == g_pendingCursor_servers) {
+		if (failed) {
+			// Prefetches fail quietly; the page the user asked for is reported
+			LOG_WARN(
+				"Could not load servers: "
+				+ (page.statusCode ? "HTTP " + std::to_string(page.statusCode) : string("network error"))
+			);
+			g_loadingServers = false;
+			setCurrentPage({});
+			g_nextCursor_servers.clear();
+			g_prevCursor_servers.clear();
+			return;
 		}
+		showPage(cursor, page);
+	}
+}
+
+static void startPageFetch(uint64_t placeId, const string &cursor) {
+	if (!g_inFlightCursors.insert(cursor).second) { return; }
+	Threading::newThread([placeId, cursor, generation = g_placeGeneration_servers]() {
 		Roblox::ServerPage page;
-		auto it_cache = g_pageCache.find(cursor);
-		if (it_cache != g_pageCache.end()) {
-			page = it_cache->second;
-		} else {
+		bool failed = false;
+		try {
 			page = Roblox::getPublicServersPage(placeId, cursor);
-			g_pageCache.emplace(cursor, page);
+			failed = page.statusCode < 200 || page.statusCode >= 300;
+		} catch (const exception &ex) {
+			LOG_INFO(string("Fetch error: ") + ex.what());
+			failed = true;
+		}
+		// Failed or empty pages are not cached, so asking again retries
+		if (!failed && !page.data.empty()) { SharedServerPageCache().put(placeId, cursor, page); }
+		MainThread::Post([generation, cursor, page = std::move(page), failed]() mutable {
+			onPageFetched(generation, cursor, std::move(page), failed);
+		});
+	});
+}
+
+// The next page is fetched while the user looks at this one, so "Next Page" is usually served from the cache
+static void prefetchNextPage() {
+	const string &next = g_nextCursor_servers;
+	if (next.empty() || SharedServerPageCache().contains(g_current_placeId_servers, next)) { return; }
+	startPageFetch(g_current_placeId_servers, next);
+}
+
+static void showPage(const string &cursor, const Roblox::ServerPage &page) {
+	g_loadingServers = false;
+	setCurrentPage(page.data);
+	g_nextCursor_servers = page.nextCursor;
+	g_prevCursor_servers = page.prevCursor;
+	g_currCursor_servers = cursor;
+	LOG_INFO(s_cachedServers.empty() ? "No servers found for this page" : "Fetched servers");
+	prefetchNextPage();
+}
+
+static void stopCrawl() {
+	g_crawler.cancel();
+	++g_crawlGeneration;
+	g_crawlMode = false;
+	g_crawlRunning = false;
+	g_crawlView.clear();
+	g_crawledPages = 0;
+}
+
+static void switchPlace(uint64_t placeId) {
+	if (placeId == g_current_placeId_servers) { return; }
+	stopCrawl();
+	g_inFlightCursors.clear();
+	++g_placeGeneration_servers;
+	g_current_placeId_servers = placeId;
+	setCurrentPage({});
+	g_nextCursor_servers.clear();
+	g_prevCursor_servers.clear();
+}
+
+static void fetchPageServers(uint64_t placeId, const string &cursor = {}) {
+	switchPlace(placeId);
+	if (g_crawlMode) { stopCrawl(); }
+
+	Roblox::ServerPage cached;
+	if (SharedServerPageCache().get(placeId, cursor, cached)) {
+		g_pendingCursor_servers.clear();
+		showPage(cursor, cached);
+		return;
+	}
+
+	// The current rows stay visible until the page arrives; a prefetch already running for it is reused
+	g_loadingServers = true;
+	g_pendingCursor_servers = cursor;
+	startPageFetch(placeId, cursor);
+}
+
+static void onCrawlPage(uint64_t generation, vector<PublicServerInfo> servers) {
+	if (generation != g_crawlGeneration) { return; }
+	++g_crawledPages;
+	// Servers shift between pages as their player counts change, so a job seen before is updated in place
+	for (auto &srv : servers) { g_crawlView.upsert(std::move(srv)); }
+}
+
+static void startCrawl(uint64_t placeId) {
+	switchPlace(placeId);
+	stopCrawl();
+	g_crawlMode = true;
+	g_crawlRunning = true;
+	g_lastCrawl = {};
+	g_loadingServers = false;
+
+	uint64_t generation = g_crawlGeneration;
+	g_crawler.start(
+		placeId,
+		[generation](const Roblox::ServerPage &page) {
+			MainThread::Post([generation, servers = page.data]() mutable {
+				onCrawlPage(generation, std::move(servers));
+			});
+			return true;
+		},
+		[generation](const ServerCrawlResult &result) {
+			MainThread::Post([generation, result]() {
+				if (generation != g_crawlGeneration) { return; }
+				g_crawlRunning = false;
+				g_lastCrawl = result;
+				LOG_INFO(
+					"Server crawl " + string(result.complete ? "finished" : "stopped") + ": "
+					+ to_string(g_crawlView.size()) + " servers from " + to_string(result.pages) + " pages"
+				);
+			});
 		}
-		s_cachedServers = page.data;
-		g_nextCursor_servers = page.nextCursor;
-		g_prevCursor_servers = page.prevCursor;
-		g_currCursor_servers = cursor;
-		LOG_INFO(s_cachedServers.empty() ? "No servers found for this page" : "Fetched servers");
-	} catch (const exception &ex) {
-		LOG_INFO(string("Fetch error: ") + ex.what());
-		s_cachedServers.clear();
-		g_nextCursor_servers.clear();
-		g_prevCursor_servers.clear();
+	);
+}
+
+static void syncPageView(bool searching) {
+	uint64_t stamp = searching ? SharedServerPageCache().generation() : g_pageVersion_servers;
+	if (searching == g_pageViewSearching && stamp == g_pageViewStamp) { return; }
+	g_pageViewSearching = searching;
+	if (!searching) {
+		g_pageView.assign(s_cachedServers);
+		g_pageViewStamp = stamp;
+		return;
 	}
+
+	vector<PublicServerInfo> servers;
+	unordered_set<string> seen;
+	SharedServerPageCache().forEachPage(g_current_placeId_servers, [&](const Roblox::ServerPage &page) {
+		for (const auto &srv : page.data) {
+			if (seen.insert(srv.jobId).second) { servers.push_back(srv); }
+		}
+	});
+	g_pageView.assign(std::move(servers));
+	// Read after the walk, which drops expired pages and so bumps the generation itself
+	g_pageViewStamp = SharedServerPageCache().generation();
+}
+
+// Parses the place id field; logs and returns false when it is not a number
+static bool parsePlaceIdInput(uint64_t &placeId) {
+	string raw_pid {s_placeIdBuffer};
+	std::erase_if(raw_pid, ::isspace);
+	if (raw_pid.empty() || !all_of(raw_pid.begin(), raw_pid.end(), ::isdigit)) {
+		LOG_INFO("Place ID must be all digits.");
+		return false;
+	}
+	try {
+		placeId = std::stoull(raw_pid);
+		return true;
+	} catch (const std::out_of_range &oor) {
+		LOG_INFO(string("Place ID is too large: ") + oor.what());
+	} catch (const std::invalid_argument &ia) { LOG_INFO(string("Invalid Place ID format: ") + ia.what()); }
+	return false;
 }
 
 void ServerTab_SearchPlace(uint64_t placeId) {
@@ -105,7 +274,9 @@ void RenderServersTab() {
 	float fetchButtonWidth = CalcTextSize("Fetch Servers").x + style.FramePadding.x * 2.0f;
 	float prevButtonWidth = CalcTextSize("\xEF\x81\x93 Prev Page").x + style.FramePadding.x * 2.0f;
 	float nextButtonWidth = CalcTextSize("Next Page \xEF\x81\x94").x + style.FramePadding.x * 2.0f;
-	float buttons_total_width = fetchButtonWidth + prevButtonWidth + nextButtonWidth + style.ItemSpacing.x * 2;
+	float crawlButtonWidth = CalcTextSize("All Servers").x + style.FramePadding.x * 2.0f;
+	float buttons_total_width
+		= fetchButtonWidth + prevButtonWidth + nextButtonWidth + crawlButtonWidth + style.ItemSpacing.x * 3;
 	float inputWidth = GetContentRegionAvail().x - buttons_total_width - style.ItemSpacing.x;
 	float minField = GetFontSize() * 6.25f; // ~100px at 16px base
 	if (inputWidth < minField) { inputWidth = minField; }
@@ -114,18 +285,10 @@ void RenderServersTab() {
 	PopItemWidth();
 	SameLine(0, style.ItemSpacing.x);
 	if (Button("Fetch Servers", ImVec2(fetchButtonWidth, 0))) {
-		string raw_pid {s_placeIdBuffer};
-		std::erase_if(raw_pid, ::isspace);
-		if (raw_pid.empty() || !all_of(raw_pid.begin(), raw_pid.end(), ::isdigit)) {
-			LOG_INFO("Place ID must be all digits.");
-		} else {
-			try {
-				uint64_t pid_val = std::stoull(raw_pid);
-				g_currCursor_servers.clear();
-				fetchPageServers(pid_val);
-			} catch (const std::out_of_range &oor) {
-				LOG_INFO(string("Place ID is too large: ") + oor.what());
-			} catch (const std::invalid_argument &ia) { LOG_INFO(string("Invalid Place ID format: ") + ia.what()); }
+		uint64_t pid_val = 0;
+		if (parsePlaceIdInput(pid_val)) {
+			g_currCursor_servers.clear();
+			fetchPageServers(pid_val);
 		}
 	}
 	SameLine(0, style.ItemSpacing.x);
@@ -140,6 +303,14 @@ void RenderServersTab() {
 		fetchPageServers(g_current_placeId_servers, g_nextCursor_servers);
 	}
 	EndDisabled();
+	SameLine(0, style.ItemSpacing.x);
+	if (g_crawlRunning) {
+		if (Button("Stop##crawl_servers", ImVec2(crawlButtonWidth, 0))) { g_crawler.cancel(); }
+	} else if (Button("All Servers", ImVec2(crawlButtonWidth, 0))) {
+		uint64_t pid_val = 0;
+		if (parsePlaceIdInput(pid_val)) { startCrawl(pid_val); }
+	}
+	if (IsItemHovered()) { SetTooltip("Load every server of the place, page by page"); }
 
 	Separator();
 	const char *sortOptions[] = {"None", "Ping (Asc)", "Ping (Desc)", "Players (Asc)", "Players (Desc)"};
@@ -158,53 +329,33 @@ void RenderServersTab() {
 	}
 	PopItemWidth();
 
-	string qLower = toLower(s_searchBuffer);
-	bool isSearching = !qLower.empty();
-	vector<PublicServerInfo> displayList;
-	if (isSearching) {
-		for (const auto &pair_cache : g_pageCache) {
-			for (const auto &srv : pair_cache.second.data) {
-				if (matchesQuery(srv, qLower)) { displayList.push_back(srv); }
-			}
+	if (g_crawlMode) {
+		if (g_crawlRunning) {
+			TextDisabled("Loading all servers: %zu so far from %zu pages...", g_crawlView.size(), g_crawledPages);
+		} else if (g_lastCrawl.failed) {
+			TextDisabled(
+				"%zu servers from %zu pages (stopped early: HTTP %d)",
+				g_crawlView.size(),
+				g_crawledPages,
+				g_lastCrawl.failedStatus
+			);
+		} else {
+			TextDisabled(
+				"%zu servers from %zu pages%s",
+				g_crawlView.size(),
+				g_crawledPages,
+				g_lastCrawl.complete ? "" : " (stopped)"
+			);
 		}
-	} else {
-		displayList = s_cachedServers;
 	}
 
-	auto sortServers = [&](ServerSortMode mode) {
-		switch (mode) {
-		case ServerSortMode::PingAsc:
-			sort(displayList.begin(), displayList.end(), [](const PublicServerInfo &a, const PublicServerInfo &b) {
-				return a.averagePing < b.averagePing;
-			});
-			break;
-		case ServerSortMode::PingDesc:
-			sort(displayList.begin(), displayList.end(), [](const PublicServerInfo &a, const PublicServerInfo &b) {
-				return a.averagePing > b.averagePing;
-			});
-			break;
-		case ServerSortMode::PlayersAsc:
-			sort(displayList.begin(), displayList.end(), [](const PublicServerInfo &a, const PublicServerInfo &b) {
-				return a.currentPlayers < b.currentPlayers;
-			});
-			break;
-		case ServerSortMode::PlayersDesc:
-			sort(displayList.begin(), displayList.end(), [](const PublicServerInfo &a, const PublicServerInfo &b) {
-				return a.currentPlayers > b.currentPlayers;
-			});
-			break;
-		case ServerSortMode::None:
-		default: break;
-		}
-	};
-
-	if (g_serverSortMode == ServerSortMode::None && isSearching) {
-		sort(displayList.begin(), displayList.end(), [](const PublicServerInfo &a, const PublicServerInfo &b) {
-			return a.jobId < b.jobId;
-		});
-	} else {
-		sortServers(g_serverSortMode);
-	}
+	string qLower = toLower(s_searchBuffer);
+	bool isSearching = !qLower.empty();
+	if (!g_crawlMode) { syncPageView(isSearching); }
+	ServerListView &view = g_crawlMode ? g_crawlView : g_pageView;
+	view.setSortMode(g_serverSortMode);
+	view.setQuery(qLower);
+	const vector<uint32_t> &visibleRows = view.visible();
 
 	constexpr int columnCount = 4;
 	ImGuiTableFlags table_flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable
@@ -234,116 +385,133 @@ void RenderServersTab() {
 		float vertical_padding = (row_interaction_height - text_visual_height) * 0.5f;
 		vertical_padding = ImMax(0.0f, vertical_padding);
 
-		for (const auto &srv : displayList) {
+		if (g_loadingServers) {
 			TableNextRow();
-			PushID(srv.jobId.c_str());
-
 			TableNextColumn();
-			float cell1_start_y = GetCursorPosY();
-
-			char selectable_widget_id[128];
-			snprintf(selectable_widget_id, sizeof(selectable_widget_id), "##JobIDSelectable_%s", srv.jobId.c_str());
-
-			if (Selectable(
-					selectable_widget_id,
-					false,
-					ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowItemOverlap
-						| ImGuiSelectableFlags_AllowDoubleClick,
-					ImVec2(0, row_interaction_height)
-				)
-				&& IsMouseDoubleClicked(0)) {
-				if (!g_selectedAccountIds.empty()) {
-					vector<Roblox::HBA::AuthCredentials> accounts;
-					for (int id : g_selectedAccountIds) {
-						auto it = find_if(g_accounts.begin(), g_accounts.end(), [&](const AccountData &a) {
-							return a.id == id;
-						});
-						if (it != g_accounts.end() && AccountFilters::IsAccountUsable(*it)) {
-							accounts.push_back(AccountUtils::credentialsFromAccount(*it));
+			TextDisabled("Loading servers...");
+		}
+
+		ImGuiListClipper clipper;
+		clipper.Begin(static_cast<int>(visibleRows.size()));
+		while (clipper.Step()) {
+			for (int rowIndex = clipper.DisplayStart; rowIndex < clipper.DisplayEnd; ++rowIndex) {
+				const PublicServerInfo &srv = view.row(visibleRows[static_cast<size_t>(rowIndex)]);
+				TableNextRow();
+				PushID(srv.jobId.c_str());
+
+				TableNextColumn();
+				float cell1_start_y = GetCursorPosY();
+
+				char selectable_widget_id[128];
+				snprintf(selectable_widget_id, sizeof(selectable_widget_id), "##JobIDSelectable_%s", srv.jobId.c_str());
+
+				if (Selectable(
+						selectable_widget_id,
+						false,
+						ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowItemOverlap
+							| ImGuiSelectableFlags_AllowDoubleClick,
+						ImVec2(0, row_interaction_height)
+					)
+					&& IsMouseDoubleClicked(0)) {
+					if (!g_selectedAccountIds.empty()) {
+						vector<Roblox::HBA::AuthCredentials> accounts;
+						for (int id : g_selectedAccountIds) {
+							auto it = find_if(g_accounts.begin(), g_accounts.end(), [&](const AccountData &a) {
+								return a.id == id;
+							});
+							if (it != g_accounts.end() && AccountFilters::IsAccountUsable(*it)) {
+								accounts.push_back(AccountUtils::credentialsFromAccount(*it));
+							}
+						}
+						if (!accounts.empty()) {
+							LOG_INFO("Joining server (double-click)...");
+							thread([accounts, pId = g_current_placeId_servers, jId = srv.jobId]() {
+								launchRobloxSequential(pId, jId, accounts);
+							}).detach();
+						} else {
+							LOG_INFO("Selected account not found.");
 						}
-					}
-					if (!accounts.empty()) {
-						LOG_INFO("Joining server (double-click)...");
-						thread([accounts, pId = g_current_placeId_servers, jId = srv.jobId]() {
-							launchRobloxSequential(pId, jId, accounts);
-						}).detach();
 					} else {
-						LOG_INFO("Selected account not found.");
+						LOG_INFO("No account selected to join server.");
+						Status::Error("No account selected to join server.");
+						ModalPopup::Add("Select an account first.");
 					}
-				} else {
-					LOG_INFO("No account selected to join server.");
-					Status::Error("No account selected to join server.");
-					ModalPopup::Add("Select an account first.");
 				}
-			}
-
-			if (BeginPopupContextItem("ServerRowContextMenu")) {
-				StandardJoinMenuParams menu {};
-				menu.placeId = g_current_placeId_servers;
-				menu.universeId = g_targetUniverseId_ServersTab;
-				menu.jobId = srv.jobId;
-				menu.onLaunchGame = [pid = g_current_placeId_servers]() {
-					if (g_selectedAccountIds.empty()) { return; }
-					vector<Roblox::HBA::AuthCredentials> accounts;
-					for (int id : g_selectedAccountIds) {
-						auto it = find_if(g_accounts.begin(), g_accounts.end(), [&](const AccountData &a) {
-							return a.id == id && AccountFilters::IsAccountUsable(a);
-						});
-						if (it != g_accounts.end()) { accounts.push_back(AccountUtils::credentialsFromAccount(*it)); }
-					}
-					if (!accounts.empty()) {
-						thread([pid, accounts]() { launchRobloxSequential(pid, "", accounts); }).detach();
-					}
-				};
-				menu.onLaunchInstance = [pid = g_current_placeId_servers, jid = srv.jobId]() {
-					if (g_selectedAccountIds.empty()) { return; }
-					vector<Roblox::HBA::AuthCredentials> accounts;
-					for (int id : g_selectedAccountIds) {
-						auto it = find_if(g_accounts.begin(), g_accounts.end(), [&](const AccountData &a) {
-							return a.id == id && AccountFilters::IsAccountUsable(a);
-						});
-						if (it != g_accounts.end()) { accounts.push_back(AccountUtils::credentialsFromAccount(*it)); }
-					}
-					if (!accounts.empty()) {
-						thread([pid, jid, accounts]() { launchRobloxSequential(pid, jid, accounts); }).detach();
-					}
-				};
-				menu.onFillGame = [pid = g_current_placeId_servers]() { FillJoinOptions(pid, ""); };
-				menu.onFillInstance
-					= [pid = g_current_placeId_servers, jid = srv.jobId]() { FillJoinOptions(pid, jid); };
-				RenderStandardJoinMenu(menu);
-				EndPopup();
-			}
 
-			SetCursorPosY(cell1_start_y + vertical_padding);
-			TextUnformatted(srv.jobId.c_str());
-			SetCursorPosY(cell1_start_y + row_interaction_height);
-
-			TableNextColumn();
-			float cell2_start_y = GetCursorPosY();
-			SetCursorPosY(cell2_start_y + vertical_padding);
-			char playersBuf[16];
-			snprintf(playersBuf, sizeof(playersBuf), "%d/%d", srv.currentPlayers, srv.maximumPlayers);
-			TextUnformatted(playersBuf);
-			SetCursorPosY(cell2_start_y + row_interaction_height);
-
-			TableNextColumn();
-			float cell3_start_y = GetCursorPosY();
-			SetCursorPosY(cell3_start_y + vertical_padding);
-			char pingBuf[16];
-			snprintf(pingBuf, sizeof(pingBuf), "%.0f ms", srv.averagePing);
-			TextUnformatted(pingBuf);
-			SetCursorPosY(cell3_start_y + row_interaction_height);
+				if (BeginPopupContextItem("ServerRowContextMenu")) {
+					StandardJoinMenuParams menu {};
+					menu.placeId = g_current_placeId_servers;
+					menu.universeId = g_targetUniverseId_ServersTab;
+					menu.jobId = srv.jobId;
+					menu.onLaunchGame = [pid = g_current_placeId_servers]() {
+						if (g_selectedAccountIds.empty()) { return; }
+						vector<Roblox::HBA::AuthCredentials> accounts;
+						for (int id : g_selectedAccountIds) {
+							auto it = find_if(g_accounts.begin(), g_accounts.end(), [&](const AccountData &a) {
+								return a.id == id && AccountFilters::IsAccountUsable(a);
+							});
+							if (it != g_accounts.end()) {
+								accounts.push_back(AccountUtils::credentialsFromAccount(*it));
+							}
+						}
+						if (!accounts.empty()) {
+							thread([pid, accounts]() { launchRobloxSequential(pid, "", accounts); }).detach();
+						}
+					};
+					menu.onLaunchInstance = [pid = g_current_placeId_servers, jid = srv.jobId]() {
+						if (g_selectedAccountIds.empty()) { return; }
+						vector<Roblox::HBA::AuthCredentials> accounts;
+						for (int id : g_selectedAccountIds) {
+							auto it = find_if(g_accounts.begin(), g_accounts.end(), [&](const AccountData &a) {
+								return a.id == id && AccountFilters::IsAccountUsable(a);
+							});
+							if (it != g_accounts.end()) {
+								accounts.push_back(AccountUtils::credentialsFromAccount(*it));
+							}
+						}
+						if (!accounts.empty()) {
+							thread([pid, jid, accounts]() { launchRobloxSequential(pid, jid, accounts); }).detach();
+						}
+					};
+					menu.onLaunchBestServer
+						= [pid = g_current_placeId_servers]() { LaunchSelectedIntoBestServer(pid); };
+					menu.onFillGame = [pid = g_current_placeId_servers]() { FillJoinOptions(pid, ""); };
+					menu.onFillInstance
+						= [pid = g_current_placeId_servers, jid = srv.jobId]() { FillJoinOptions(pid, jid); };
+					RenderStandardJoinMenu(menu);
+					EndPopup();
+				}
 
-			TableNextColumn();
-			float cell4_start_y = GetCursorPosY();
-			SetCursorPosY(cell4_start_y + vertical_padding);
-			char fpsBuf[16];
-			snprintf(fpsBuf, sizeof(fpsBuf), "%.0f", srv.averageFps);
-			TextUnformatted(fpsBuf);
-			SetCursorPosY(cell4_start_y + row_interaction_height);
-
-			PopID();
+				SetCursorPosY(cell1_start_y + vertical_padding);
+				TextUnformatted(srv.jobId.c_str());
+				SetCursorPosY(cell1_start_y + row_interaction_height);
+
+				TableNextColumn();
+				float cell2_start_y = GetCursorPosY();
+				SetCursorPosY(cell2_start_y + vertical_padding);
+				char playersBuf[16];
+				snprintf(playersBuf, sizeof(playersBuf), "%d/%d", srv.currentPlayers, srv.maximumPlayers);
+				TextUnformatted(playersBuf);
+				SetCursorPosY(cell2_start_y + row_interaction_height);
+
+				TableNextColumn();
+				float cell3_start_y = GetCursorPosY();
+				SetCursorPosY(cell3_start_y + vertical_padding);
+				char pingBuf[16];
+				snprintf(pingBuf, sizeof(pingBuf), "%.0f ms", srv.averagePing);
+				TextUnformatted(pingBuf);
+				SetCursorPosY(cell3_start_y + row_interaction_height);
+
+				TableNextColumn();
+				float cell4_start_y = GetCursorPosY();
+				SetCursorPosY(cell4_start_y + vertical_padding);
+				char fpsBuf[16];
+				snprintf(fpsBuf, sizeof(fpsBuf), "%.0f", srv.averageFps);
+				TextUnformatted(fpsBuf);
+				SetCursorPosY(cell4_start_y + row_interaction_height);
+
+				PopID();
+			}
 		}
 		EndTable();
 	}
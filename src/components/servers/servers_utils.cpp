@@ -2,6 +2,12 @@
 #include <algorithm>
 #include <cctype>
 #include <string>
+#include <utility>
+#include <vector>
+
+#include "../../utils/core/account_utils.h"
+#include "../data.h"
+#include "server_finder.h"
 
 std::string toLower(std::string s) {
 	std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
@@ -14,3 +20,14 @@ bool containsCI(const std::string &haystack, const std::string &needle) {
 	std::string n_lower = toLower(needle);
 	return h_lower.find(n_lower) != std::string::npos;
 }
+
+void LaunchSelectedIntoBestServer(uint64_t placeId) {
+	std::vector<Roblox::HBA::AuthCredentials> accounts;
+	for (int id : g_selectedAccountIds) {
+		auto it = std::find_if(g_accounts.begin(), g_accounts.end(), [&](const AccountData &a) {
+			return a.id == id && AccountFilters::IsAccountUsable(a);
+		});
+		if (it != g_accounts.end()) { accounts.push_back(AccountUtils::credentialsFromAccount(*it)); }
+	}
+	LaunchIntoBestServer(placeId, std::move(accounts));
+}
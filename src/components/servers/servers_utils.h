@@ -1,7 +1,11 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 std::string toLower(std::string s);
 
 bool containsCI(const std::string &haystack, const std::string &needle);
+
+// "Best Server" join-menu action: launches the selected usable accounts into the place's best server
+void LaunchSelectedIntoBestServer(uint64_t placeId);
@@ -91,6 +91,39 @@ void RenderSettingsTab() {
 			Data::SaveSettings("settings.json");
 		}
 
+		bool binaryLogs = g_binaryLogFiles;
+		if (Checkbox("Binary log files", &binaryLogs)) {
+			g_binaryLogFiles = binaryLogs;
+			Data::SaveSettings("settings.json");
+		}
+		SameLine();
+		HelpMarker(
+			"Writes storage/logs/altman.bin instead of altman.log. Smaller and cheaper to write; "
+			"read it back with the log_decode tool. Takes effect after a restart."
+		);
+
+		bool typeAhead = g_gameSearchTypeAhead;
+		if (Checkbox("Search games as you type", &typeAhead)) {
+			g_gameSearchTypeAhead = typeAhead;
+			Data::SaveSettings("settings.json");
+		}
+		SameLine();
+		HelpMarker("Runs the Games tab search once you stop typing, without pressing Search.");
+
+		int thumbnailBudget = g_thumbnailMemoryBudgetMb;
+		if (InputInt("Thumbnail memory (MB)", &thumbnailBudget)) {
+			if (thumbnailBudget < 16) { thumbnailBudget = 16; }
+			if (thumbnailBudget != g_thumbnailMemoryBudgetMb) {
+				g_thumbnailMemoryBudgetMb = thumbnailBudget;
+				Data::SaveSettings("settings.json");
+			}
+		}
+		SameLine();
+		HelpMarker(
+			"Texture memory the Inventory tab keeps for item thumbnails. Thumbnails that have not been on screen "
+			"for a while are freed past this and reloaded from the disk cache when needed."
+		);
+
 		Spacing();
 		SeparatorText("Launch Options");
 		bool multi = g_multiRobloxEnabled;
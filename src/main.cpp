@@ -5,33 +5,42 @@
 #define IDI_ICON_32 102
 
 #define _CRT_SECURE_NO_WARNINGS
-#define STB_IMAGE_IMPLEMENTATION
 
 #include "../ui.h"
 #include "imgui.h"
 #include "imgui_impl_dx11.h"
 #include "imgui_impl_win32.h"
-#include "stb_image.h"
 #include <d3d11.h>
 #include <dwmapi.h>
 #include <objbase.h>
 #include <tchar.h>
 
+#include "components/avatar/thumbnail_cache.h"
 #include "components/data.h"
+#include "components/friends/presence_watcher.h"
+#include "components/history/log_parser.h"
+#include "components/history/log_watcher.h"
 #include <filesystem>
 #include "core/account_utils.h"
 #include "core/app_state.h"
+#include "core/image_decode.h"
 #include "core/logging.hpp"
+#include "core/structured_log.h"
 #include "network/roblox.h"
 #include "system/multi_instance.h"
 #include "system/main_thread.h"
 #include "system/update.h"
 #include "ui/confirm.h"
+#include "ui/image.h"
 #include "ui/notifications.h"
 #include <algorithm>
 #include <chrono>
 #include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include <windows.h>
 
@@ -102,25 +111,14 @@ void ReloadFonts(float dpiScale) {
 	}
 }
 
-bool LoadTextureFromMemory(
-	const void *data,
-	size_t data_size,
-	ID3D11ShaderResourceView **out_srv,
-	int *out_width,
-	int *out_height
-) {
-	// Load from disk into a raw RGBA buffer
-	int image_width = 0;
-	int image_height = 0;
-	unsigned char *image_data
-		= stbi_load_from_memory((const unsigned char *)data, (int)data_size, &image_width, &image_height, NULL, 4);
-	if (image_data == NULL) { return false; }
+bool CreateTextureFromImage(const DecodedImage &image, ID3D11ShaderResourceView **out_srv) {
+	if (image.width <= 0 || image.height <= 0 || image.rgba.empty()) { return false; }
 
 	// Create texture
 	D3D11_TEXTURE2D_DESC desc;
 	ZeroMemory(&desc, sizeof(desc));
-	desc.Width = image_width;
-	desc.Height = image_height;
+	desc.Width = image.width;
+	desc.Height = image.height;
 	desc.MipLevels = 1;
 	desc.ArraySize = 1;
 	desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
@@ -131,10 +129,10 @@ bool LoadTextureFromMemory(
 
 	ID3D11Texture2D *pTexture = NULL;
 	D3D11_SUBRESOURCE_DATA subResource;
-	subResource.pSysMem = image_data;
+	subResource.pSysMem = image.rgba.data();
 	subResource.SysMemPitch = desc.Width * 4;
 	subResource.SysMemSlicePitch = 0;
-	g_pd3dDevice->CreateTexture2D(&desc, &subResource, &pTexture);
+	if (FAILED(g_pd3dDevice->CreateTexture2D(&desc, &subResource, &pTexture))) { return false; }
 
 	// Create texture view
 	D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc;
@@ -143,13 +141,22 @@ bool LoadTextureFromMemory(
 	srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
 	srvDesc.Texture2D.MipLevels = desc.MipLevels;
 	srvDesc.Texture2D.MostDetailedMip = 0;
-	g_pd3dDevice->CreateShaderResourceView(pTexture, &srvDesc, out_srv);
+	HRESULT hr = g_pd3dDevice->CreateShaderResourceView(pTexture, &srvDesc, out_srv);
 	pTexture->Release();
+	return SUCCEEDED(hr);
+}
 
-	*out_width = image_width;
-	*out_height = image_height;
-	stbi_image_free(image_data);
-
+bool LoadTextureFromMemory(
+	const void *data,
+	size_t data_size,
+	ID3D11ShaderResourceView **out_srv,
+	int *out_width,
+	int *out_height
+) {
+	DecodedImage image;
+	if (!DecodeImage(data, data_size, image) || !CreateTextureFromImage(image, out_srv)) { return false; }
+	*out_width = image.width;
+	*out_height = image.height;
 	return true;
 }
 
@@ -169,6 +176,64 @@ bool LoadTextureFromFile(const char *file_name, ID3D11ShaderResourceView **out_s
 	return ret;
 }
 
+// Set and cleared on the main thread while refreshAccounts rewrites accounts on its own thread. Presence updates run
+// on the main thread too, so each one either finished before the refresh started or sees the flag and stands aside.
+static bool g_accountsRefreshing = false;
+
+static void setAccountsRefreshing(bool refreshing) {
+	std::promise<void> done;
+	MainThread::Post([&done, refreshing]() {
+		g_accountsRefreshing = refreshing;
+		done.set_value();
+	});
+	done.get_future().wait();
+}
+
+// Between status refreshes the presence of every signed-in account is kept current by the presence watcher. All of
+// them form one set asked about with the first signed-in account's cookie, so 100 accounts cost one request per
+// cycle. That cookie may not be allowed to see where another account is playing, so a location the refresh found is
+// kept while the account stays in the same state; the next refresh, which asks with each account's own cookie,
+// corrects it. Accounts whose status is not a presence (banned, invalid cookie, ...) are left to the next refresh.
+static void watchAccountsPresence() {
+	std::unordered_map<uint64_t, Roblox::PresenceData> known;
+	const AccountData *asker = nullptr;
+	for (const auto &acct : g_accounts) {
+		bool isPresence = acct.status == "Online" || acct.status == "InGame" || acct.status == "InStudio"
+						  || acct.status == "Offline" || acct.status == "Invisible";
+		uint64_t userId = std::strtoull(acct.userId.c_str(), nullptr, 10);
+		if (acct.cookie.empty() || !isPresence || userId == 0) { continue; }
+		known[userId] = {acct.status, acct.lastLocation, acct.placeId, acct.jobId};
+		if (!asker) { asker = &acct; }
+	}
+	if (!asker) {
+		PresenceWatcher::Unwatch("accounts");
+		return;
+	}
+
+	PresenceWatcher::Watch(
+		"accounts",
+		std::move(known),
+		AccountUtils::credentialsFromAccount(*asker).toAuthConfig(),
+		[](const std::vector<PresenceWatcher::Change> &changes) {
+			// The refresh re-watches with what it found once it is done
+			if (g_accountsRefreshing) { return; }
+			for (const auto &change : changes) {
+				std::string userId = std::to_string(change.userId);
+				for (auto &acct : g_accounts) {
+					if (acct.userId != userId || !AccountFilters::IsAccountUsable(acct)) { continue; }
+					const Roblox::PresenceData &presence = change.presence;
+					bool locationHidden = presence.placeId == 0 && presence.presence == acct.status;
+					acct.status = presence.presence;
+					if (locationHidden) { continue; }
+					acct.lastLocation = presence.lastLocation;
+					acct.placeId = presence.placeId;
+					acct.jobId = presence.jobId;
+				}
+			}
+		}
+	);
+}
+
 LRESULT WINAPI WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
 
 int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow) {
@@ -195,6 +260,12 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
 	}
 
 	Data::LoadSettings("settings.json");
+
+	// Persist the log next to the other storage files; anything logged before this point is still queued
+	StructuredLog::Options logOptions;
+	logOptions.directory = Data::StorageFilePath("logs");
+	logOptions.binary = g_binaryLogFiles;
+	StructuredLog::Start(logOptions);
 #ifdef _WIN32
 	if (g_multiRobloxEnabled) { MultiInstance::Enable(); }
 #endif
@@ -203,6 +274,11 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
 	Data::LoadFavorites("favorites.json");
 	Data::LoadFriends("friends.json");
 
+	// Tail the Roblox client's logs so new joins show up without a rescan
+	LogWatcher::Start(logsFolder());
+	// Read the thumbnail cache index in the background; thumbnails requested before it is ready are downloaded
+	SharedThumbnailDiskCache().startLoading();
+
 	// Migrate existing accounts to HBA (generate keys if missing)
 	int migratedCount = AccountUtils::migrateAccountsToHBA(g_accounts);
 	if (migratedCount > 0) {
@@ -211,6 +287,7 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
 	}
 
 	auto refreshAccounts = [] {
+		setAccountsRefreshing(true);
 		std::vector<int> invalidIds;
 		std::string names;
 		for (auto &acct : g_accounts) {
@@ -342,6 +419,10 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
 		}
 		Data::SaveAccounts();
 		LOG_INFO("Loaded accounts and refreshed statuses");
+		MainThread::Post([]() {
+			g_accountsRefreshing = false;
+			watchAccountsPresence();
+		});
 
 		if (!invalidIds.empty()) {
 			std::string namesCopy = names;
@@ -453,6 +534,7 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
 		if (done) { break; }
 
 		MainThread::Process();
+		TextureUploads::Process();
 
 		if (g_SwapChainOccluded && g_pSwapChain->Present(0, DXGI_PRESENT_TEST) == DXGI_STATUS_OCCLUDED) {
 			Sleep(10);
@@ -494,6 +576,11 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
 		g_SwapChainOccluded = (hr_present == DXGI_STATUS_OCCLUDED);
 	}
 
+	LogWatcher::Stop();
+	// Index the files downloaded since the last scheduled save, or the next start deletes them as orphans
+	SharedThumbnailDiskCache().flush();
+	StructuredLog::Stop();
+
 	ImGui_ImplDX11_Shutdown();
 	ImGui_ImplWin32_Shutdown();
 	ImGui::DestroyContext();
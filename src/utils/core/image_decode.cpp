@@ -0,0 +1,23 @@
+#include "image_decode.h"
+
+#include <climits>
+#include <cstring>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+bool DecodeImage(const void *data, size_t size, DecodedImage &out) {
+	if (!data || size == 0 || size > INT_MAX) { return false; }
+	int width = 0;
+	int height = 0;
+	const auto *bytes = static_cast<const unsigned char *>(data);
+	unsigned char *pixels = stbi_load_from_memory(bytes, static_cast<int>(size), &width, &height, nullptr, 4);
+	if (!pixels) { return false; }
+
+	out.width = width;
+	out.height = height;
+	out.rgba.resize(static_cast<size_t>(width) * height * 4);
+	std::memcpy(out.rgba.data(), pixels, out.rgba.size());
+	stbi_image_free(pixels);
+	return true;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Tightly packed 8-bit RGBA pixels, rows top to bottom
+struct DecodedImage {
+		int width = 0;
+		int height = 0;
+		std::vector<uint8_t> rgba;
+
+		size_t bytes() const { return rgba.size(); }
+};
+
+// Decodes a PNG/JPEG/BMP/... image to RGBA. Thread-safe and free of any graphics API, so thumbnails are decoded on
+// worker threads and only the finished pixels reach the main thread for upload.
+bool DecodeImage(const void *data, size_t size, DecodedImage &out);
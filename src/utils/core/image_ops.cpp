@@ -0,0 +1,495 @@
+#include "image_ops.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define IMAGE_OPS_X64 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define IMAGE_OPS_AVX2
+#else
+#define IMAGE_OPS_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace ImageOps {
+	namespace {
+		std::atomic<int> g_level {-1};
+
+		// round(x / 255) for x up to 255 * 255, without a division
+		inline uint8_t div255(unsigned x) {
+			x += 128;
+			return static_cast<uint8_t>((x + (x >> 8)) >> 8);
+		}
+
+		// Source pixel pairs and weights (of 256) for one axis of a bilinear resample, shared by every level
+		struct Taps {
+				std::vector<int32_t> first;
+				std::vector<int32_t> second;
+				std::vector<uint16_t> weight; // Weight of second, repeated for each of the 4 channels
+		};
+
+		Taps makeTaps(int srcSize, int dstSize) {
+			Taps taps;
+			taps.first.resize(dstSize);
+			taps.second.resize(dstSize);
+			taps.weight.resize(static_cast<size_t>(dstSize) * 4);
+			double ratio = static_cast<double>(srcSize) / dstSize;
+			for (int i = 0; i < dstSize; ++i) {
+				double pos = std::clamp((i + 0.5) * ratio - 0.5, 0.0, static_cast<double>(srcSize - 1));
+				int first = static_cast<int>(pos);
+				auto weight = static_cast<uint16_t>(std::lround((pos - first) * 256));
+				taps.first[i] = first;
+				taps.second[i] = (std::min)(first + 1, srcSize - 1);
+				std::fill_n(&taps.weight[static_cast<size_t>(i) * 4], 4, weight);
+			}
+			return taps;
+		}
+
+		// --- Scalar reference ---
+
+		void premultiplyScalar(uint8_t *p, size_t pixels) {
+			for (size_t i = 0; i < pixels; ++i, p += 4) {
+				unsigned a = p[3];
+				p[0] = div255(p[0] * a);
+				p[1] = div255(p[1] * a);
+				p[2] = div255(p[2] * a);
+			}
+		}
+
+		void unpremultiplyScalar(uint8_t *p, size_t pixels) {
+			for (size_t i = 0; i < pixels; ++i, p += 4) {
+				float scale = p[3] ? 255.0f / p[3] : 0.0f;
+				for (int c = 0; c < 3; ++c) {
+					float v = static_cast<float>(p[c]) * scale;
+					p[c] = static_cast<uint8_t>((std::min)(v + 0.5f, 255.0f));
+				}
+			}
+		}
+
+		void halveRowScalar(const uint8_t *r0, const uint8_t *r1, uint8_t *dst, int dstWidth) {
+			for (int x = 0; x < dstWidth; ++x) {
+				for (int c = 0; c < 4; ++c) {
+					int i = x * 8 + c;
+					dst[x * 4 + c] = static_cast<uint8_t>((r0[i] + r0[i + 4] + r1[i] + r1[i + 4] + 2) >> 2);
+				}
+			}
+		}
+
+		void lerpRowsScalar(const uint8_t *r0, const uint8_t *r1, unsigned weight, uint8_t *dst, size_t bytes) {
+			unsigned inverse = 256 - weight;
+			for (size_t i = 0; i < bytes; ++i) {
+				dst[i] = static_cast<uint8_t>((r0[i] * inverse + r1[i] * weight + 128) >> 8);
+			}
+		}
+
+		void resampleRowScalar(const uint8_t *src, const Taps &taps, int begin, int end, uint8_t *dst) {
+			for (int x = begin; x < end; ++x) {
+				const uint8_t *a = src + taps.first[x] * 4;
+				const uint8_t *b = src + taps.second[x] * 4;
+				unsigned weight = taps.weight[static_cast<size_t>(x) * 4];
+				unsigned inverse = 256 - weight;
+				for (int c = 0; c < 4; ++c) {
+					dst[x * 4 + c] = static_cast<uint8_t>((a[c] * inverse + b[c] * weight + 128) >> 8);
+				}
+			}
+		}
+
+#if IMAGE_OPS_X64
+		// --- SSE2, part of every x64 CPU ---
+
+		inline __m128i div255Sse2(__m128i x) {
+			x = _mm_add_epi16(x, _mm_set1_epi16(128));
+			return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+		}
+
+		inline __m128i alphaOfSse2(__m128i pixels16) {
+			return _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels16, 0xFF), 0xFF);
+		}
+
+		void premultiplySse2(uint8_t *p, size_t pixels) {
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+			size_t i = 0;
+			for (; i + 4 <= pixels; i += 4, p += 16) {
+				__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+				__m128i lo = _mm_unpacklo_epi8(v, zero);
+				__m128i hi = _mm_unpackhi_epi8(v, zero);
+				lo = div255Sse2(_mm_mullo_epi16(lo, alphaOfSse2(lo)));
+				hi = div255Sse2(_mm_mullo_epi16(hi, alphaOfSse2(hi)));
+				__m128i out = _mm_packus_epi16(lo, hi);
+				out = _mm_or_si128(_mm_andnot_si128(alphaMask, out), _mm_and_si128(alphaMask, v));
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(p), out);
+			}
+			premultiplyScalar(p, pixels - i);
+		}
+
+		// One pixel as four floats; the same operations as unpremultiplyScalar, so the results match bit for bit
+		inline __m128i unpremultiplyPixelSse2(__m128i pixel32) {
+			__m128 v = _mm_cvtepi32_ps(pixel32);
+			__m128 alpha = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+			__m128 scale = _mm_and_ps(_mm_div_ps(_mm_set1_ps(255.0f), alpha), _mm_cmpgt_ps(alpha, _mm_setzero_ps()));
+			v = _mm_min_ps(_mm_add_ps(_mm_mul_ps(v, scale), _mm_set1_ps(0.5f)), _mm_set1_ps(255.0f));
+			return _mm_cvttps_epi32(v);
+		}
+
+		void unpremultiplySse2(uint8_t *p, size_t pixels) {
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+			size_t i = 0;
+			for (; i + 4 <= pixels; i += 4, p += 16) {
+				__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+				__m128i lo = _mm_unpacklo_epi8(v, zero);
+				__m128i hi = _mm_unpackhi_epi8(v, zero);
+				__m128i p0 = unpremultiplyPixelSse2(_mm_unpacklo_epi16(lo, zero));
+				__m128i p1 = unpremultiplyPixelSse2(_mm_unpackhi_epi16(lo, zero));
+				__m128i p2 = unpremultiplyPixelSse2(_mm_unpacklo_epi16(hi, zero));
+				__m128i p3 = unpremultiplyPixelSse2(_mm_unpackhi_epi16(hi, zero));
+				__m128i out = _mm_packus_epi16(_mm_packs_epi32(p0, p1), _mm_packs_epi32(p2, p3));
+				out = _mm_or_si128(_mm_andnot_si128(alphaMask, out), _mm_and_si128(alphaMask, v));
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(p), out);
+			}
+			unpremultiplyScalar(p, pixels - i);
+		}
+
+		void halveRowSse2(const uint8_t *r0, const uint8_t *r1, uint8_t *dst, int dstWidth) {
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i two = _mm_set1_epi16(2);
+			int x = 0;
+			for (; x + 2 <= dstWidth; x += 2) {
+				__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(r0 + x * 8));
+				__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(r1 + x * 8));
+				// Column sums of source pixels 0,1 and 2,3, then each pair added across
+				__m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+				__m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+				lo = _mm_add_epi16(lo, _mm_srli_si128(lo, 8));
+				hi = _mm_add_epi16(hi, _mm_srli_si128(hi, 8));
+				__m128i sum = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(lo, hi), two), 2);
+				_mm_storel_epi64(reinterpret_cast<__m128i *>(dst + x * 4), _mm_packus_epi16(sum, sum));
+			}
+			halveRowScalar(r0 + x * 8, r1 + x * 8, dst + x * 4, dstWidth - x);
+		}
+
+		inline __m128i lerpSse2(__m128i a, __m128i b, __m128i inverse, __m128i weight) {
+			__m128i sum = _mm_add_epi16(_mm_mullo_epi16(a, inverse), _mm_mullo_epi16(b, weight));
+			return _mm_srli_epi16(_mm_add_epi16(sum, _mm_set1_epi16(128)), 8);
+		}
+
+		void lerpRowsSse2(const uint8_t *r0, const uint8_t *r1, unsigned weight, uint8_t *dst, size_t bytes) {
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i w1 = _mm_set1_epi16(static_cast<short>(weight));
+			const __m128i w0 = _mm_set1_epi16(static_cast<short>(256 - weight));
+			size_t i = 0;
+			for (; i + 16 <= bytes; i += 16) {
+				__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(r0 + i));
+				__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(r1 + i));
+				__m128i lo = lerpSse2(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero), w0, w1);
+				__m128i hi = lerpSse2(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero), w0, w1);
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_packus_epi16(lo, hi));
+			}
+			lerpRowsScalar(r0 + i, r1 + i, weight, dst + i, bytes - i);
+		}
+
+		inline __m128i loadPixelSse2(const uint8_t *p) {
+			int32_t v;
+			std::memcpy(&v, p, 4);
+			return _mm_cvtsi32_si128(v);
+		}
+
+		void resampleRowSse2(const uint8_t *src, const Taps &taps, int begin, int end, uint8_t *dst) {
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i full = _mm_set1_epi16(256);
+			int x = begin;
+			for (; x + 2 <= end; x += 2) {
+				__m128i a = _mm_unpacklo_epi32(
+					loadPixelSse2(src + taps.first[x] * 4),
+					loadPixelSse2(src + taps.first[x + 1] * 4)
+				);
+				__m128i b = _mm_unpacklo_epi32(
+					loadPixelSse2(src + taps.second[x] * 4),
+					loadPixelSse2(src + taps.second[x + 1] * 4)
+				);
+				__m128i weight = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&taps.weight[x * 4]));
+				__m128i inverse = _mm_sub_epi16(full, weight);
+				__m128i out = lerpSse2(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero), inverse, weight);
+				_mm_storel_epi64(reinterpret_cast<__m128i *>(dst + x * 4), _mm_packus_epi16(out, out));
+			}
+			resampleRowScalar(src, taps, x, end, dst);
+		}
+
+		// --- AVX2, checked at run time. 256-bit unpack and pack work within each 128-bit half, so results that
+		// must be contiguous are put back in order with a permute. ---
+
+		IMAGE_OPS_AVX2 inline __m256i div255Avx2(__m256i x) {
+			x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+			return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+		}
+
+		IMAGE_OPS_AVX2 inline __m256i alphaOfAvx2(__m256i pixels16) {
+			return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(pixels16, 0xFF), 0xFF);
+		}
+
+		IMAGE_OPS_AVX2 void premultiplyAvx2(uint8_t *p, size_t pixels) {
+			const __m256i zero = _mm256_setzero_si256();
+			const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+			size_t i = 0;
+			for (; i + 8 <= pixels; i += 8, p += 32) {
+				__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+				__m256i lo = _mm256_unpacklo_epi8(v, zero);
+				__m256i hi = _mm256_unpackhi_epi8(v, zero);
+				lo = div255Avx2(_mm256_mullo_epi16(lo, alphaOfAvx2(lo)));
+				hi = div255Avx2(_mm256_mullo_epi16(hi, alphaOfAvx2(hi)));
+				__m256i out = _mm256_packus_epi16(lo, hi);
+				out = _mm256_or_si256(_mm256_andnot_si256(alphaMask, out), _mm256_and_si256(alphaMask, v));
+				_mm256_storeu_si256(reinterpret_cast<__m256i *>(p), out);
+			}
+			premultiplySse2(p, pixels - i);
+		}
+
+		// Two pixels as eight floats
+		IMAGE_OPS_AVX2 inline __m256i unpremultiplyPixelsAvx2(const uint8_t *p) {
+			__m256 v = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p))));
+			__m256 alpha = _mm256_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+			__m256 scale = _mm256_and_ps(
+				_mm256_div_ps(_mm256_set1_ps(255.0f), alpha),
+				_mm256_cmp_ps(alpha, _mm256_setzero_ps(), _CMP_GT_OQ)
+			);
+			v = _mm256_min_ps(_mm256_add_ps(_mm256_mul_ps(v, scale), _mm256_set1_ps(0.5f)), _mm256_set1_ps(255.0f));
+			return _mm256_cvttps_epi32(v);
+		}
+
+		IMAGE_OPS_AVX2 void unpremultiplyAvx2(uint8_t *p, size_t pixels) {
+			const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+			// Packing leaves the pixels as 0 2 4 6 | 1 3 5 7
+			const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+			size_t i = 0;
+			for (; i + 8 <= pixels; i += 8, p += 32) {
+				__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+				__m256i p01 = unpremultiplyPixelsAvx2(p);
+				__m256i p23 = unpremultiplyPixelsAvx2(p + 8);
+				__m256i p45 = unpremultiplyPixelsAvx2(p + 16);
+				__m256i p67 = unpremultiplyPixelsAvx2(p + 24);
+				__m256i out = _mm256_packus_epi16(_mm256_packs_epi32(p01, p23), _mm256_packs_epi32(p45, p67));
+				out = _mm256_permutevar8x32_epi32(out, order);
+				out = _mm256_or_si256(_mm256_andnot_si256(alphaMask, out), _mm256_and_si256(alphaMask, v));
+				_mm256_storeu_si256(reinterpret_cast<__m256i *>(p), out);
+			}
+			unpremultiplySse2(p, pixels - i);
+		}
+
+		IMAGE_OPS_AVX2 void halveRowAvx2(const uint8_t *r0, const uint8_t *r1, uint8_t *dst, int dstWidth) {
+			// Interleaves the channels of each pixel pair (r0 r1 g0 g1 ...) so one multiply-add sums the pair
+			const __m256i pairs = _mm256_setr_epi8(
+				0, 4, 1, 5, 2, 6, 3, 7, 8, 12, 9, 13, 10, 14, 11, 15,
+				0, 4, 1, 5, 2, 6, 3, 7, 8, 12, 9, 13, 10, 14, 11, 15
+			);
+			const __m256i ones = _mm256_set1_epi8(1);
+			const __m256i two = _mm256_set1_epi16(2);
+			int x = 0;
+			for (; x + 4 <= dstWidth; x += 4) {
+				__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(r0 + x * 8));
+				__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(r1 + x * 8));
+				a = _mm256_maddubs_epi16(_mm256_shuffle_epi8(a, pairs), ones);
+				b = _mm256_maddubs_epi16(_mm256_shuffle_epi8(b, pairs), ones);
+				__m256i sum = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(a, b), two), 2);
+				__m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(sum, sum), _MM_SHUFFLE(3, 1, 2, 0));
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x * 4), _mm256_castsi256_si128(packed));
+			}
+			halveRowSse2(r0 + x * 8, r1 + x * 8, dst + x * 4, dstWidth - x);
+		}
+
+		IMAGE_OPS_AVX2 inline __m256i lerpAvx2(__m256i a, __m256i b, __m256i inverse, __m256i weight) {
+			__m256i sum = _mm256_add_epi16(_mm256_mullo_epi16(a, inverse), _mm256_mullo_epi16(b, weight));
+			return _mm256_srli_epi16(_mm256_add_epi16(sum, _mm256_set1_epi16(128)), 8);
+		}
+
+		IMAGE_OPS_AVX2 void
+			lerpRowsAvx2(const uint8_t *r0, const uint8_t *r1, unsigned weight, uint8_t *dst, size_t bytes) {
+			const __m256i zero = _mm256_setzero_si256();
+			const __m256i w1 = _mm256_set1_epi16(static_cast<short>(weight));
+			const __m256i w0 = _mm256_set1_epi16(static_cast<short>(256 - weight));
+			size_t i = 0;
+			for (; i + 32 <= bytes; i += 32) {
+				__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(r0 + i));
+				__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(r1 + i));
+				__m256i lo = lerpAvx2(_mm256_unpacklo_epi8(a, zero), _mm256_unpacklo_epi8(b, zero), w0, w1);
+				__m256i hi = lerpAvx2(_mm256_unpackhi_epi8(a, zero), _mm256_unpackhi_epi8(b, zero), w0, w1);
+				_mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_packus_epi16(lo, hi));
+			}
+			lerpRowsSse2(r0 + i, r1 + i, weight, dst + i, bytes - i);
+		}
+#endif
+
+		void halveRow(const uint8_t *r0, const uint8_t *r1, uint8_t *dst, int dstWidth) {
+			switch (ActiveSimdLevel()) {
+#if IMAGE_OPS_X64
+			case SimdLevel::Avx2: halveRowAvx2(r0, r1, dst, dstWidth); return;
+			case SimdLevel::Sse2: halveRowSse2(r0, r1, dst, dstWidth); return;
+#endif
+			default: halveRowScalar(r0, r1, dst, dstWidth); return;
+			}
+		}
+
+		void lerpRows(const uint8_t *r0, const uint8_t *r1, unsigned weight, uint8_t *dst, size_t bytes) {
+			switch (ActiveSimdLevel()) {
+#if IMAGE_OPS_X64
+			case SimdLevel::Avx2: lerpRowsAvx2(r0, r1, weight, dst, bytes); return;
+			case SimdLevel::Sse2: lerpRowsSse2(r0, r1, weight, dst, bytes); return;
+#endif
+			default: lerpRowsScalar(r0, r1, weight, dst, bytes); return;
+			}
+		}
+
+		void resampleRow(const uint8_t *src, const Taps &taps, int width, uint8_t *dst) {
+			switch (ActiveSimdLevel()) {
+#if IMAGE_OPS_X64
+			// An AVX2 version needs gathers for the scattered taps, which measured slower than these scalar loads
+			case SimdLevel::Avx2:
+			case SimdLevel::Sse2: resampleRowSse2(src, taps, 0, width, dst); return;
+#endif
+			default: resampleRowScalar(src, taps, 0, width, dst); return;
+			}
+		}
+	} // namespace
+
+	SimdLevel DetectSimdLevel() {
+#if IMAGE_OPS_X64
+#if defined(_MSC_VER) && !defined(__clang__)
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7) { return SimdLevel::Sse2; }
+		__cpuid(info, 1);
+		bool osSavesAvx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6;
+		__cpuidex(info, 7, 0);
+		return osSavesAvx && (info[1] & (1 << 5)) ? SimdLevel::Avx2 : SimdLevel::Sse2;
+#else
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2") ? SimdLevel::Avx2 : SimdLevel::Sse2;
+#endif
+#else
+		return SimdLevel::Scalar;
+#endif
+	}
+
+	SimdLevel ActiveSimdLevel() {
+		int level = g_level.load(std::memory_order_relaxed);
+		if (level < 0) {
+			level = static_cast<int>(DetectSimdLevel());
+			g_level.store(level, std::memory_order_relaxed);
+		}
+		return static_cast<SimdLevel>(level);
+	}
+
+	void SetSimdLevel(SimdLevel level) {
+		level = (std::min)(level, DetectSimdLevel());
+		g_level.store(static_cast<int>(level), std::memory_order_relaxed);
+	}
+
+	const char *SimdLevelName(SimdLevel level) {
+		switch (level) {
+		case SimdLevel::Avx2: return "avx2";
+		case SimdLevel::Sse2: return "sse2";
+		case SimdLevel::Scalar:
+		default: return "scalar";
+		}
+	}
+
+	void PremultiplyAlpha(uint8_t *rgba, size_t pixels) {
+		switch (ActiveSimdLevel()) {
+#if IMAGE_OPS_X64
+		case SimdLevel::Avx2: premultiplyAvx2(rgba, pixels); return;
+		case SimdLevel::Sse2: premultiplySse2(rgba, pixels); return;
+#endif
+		default: premultiplyScalar(rgba, pixels); return;
+		}
+	}
+
+	void UnpremultiplyAlpha(uint8_t *rgba, size_t pixels) {
+		switch (ActiveSimdLevel()) {
+#if IMAGE_OPS_X64
+		case SimdLevel::Avx2: unpremultiplyAvx2(rgba, pixels); return;
+		case SimdLevel::Sse2: unpremultiplySse2(rgba, pixels); return;
+#endif
+		default: unpremultiplyScalar(rgba, pixels); return;
+		}
+	}
+
+	void HalveImage(const uint8_t *src, int srcWidth, int srcHeight, uint8_t *dst) {
+		int dstWidth = (std::max)(1, srcWidth / 2);
+		int dstHeight = (std::max)(1, srcHeight / 2);
+		size_t srcStride = static_cast<size_t>(srcWidth) * 4;
+		for (int y = 0; y < dstHeight; ++y) {
+			const uint8_t *r0 = src + static_cast<size_t>(y) * 2 * srcStride;
+			const uint8_t *r1 = src + static_cast<size_t>((std::min)(y * 2 + 1, srcHeight - 1)) * srcStride;
+			uint8_t *out = dst + static_cast<size_t>(y) * dstWidth * 4;
+			if (srcWidth >= 2) {
+				halveRow(r0, r1, out, dstWidth);
+			} else {
+				// A one pixel wide column only averages vertically
+				for (int c = 0; c < 4; ++c) { out[c] = static_cast<uint8_t>((r0[c] + r1[c] + 1) >> 1); }
+			}
+		}
+	}
+
+	void ResizeBilinear(const uint8_t *src, int srcWidth, int srcHeight, uint8_t *dst, int dstWidth, int dstHeight) {
+		Taps columns = makeTaps(srcWidth, dstWidth);
+		Taps rows = makeTaps(srcHeight, dstHeight);
+		size_t srcStride = static_cast<size_t>(srcWidth) * 4;
+		std::vector<uint8_t> row(srcStride);
+		for (int y = 0; y < dstHeight; ++y) {
+			lerpRows(
+				src + rows.first[y] * srcStride,
+				src + rows.second[y] * srcStride,
+				rows.weight[static_cast<size_t>(y) * 4],
+				row.data(),
+				srcStride
+			);
+			resampleRow(row.data(), columns, dstWidth, dst + static_cast<size_t>(y) * dstWidth * 4);
+		}
+	}
+
+	void PrepareForDisplay(DecodedImage &image, int maxEdge) {
+		int width = image.width;
+		int height = image.height;
+		if (width <= 0 || height <= 0 || image.rgba.size() != static_cast<size_t>(width) * height * 4) { return; }
+
+		int targetWidth = width;
+		int targetHeight = height;
+		if (maxEdge > 0 && (std::max)(width, height) > maxEdge) {
+			double scale = static_cast<double>(maxEdge) / (std::max)(width, height);
+			targetWidth = (std::max)(1, static_cast<int>(std::lround(width * scale)));
+			targetHeight = (std::max)(1, static_cast<int>(std::lround(height * scale)));
+		}
+		if (targetWidth == width && targetHeight == height) { return; }
+
+		std::vector<uint8_t> pixels = std::move(image.rgba);
+		PremultiplyAlpha(pixels.data(), static_cast<size_t>(width) * height);
+
+		// Halve while that stays at or above the target, then one bilinear step covers the remaining ratio below 2
+		while (width / 2 >= targetWidth && height / 2 >= targetHeight) {
+			std::vector<uint8_t> half(static_cast<size_t>(width / 2) * (height / 2) * 4);
+			HalveImage(pixels.data(), width, height, half.data());
+			pixels = std::move(half);
+			width /= 2;
+			height /= 2;
+		}
+		if (width != targetWidth || height != targetHeight) {
+			std::vector<uint8_t> resized(static_cast<size_t>(targetWidth) * targetHeight * 4);
+			ResizeBilinear(pixels.data(), width, height, resized.data(), targetWidth, targetHeight);
+			pixels = std::move(resized);
+			width = targetWidth;
+			height = targetHeight;
+		}
+
+		UnpremultiplyAlpha(pixels.data(), static_cast<size_t>(width) * height);
+		image.rgba = std::move(pixels);
+		image.width = width;
+		image.height = height;
+	}
+} // namespace ImageOps
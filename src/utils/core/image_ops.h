@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "image_decode.h"
+
+// Pixel kernels for preparing decoded images for upload. Each has a scalar version and, on x64, SSE2 and AVX2 versions
+// that produce the same bytes; the widest one the CPU supports is used unless SetSimdLevel picks another.
+namespace ImageOps {
+	enum class SimdLevel { Scalar, Sse2, Avx2 };
+
+	// Best level this CPU and build support
+	SimdLevel DetectSimdLevel();
+
+	// Level used by the kernels; defaults to DetectSimdLevel(). Levels the CPU lacks are lowered to one it has.
+	SimdLevel ActiveSimdLevel();
+	void SetSimdLevel(SimdLevel level);
+
+	const char *SimdLevelName(SimdLevel level);
+
+	// rgb = round(rgb * a / 255), alpha unchanged
+	void PremultiplyAlpha(uint8_t *rgba, size_t pixels);
+
+	// Inverse of PremultiplyAlpha up to rounding; fully transparent pixels become 0
+	void UnpremultiplyAlpha(uint8_t *rgba, size_t pixels);
+
+	// 2x2 box filter into a max(1, w / 2) x max(1, h / 2) image; an odd last row or column is dropped
+	void HalveImage(const uint8_t *src, int srcWidth, int srcHeight, uint8_t *dst);
+
+	// Bilinear resample to dstWidth x dstHeight, sampling at pixel centres. Meant for ratios below 2; use HalveImage
+	// for the rest of a larger reduction so no source pixel is skipped.
+	void ResizeBilinear(const uint8_t *src, int srcWidth, int srcHeight, uint8_t *dst, int dstWidth, int dstHeight);
+
+	// Shrinks image to fit within maxEdge x maxEdge (0 keeps its size, images are never enlarged), so the texture is
+	// uploaded at the size it is drawn; ImGui's sampler only reads the top mip level, so no chain is built. Filtering
+	// is done on premultiplied pixels so transparent areas do not bleed dark fringes into the edges; the result is
+	// converted back to straight alpha, which the UI blends with.
+	void PrepareForDisplay(DecodedImage &image, int maxEdge);
+} // namespace ImageOps
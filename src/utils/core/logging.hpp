@@ -3,15 +3,15 @@
 #include "ui/modal_popup.h"
 #include <string>
 
-#define LOG(msg) Console::Log(msg)
-#define LOG_INFO(msg) Console::Log(std::string("[INFO] ") + (msg))
+#define LOG(msg) Console::Log(Console::Level::None, (msg))
+#define LOG_INFO(msg) Console::Log(Console::Level::Info, (msg))
 #define LOG_WARN(msg) \
 	do { \
-		Console::Log(std::string("[WARN] ") + (msg)); \
-		ModalPopup::Add(std::string("Warning: ") + (msg)); \
+		Console::Log(Console::Level::Warn, (msg)); \
+		ModalPopup::AddAggregated("Warning", (msg)); \
 	} while (0)
 #define LOG_ERROR(msg) \
 	do { \
-		Console::Log(std::string("[ERROR] ") + (msg)); \
-		ModalPopup::Add(std::string("Error: ") + (msg)); \
+		Console::Log(Console::Level::Error, (msg)); \
+		ModalPopup::AddAggregated("Error", (msg)); \
 	} while (0)
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+// Bounded map that evicts the least recently used entry once it holds maxEntries, and optionally expires entries a
+// fixed time after they were stored. Not synchronized; callers that share one across threads lock around it.
+template <typename Key, typename Value, typename Hash = std::hash<Key>> class LruCache {
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		// A zero ttl keeps entries until they are evicted
+		explicit LruCache(size_t maxEntries, Clock::duration ttl = Clock::duration::zero()):
+			m_maxEntries(maxEntries ? maxEntries : 1),
+			m_ttl(ttl) {}
+
+		// Returns the entry and marks it most recently used, or nullptr if it is missing or expired. The pointer is
+		// valid until the next put/erase/clear.
+		const Value *find(const Key &key) {
+			auto found = m_index.find(key);
+			if (found == m_index.end()) { return nullptr; }
+			auto it = found->second;
+			if (expired(*it, Clock::now())) {
+				m_index.erase(found);
+				m_entries.erase(it);
+				return nullptr;
+			}
+			m_entries.splice(m_entries.begin(), m_entries, it);
+			return &it->value;
+		}
+
+		void put(const Key &key, Value value) {
+			auto found = m_index.find(key);
+			if (found != m_index.end()) {
+				found->second->value = std::move(value);
+				found->second->storedAt = Clock::now();
+				m_entries.splice(m_entries.begin(), m_entries, found->second);
+				return;
+			}
+			m_entries.push_front({key, std::move(value), Clock::now()});
+			m_index.emplace(key, m_entries.begin());
+			while (m_entries.size() > m_maxEntries) {
+				m_index.erase(m_entries.back().key);
+				m_entries.pop_back();
+			}
+		}
+
+		bool erase(const Key &key) {
+			auto found = m_index.find(key);
+			if (found == m_index.end()) { return false; }
+			m_entries.erase(found->second);
+			m_index.erase(found);
+			return true;
+		}
+
+		void clear() {
+			m_entries.clear();
+			m_index.clear();
+		}
+
+		size_t size() const { return m_entries.size(); }
+
+	private:
+		struct Entry {
+				Key key;
+				Value value;
+				Clock::time_point storedAt;
+		};
+
+		bool expired(const Entry &entry, Clock::time_point now) const {
+			return m_ttl != Clock::duration::zero() && now - entry.storedAt > m_ttl;
+		}
+
+		std::list<Entry> m_entries; // Most recently used first
+		std::unordered_map<Key, typename std::list<Entry>::iterator, Hash> m_index;
+		size_t m_maxEntries;
+		Clock::duration m_ttl;
+};
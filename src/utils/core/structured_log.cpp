@@ -0,0 +1,510 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#include "structured_log.h"
+
+namespace fs = std::filesystem;
+using std::string;
+using std::string_view;
+
+namespace {
+	// Record layout, shared by queue slots and binary files (native byte order):
+	//   u16 size of the rest | i64 UTC epoch microseconds | u32 thread | u8 level | u8 len + subsystem
+	//   | u16 len + message | u8 field count | per field: u8 len + key, u8 type, 8-byte value or u16 len + bytes
+	constexpr size_t kSlotBytes = 512;
+	constexpr size_t kSlotCount = 4096; // 2 MB of queue; power of two
+	constexpr size_t kMaxSubsystem = 32;
+	constexpr char kBinaryMagic[8] = {'A', 'L', 'T', 'L', 'O', 'G', '1', '\n'};
+	constexpr auto kIdleWait = std::chrono::milliseconds(10);
+	constexpr uint64_t kWakeEvery = kSlotCount / 4; // Producers nudge the writer this often during bursts
+	constexpr size_t kWriteBatchBytes = 64 * 1024;
+
+	// Bounded multi-producer queue (Vyukov): a producer claims a slot with one CAS, fills it, then publishes it by
+	// bumping the slot's sequence. The writer thread is the only consumer.
+	class RecordQueue {
+		public:
+			RecordQueue(): m_slots(new Slot[kSlotCount]) {
+				for (size_t i = 0; i < kSlotCount; ++i) { m_slots[i].sequence.store(i, std::memory_order_relaxed); }
+			}
+
+			// Returns the slot buffer to fill, or nullptr if the queue is full
+			char *claim(uint64_t &position) {
+				position = m_enqueue.load(std::memory_order_relaxed);
+				for (;;) {
+					Slot &slot = m_slots[position & (kSlotCount - 1)];
+					uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+					int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+					if (diff == 0) {
+						if (m_enqueue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+							return slot.data;
+						}
+					} else if (diff < 0) {
+						return nullptr;
+					} else {
+						position = m_enqueue.load(std::memory_order_relaxed);
+					}
+				}
+			}
+
+			void publish(uint64_t position) {
+				m_slots[position & (kSlotCount - 1)].sequence.store(position + 1, std::memory_order_release);
+			}
+
+			// Consumer side: the next published record, or nullptr
+			const char *peek() const {
+				const Slot &slot = m_slots[m_dequeue & (kSlotCount - 1)];
+				if (slot.sequence.load(std::memory_order_acquire) != m_dequeue + 1) { return nullptr; }
+				return slot.data;
+			}
+
+			void pop() {
+				m_slots[m_dequeue & (kSlotCount - 1)].sequence.store(m_dequeue + kSlotCount, std::memory_order_release);
+				++m_dequeue;
+			}
+
+		private:
+			struct Slot {
+					std::atomic<uint64_t> sequence {0};
+					char data[kSlotBytes - sizeof(std::atomic<uint64_t>)];
+			};
+
+			std::unique_ptr<Slot[]> m_slots;
+			alignas(64) std::atomic<uint64_t> m_enqueue {0};
+			alignas(64) uint64_t m_dequeue = 0;
+	};
+
+	constexpr size_t kRecordCapacity = kSlotBytes - sizeof(std::atomic<uint64_t>);
+
+	RecordQueue &queue() {
+		static RecordQueue q;
+		return q;
+	}
+
+	std::atomic<uint64_t> s_dropped {0};
+	std::atomic<uint8_t> s_minLevel {static_cast<uint8_t>(StructuredLog::Level::Debug)};
+
+	std::mutex s_controlMutex;
+	std::condition_variable s_wakeCv;
+	std::atomic_bool s_stop {false};
+	std::thread s_writer;
+
+	// Bounds-checked appender over a slot buffer
+	struct Encoder {
+			char *data;
+			size_t capacity;
+			size_t used = 0;
+
+			size_t remaining() const { return capacity - used; }
+
+			template <typename T> void put(T value) {
+				std::memcpy(data + used, &value, sizeof(T));
+				used += sizeof(T);
+			}
+
+			void bytes(string_view text) {
+				std::memcpy(data + used, text.data(), text.size());
+				used += text.size();
+			}
+	};
+
+	// Reader over one encoded record; every accessor fails instead of reading past the end
+	struct Decoder {
+			const char *data;
+			size_t size;
+			size_t used = 0;
+
+			template <typename T> bool get(T &value) {
+				if (size - used < sizeof(T)) { return false; }
+				std::memcpy(&value, data + used, sizeof(T));
+				used += sizeof(T);
+				return true;
+			}
+
+			bool bytes(size_t length, string_view &out) {
+				if (size - used < length) { return false; }
+				out = string_view(data + used, length);
+				used += length;
+				return true;
+			}
+	};
+
+	uint32_t currentThreadTag() {
+		thread_local uint32_t tag = static_cast<uint32_t>(std::hash<std::thread::id> {}(std::this_thread::get_id()));
+		return tag;
+	}
+
+	void appendQuoted(string &out, string_view value) {
+		bool plain = !value.empty() && value.find_first_of(" \t\"=\r\n") == string_view::npos;
+		if (plain) {
+			out += value;
+			return;
+		}
+		out += '"';
+		for (char c : value) {
+			if (c == '"' || c == '\\') {
+				out += '\\';
+				out += c;
+			} else if (c == '\n') {
+				out += "\\n";
+			} else if (c == '\r') {
+				out += "\\r";
+			} else {
+				out += c;
+			}
+		}
+		out += '"';
+	}
+
+	// Messages stay unquoted, but line breaks are escaped like in quoted values so every record is one line
+	void appendMessage(string &out, string_view message) {
+		for (size_t start = 0;;) {
+			size_t breakAt = message.find_first_of("\r\n", start);
+			out += message.substr(start, breakAt - start);
+			if (breakAt == string_view::npos) { return; }
+			out += message[breakAt] == '\n' ? "\\n" : "\\r";
+			start = breakAt + 1;
+		}
+	}
+
+	// Formats one encoded record (without its size prefix) as a text line
+	bool formatRecord(const char *data, size_t size, string &out) {
+		Decoder in {data, size};
+		int64_t micros = 0;
+		uint32_t thread = 0;
+		uint8_t level = 0;
+		uint8_t subsystemLength = 0;
+		uint16_t messageLength = 0;
+		uint8_t fieldCount = 0;
+		string_view subsystem;
+		string_view message;
+		if (!in.get(micros) || !in.get(thread) || !in.get(level) || !in.get(subsystemLength)
+			|| !in.bytes(subsystemLength, subsystem) || !in.get(messageLength) || !in.bytes(messageLength, message)
+			|| !in.get(fieldCount)) {
+			return false;
+		}
+
+		time_t seconds = static_cast<time_t>(micros / 1000000);
+		std::tm utc {};
+#if defined(_WIN32)
+		gmtime_s(&utc, &seconds);
+#else
+		gmtime_r(&seconds, &utc);
+#endif
+		char prefix[96];
+		int prefixLength = std::snprintf(
+			prefix,
+			sizeof(prefix),
+			"%04d-%02d-%02dT%02d:%02d:%02d.%06lldZ %-5s %08x [",
+			utc.tm_year + 1900,
+			utc.tm_mon + 1,
+			utc.tm_mday,
+			utc.tm_hour,
+			utc.tm_min,
+			utc.tm_sec,
+			static_cast<long long>(micros % 1000000),
+			StructuredLog::LevelName(static_cast<StructuredLog::Level>(level)),
+			thread
+		);
+		out.append(prefix, static_cast<size_t>((std::max)(prefixLength, 0)));
+		out += subsystem;
+		out += "] ";
+		appendMessage(out, message);
+
+		for (uint8_t i = 0; i < fieldCount; ++i) {
+			uint8_t keyLength = 0;
+			uint8_t type = 0;
+			string_view key;
+			if (!in.get(keyLength) || !in.bytes(keyLength, key) || !in.get(type)) { return false; }
+			out += ' ';
+			out += key;
+			out += '=';
+
+			char number[32];
+			switch (static_cast<StructuredLog::Field::Type>(type)) {
+				case StructuredLog::Field::Type::Int: {
+					int64_t value = 0;
+					if (!in.get(value)) { return false; }
+					std::snprintf(number, sizeof(number), "%lld", static_cast<long long>(value));
+					out += number;
+					break;
+				}
+				case StructuredLog::Field::Type::UInt: {
+					uint64_t value = 0;
+					if (!in.get(value)) { return false; }
+					std::snprintf(number, sizeof(number), "%llu", static_cast<unsigned long long>(value));
+					out += number;
+					break;
+				}
+				case StructuredLog::Field::Type::Double: {
+					double value = 0.0;
+					if (!in.get(value)) { return false; }
+					std::snprintf(number, sizeof(number), "%g", value);
+					out += number;
+					break;
+				}
+				case StructuredLog::Field::Type::Bool: {
+					uint8_t value = 0;
+					if (!in.get(value)) { return false; }
+					out += value ? "true" : "false";
+					break;
+				}
+				case StructuredLog::Field::Type::String: {
+					uint16_t length = 0;
+					string_view value;
+					if (!in.get(length) || !in.bytes(length, value)) { return false; }
+					appendQuoted(out, value);
+					break;
+				}
+				default:
+					return false;
+			}
+		}
+		out += '\n';
+		return true;
+	}
+
+	// Current output file plus size-based rotation: name.log -> name.1.log -> ... -> name.(maxFiles-1).log
+	class RotatingFile {
+		public:
+			explicit RotatingFile(const StructuredLog::Options &options): m_options(options) {}
+
+			~RotatingFile() { close(); }
+
+			void write(const string &bytes) {
+				if (bytes.empty()) { return; }
+				if (!m_opened) {
+					open(false);
+				} else if (m_file && m_size + bytes.size() > m_options.maxFileBytes) {
+					open(true);
+				}
+				if (!m_file) { return; }
+				std::fwrite(bytes.data(), 1, bytes.size(), m_file);
+				std::fflush(m_file);
+				m_size += bytes.size();
+			}
+
+		private:
+			fs::path pathFor(int index) const {
+				string name = m_options.baseName;
+				if (index > 0) { name += "." + std::to_string(index); }
+				name += m_options.binary ? ".bin" : ".log";
+				return fs::path(m_options.directory) / name;
+			}
+
+			void close() {
+				if (m_file) {
+					std::fclose(m_file);
+					m_file = nullptr;
+				}
+			}
+
+			// Opens the current file, first shifting older files up when rotating. The first open of a run keeps
+			// appending to the previous run's file if it still has room.
+			void open(bool rotate) {
+				std::error_code ec;
+				close();
+				m_opened = true;
+
+				fs::path current = pathFor(0);
+				uint64_t existing = fs::exists(current, ec) ? fs::file_size(current, ec) : 0;
+				if (ec) { existing = 0; }
+				if (rotate || existing >= m_options.maxFileBytes) {
+					int maxFiles = (std::max)(m_options.maxFiles, 1);
+					fs::remove(pathFor(maxFiles - 1), ec);
+					for (int i = maxFiles - 2; i >= 0; --i) {
+						if (fs::exists(pathFor(i), ec)) { fs::rename(pathFor(i), pathFor(i + 1), ec); }
+					}
+					existing = 0;
+				}
+
+#ifdef _WIN32
+				m_file = _wfopen(current.wstring().c_str(), L"ab");
+#else
+				m_file = std::fopen(current.string().c_str(), "ab");
+#endif
+				m_size = existing;
+				if (m_file && existing == 0 && m_options.binary) {
+					std::fwrite(kBinaryMagic, 1, sizeof(kBinaryMagic), m_file);
+					m_size += sizeof(kBinaryMagic);
+				}
+			}
+
+			StructuredLog::Options m_options;
+			std::FILE *m_file = nullptr;
+			uint64_t m_size = 0;
+			bool m_opened = false;
+	};
+
+	void writerLoop(StructuredLog::Options options) {
+		std::error_code ec;
+		fs::create_directories(options.directory, ec);
+		RotatingFile file(options);
+		RecordQueue &q = queue();
+		string batch;
+		batch.reserve(kWriteBatchBytes + kRecordCapacity * 2);
+
+		for (;;) {
+			bool stopping = s_stop.load();
+			while (const char *record = q.peek()) {
+				uint16_t size = 0;
+				std::memcpy(&size, record, sizeof(size));
+				if (options.binary) {
+					batch.append(record, sizeof(size) + size);
+				} else {
+					formatRecord(record + sizeof(size), size, batch);
+				}
+				q.pop();
+				if (batch.size() >= kWriteBatchBytes) {
+					file.write(batch);
+					batch.clear();
+				}
+			}
+			file.write(batch);
+			batch.clear();
+
+			if (stopping) { break; }
+			std::unique_lock<std::mutex> lock(s_controlMutex);
+			s_wakeCv.wait_for(lock, kIdleWait, [] { return s_stop.load(); });
+		}
+	}
+} // namespace
+
+namespace StructuredLog {
+	const char *LevelName(Level level) {
+		switch (level) {
+			case Level::Debug:
+				return "DEBUG";
+			case Level::Info:
+				return "INFO";
+			case Level::Warn:
+				return "WARN";
+			case Level::Error:
+				return "ERROR";
+			default:
+				return "?";
+		}
+	}
+
+	void Start(const Options &options) {
+		std::lock_guard<std::mutex> lock(s_controlMutex);
+		if (options.directory.empty() || s_writer.joinable()) { return; }
+		s_minLevel = static_cast<uint8_t>(options.minLevel);
+		s_stop = false;
+		s_writer = std::thread(writerLoop, options);
+	}
+
+	void Stop() {
+		{
+			std::lock_guard<std::mutex> lock(s_controlMutex);
+			if (!s_writer.joinable()) { return; }
+			s_stop = true;
+		}
+		s_wakeCv.notify_all();
+		s_writer.join();
+	}
+
+	void Write(Level level, string_view subsystem, string_view message, std::initializer_list<Field> fields) {
+		if (static_cast<uint8_t>(level) < s_minLevel.load(std::memory_order_relaxed)) { return; }
+
+		uint64_t position = 0;
+		char *slot = queue().claim(position);
+		if (!slot) {
+			s_dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		int64_t micros = std::chrono::duration_cast<std::chrono::microseconds>(
+							 std::chrono::system_clock::now().time_since_epoch()
+		)
+							 .count();
+		subsystem = subsystem.substr(0, kMaxSubsystem);
+
+		Encoder out {slot, kRecordCapacity};
+		out.put(uint16_t {0}); // Size, patched below
+		out.put(micros);
+		out.put(currentThreadTag());
+		out.put(static_cast<uint8_t>(level));
+		out.put(static_cast<uint8_t>(subsystem.size()));
+		out.bytes(subsystem);
+
+		// The message gets whatever is left after the fixed part; fields only go in while they fit
+		size_t messageLength = (std::min)(message.size(), out.remaining() - sizeof(uint16_t) - sizeof(uint8_t));
+		out.put(static_cast<uint16_t>(messageLength));
+		out.bytes(message.substr(0, messageLength));
+
+		size_t countOffset = out.used;
+		out.put(uint8_t {0});
+		uint8_t fieldCount = 0;
+		for (const Field &field : fields) {
+			if (fieldCount == UINT8_MAX) { break; }
+			string_view key = field.key.substr(0, UINT8_MAX);
+			size_t valueSize = field.type == Field::Type::String ? sizeof(uint16_t) + field.stringValue.size() : 8;
+			if (field.type == Field::Type::Bool) { valueSize = 1; }
+			if (1 + key.size() + 1 + valueSize > out.remaining()) { break; }
+
+			out.put(static_cast<uint8_t>(key.size()));
+			out.bytes(key);
+			out.put(static_cast<uint8_t>(field.type));
+			switch (field.type) {
+				case Field::Type::Int:
+					out.put(field.intValue);
+					break;
+				case Field::Type::UInt:
+					out.put(field.uintValue);
+					break;
+				case Field::Type::Double:
+					out.put(field.doubleValue);
+					break;
+				case Field::Type::Bool:
+					out.put(static_cast<uint8_t>(field.uintValue ? 1 : 0));
+					break;
+				case Field::Type::String:
+					out.put(static_cast<uint16_t>(field.stringValue.size()));
+					out.bytes(field.stringValue);
+					break;
+			}
+			++fieldCount;
+		}
+		slot[countOffset] = static_cast<char>(fieldCount);
+
+		uint16_t size = static_cast<uint16_t>(out.used - sizeof(uint16_t));
+		std::memcpy(slot, &size, sizeof(size));
+		queue().publish(position);
+
+		// Bursts can outrun the idle wait; a quarter of the queue in, wake the writer early
+		if (position % kWakeEvery == kWakeEvery - 1) { s_wakeCv.notify_one(); }
+	}
+
+	uint64_t DroppedRecords() { return s_dropped.load(std::memory_order_relaxed); }
+
+	bool DecodeBinary(std::istream &in, std::ostream &out) {
+		char magic[sizeof(kBinaryMagic)] = {};
+		if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kBinaryMagic, sizeof(magic)) != 0) { return false; }
+
+		char record[kRecordCapacity];
+		string line;
+		for (;;) {
+			uint16_t size = 0;
+			if (!in.read(reinterpret_cast<char *>(&size), sizeof(size))) { return in.gcount() == 0; }
+			if (size > sizeof(record) || !in.read(record, size)) { return false; }
+			line.clear();
+			if (!formatRecord(record, size, line)) { return false; }
+			out << line;
+		}
+	}
+} // namespace StructuredLog
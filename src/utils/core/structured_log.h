@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Persistent, structured application log. Callers encode a record into a fixed-size slot of a lock-free queue and
+// return; one writer thread formats records and appends them to rotating, size-capped files. Records logged before
+// Start() wait in the queue (up to its capacity) and are written once the writer is running.
+namespace StructuredLog {
+	enum class Level : uint8_t {
+		Debug,
+		Info,
+		Warn,
+		Error,
+	};
+
+	// A key/value pair attached to a record. Views must stay valid for the duration of the Write call only.
+	struct Field {
+			enum class Type : uint8_t {
+				Int,
+				UInt,
+				Double,
+				Bool,
+				String,
+			};
+
+			std::string_view key;
+			Type type = Type::Int;
+			int64_t intValue = 0;
+			uint64_t uintValue = 0;
+			double doubleValue = 0.0;
+			std::string_view stringValue;
+
+			template <typename T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>, int> = 0>
+			Field(std::string_view k, T value): key(k) {
+				if constexpr (std::is_signed_v<T>) {
+					type = Type::Int;
+					intValue = value;
+				} else {
+					type = Type::UInt;
+					uintValue = value;
+				}
+			}
+
+			Field(std::string_view k, bool value): key(k), type(Type::Bool), uintValue(value ? 1 : 0) {}
+
+			Field(std::string_view k, double value): key(k), type(Type::Double), doubleValue(value) {}
+
+			Field(std::string_view k, std::string_view value): key(k), type(Type::String), stringValue(value) {}
+
+			Field(std::string_view k, const char *value): Field(k, std::string_view(value ? value : "")) {}
+
+			Field(std::string_view k, const std::string &value): Field(k, std::string_view(value)) {}
+	};
+
+	struct Options {
+			std::string directory; // Created if missing
+			std::string baseName = "altman"; // Files are <baseName>.log / .bin, rotated to <baseName>.1.log, ...
+			uint64_t maxFileBytes = 4 * 1024 * 1024;
+			int maxFiles = 5; // Current file plus rotated ones
+			bool binary = false; // Compact binary records instead of text lines; read back with DecodeBinary
+			Level minLevel = Level::Info;
+	};
+
+	void Start(const Options &options);
+
+	// Drains the queue, closes the file and joins the writer
+	void Stop();
+
+	/**
+	 * Queues a record; never blocks or allocates. Long messages are truncated and fields that do not fit the slot are
+	 * dropped. When the queue is full the record is dropped and counted in DroppedRecords().
+	 * @param subsystem Short tag such as "history" or "servers"
+	 */
+	void Write(
+		Level level,
+		std::string_view subsystem,
+		std::string_view message,
+		std::initializer_list<Field> fields = {}
+	);
+
+	uint64_t DroppedRecords();
+
+	const char *LevelName(Level level);
+
+	/**
+	 * Converts a binary log file's contents to the text format
+	 * @return false if the header is missing or a record is truncated/corrupt (records before it are still written)
+	 */
+	bool DecodeBinary(std::istream &in, std::ostream &out);
+} // namespace StructuredLog
@@ -1,9 +1,11 @@
 #pragma once
 #include <chrono>
+#include <cstdint>
 #include <ctime>
 #include <iomanip>
 #include <sstream>
 #include <string>
+#include <string_view>
 
 inline std::string formatRelativeFuture(time_t timestamp) {
 	using namespace std::chrono;
@@ -101,6 +103,46 @@ inline time_t parseIsoTimestamp(const std::string &isoRaw) {
 #endif
 }
 
+// Parses "YYYY-MM-DDTHH:MM:SS[.fff...]Z" without allocating; returns 0 on malformed input.
+inline int64_t parseIsoTimestampMillis(std::string_view iso) {
+	auto digits = [&iso](size_t pos, size_t count, int &out) {
+		if (pos + count > iso.size()) { return false; }
+		int value = 0;
+		for (size_t i = pos; i < pos + count; ++i) {
+			if (iso[i] < '0' || iso[i] > '9') { return false; }
+			value = value * 10 + (iso[i] - '0');
+		}
+		out = value;
+		return true;
+	};
+
+	int year, month, day, hour, minute, second;
+	if (!digits(0, 4, year) || !digits(5, 2, month) || !digits(8, 2, day) || !digits(11, 2, hour)
+		|| !digits(14, 2, minute) || !digits(17, 2, second) || iso[4] != '-' || iso[7] != '-' || iso[10] != 'T'
+		|| iso[13] != ':' || iso[16] != ':' || month < 1 || month > 12 || day < 1 || day > 31) {
+		return 0;
+	}
+
+	int millis = 0;
+	if (iso.size() > 20 && iso[19] == '.') {
+		int scale = 100;
+		for (size_t i = 20; i < iso.size() && iso[i] >= '0' && iso[i] <= '9'; ++i) {
+			millis += (iso[i] - '0') * scale;
+			scale /= 10;
+		}
+	}
+
+	// Days since 1970-01-01 for the proleptic Gregorian calendar (Howard Hinnant's days_from_civil)
+	int y = year - (month <= 2 ? 1 : 0);
+	int era = (y >= 0 ? y : y - 399) / 400;
+	int yoe = y - era * 400;
+	int doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+	int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+	int64_t days = static_cast<int64_t>(era) * 146097 + doe - 719468;
+
+	return ((days * 24 + hour) * 60 + minute) * 60000LL + second * 1000LL + millis;
+}
+
 inline std::string formatAbsoluteLocal(time_t timestamp) {
 	if (timestamp == 0) { return ""; }
 
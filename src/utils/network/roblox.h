@@ -8,3 +8,4 @@
 #include "roblox/hba_client.h"
 #include "roblox/session.h"
 #include "roblox/social.h"
+#include "roblox/thumbnails.h"
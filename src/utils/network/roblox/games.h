@@ -1,7 +1,9 @@
 #pragma once
 
+#include <algorithm>
 #include <nlohmann/json.hpp>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "core/logging.hpp"
@@ -31,56 +33,100 @@ namespace Roblox {
 			bool creatorVerified = false;
 	};
 
-	inline GameDetail getGameDetail(uint64_t universeId) {
+	// The games endpoint takes this many universe ids per request
+	inline constexpr size_t kMaxGameDetailBatch = 50;
+
+	// Fills a GameDetail from one element of the games endpoint's "data" array
+	inline GameDetail parseGameDetail(const nlohmann::json &j) {
+		GameDetail d;
+		d.name = j.value("name", "");
+		d.genre = j.value("genre", "");
+		d.genreL1 = j.value("genre_l1", "");
+		d.genreL2 = j.value("genre_l2", "");
+		d.description = j.value("description", "");
+		d.visits = j.value("visits", 0ULL);
+		d.favorites = j.value("favoritedCount", 0ULL);
+		d.playing = j.value("playing", 0);
+		d.maxPlayers = j.value("maxPlayers", 0);
+		// price can be null; handle as -1 when not present
+		if (j.contains("price") && !j["price"].is_null()) {
+			d.priceRobux = j["price"].get<int>();
+		} else {
+			d.priceRobux = -1;
+		}
+		d.createdIso = j.value("created", "");
+		d.updatedIso = j.value("updated", "");
+
+		if (j.contains("creator")) {
+			const auto &c = j["creator"];
+			d.creatorName = c.value("name", "");
+			d.creatorId = c.value("id", 0ULL);
+			d.creatorType = c.value("type", "");
+			d.creatorVerified = c.value("hasVerifiedBadge", false);
+		}
+		return d;
+	}
+
+	/**
+	 * Details for many universes, kMaxGameDetailBatch per request
+	 * @return Universe id -> detail; universes that failed or do not exist are missing
+	 */
+	inline std::unordered_map<uint64_t, GameDetail> getGameDetails(const std::vector<uint64_t> &universeIds) {
 		using nlohmann::json;
-		const std::string url = "https://games.roblox.com/v1/games?universeIds=" + std::to_string(universeId);
+		std::unordered_map<uint64_t, GameDetail> out;
+		for (size_t start = 0; start < universeIds.size(); start += kMaxGameDetailBatch) {
+			std::string url = "https://games.roblox.com/v1/games?universeIds=";
+			size_t end = (std::min)(universeIds.size(), start + kMaxGameDetailBatch);
+			for (size_t i = start; i < end; ++i) {
+				if (i != start) { url += ','; }
+				url += std::to_string(universeIds[i]);
+			}
 
-		HttpClient::Response resp = HttpClient::get(url);
-		if (resp.status_code < 200 || resp.status_code >= 300) {
-			LOG_ERROR("Game detail fetch failed: HTTP " + std::to_string(resp.status_code));
-			return GameDetail {};
+			HttpClient::Response resp = HttpClient::get(url);
+			if (resp.status_code < 200 || resp.status_code >= 300) {
+				LOG_ERROR("Game detail fetch failed: HTTP " + std::to_string(resp.status_code));
+				continue;
+			}
+			try {
+				json root = json::parse(resp.text);
+				if (!root.contains("data") || !root["data"].is_array()) { continue; }
+				for (const auto &j : root["data"]) {
+					uint64_t id = j.value("id", 0ULL);
+					if (id != 0) { out[id] = parseGameDetail(j); }
+				}
+			} catch (const std::exception &e) { LOG_ERROR(std::string("Failed to parse game detail: ") + e.what()); }
 		}
+		return out;
+	}
 
-		GameDetail d;
+	inline GameDetail getGameDetail(uint64_t universeId) {
+		auto details = getGameDetails({universeId});
+		auto it = details.find(universeId);
+		return it != details.end() ? it->second : GameDetail {};
+	}
+
+	// Universe a place belongs to, or 0 if the lookup failed
+	inline uint64_t getUniverseIdForPlace(uint64_t placeId) {
+		HttpClient::Response resp
+			= HttpClient::get("https://apis.roblox.com/universes/v1/places/" + std::to_string(placeId) + "/universe");
+		if (resp.status_code < 200 || resp.status_code >= 300) {
+			LOG_ERROR("Universe lookup failed: HTTP " + std::to_string(resp.status_code));
+			return 0;
+		}
 		try {
-			json root = json::parse(resp.text);
-			if (root.contains("data") && root["data"].is_array() && !root["data"].empty()) {
-				const auto &j = root["data"][0];
-				d.name = j.value("name", "");
-				d.genre = j.value("genre", "");
-				d.genreL1 = j.value("genre_l1", "");
-				d.genreL2 = j.value("genre_l2", "");
-				d.description = j.value("description", "");
-				d.visits = j.value("visits", 0ULL);
-				d.favorites = j.value("favoritedCount", 0ULL);
-				d.playing = j.value("playing", 0);
-				d.maxPlayers = j.value("maxPlayers", 0);
-				// price can be null; handle as -1 when not present
-				if (j.contains("price") && !j["price"].is_null()) {
-					d.priceRobux = j["price"].get<int>();
-				} else {
-					d.priceRobux = -1;
-				}
-				d.createdIso = j.value("created", "");
-				d.updatedIso = j.value("updated", "");
-
-				if (j.contains("creator")) {
-					const auto &c = j["creator"];
-					d.creatorName = c.value("name", "");
-					d.creatorId = c.value("id", 0ULL);
-					d.creatorType = c.value("type", "");
-					d.creatorVerified = c.value("hasVerifiedBadge", false);
-				}
+			nlohmann::json root = nlohmann::json::parse(resp.text);
+			if (root.contains("universeId") && root["universeId"].is_number_unsigned()) {
+				return root["universeId"].get<uint64_t>();
 			}
-		} catch (const std::exception &e) { LOG_ERROR(std::string("Failed to parse game detail: ") + e.what()); }
-
-		return d;
+		} catch (const std::exception &e) { LOG_ERROR(std::string("Failed to parse universe lookup: ") + e.what()); }
+		return 0;
 	}
 
 	struct ServerPage {
 			std::vector<PublicServerInfo> data;
 			std::string nextCursor;
 			std::string prevCursor;
+			int statusCode = 0; // HTTP status of the response; data is empty unless 2xx
 	};
 
 	static ServerPage getPublicServersPage(uint64_t placeId, const std::string &cursor = {}) {
@@ -89,13 +135,17 @@ namespace Roblox {
 
 		HttpClient::Response resp = HttpClient::get(url);
 		if (resp.status_code < 200 || resp.status_code >= 300) {
-			LOG_ERROR("Failed to fetch servers: HTTP " + std::to_string(resp.status_code));
-			return ServerPage {};
+			// Not a popup: callers retry 429 and 5xx, and report once they give up
+			LOG_INFO("Failed to fetch servers: HTTP " + std::to_string(resp.status_code));
+			ServerPage failed;
+			failed.statusCode = resp.status_code;
+			return failed;
 		}
 
 		auto json = HttpClient::decode(resp);
 
 		ServerPage page;
+		page.statusCode = resp.status_code;
 		if (json.contains("nextPageCursor")) {
 			page.nextCursor
 				= json["nextPageCursor"].is_null() ? std::string {} : json["nextPageCursor"].get<std::string>();
@@ -3,6 +3,7 @@
 #include <nlohmann/json.hpp>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "auth.h"
@@ -293,10 +294,21 @@ namespace Roblox {
 
 	/**
 	 * Get presences for multiple users with HBA support
+	 * Failures are reported with LOG_ERROR, or only stored in outError if provided.
 	 */
-	static std::unordered_map<uint64_t, PresenceData>
-		getPresences(const std::vector<uint64_t> &userIds, const HBA::AuthConfig &config) {
-		if (!canUseCookie(config)) { return {}; }
+	static std::unordered_map<uint64_t, PresenceData> getPresences(
+		const std::vector<uint64_t> &userIds,
+		const HBA::AuthConfig &config,
+		std::string *outError = nullptr
+	) {
+		if (outError) {
+			if (cachedBanStatus(config) != BanCheckResult::Unbanned) {
+				*outError = "Skipping request: cookie is invalid or moderated";
+				return {};
+			}
+		} else if (!canUseCookie(config)) {
+			return {};
+		}
 
 		nlohmann::json payload = {{"userIds", userIds}};
 		std::string payloadStr = payload.dump();
@@ -305,7 +317,12 @@ namespace Roblox {
 			= AuthenticatedHttp::postWithAutoCSRF("https://presence.roblox.com/v1/presence/users", config, payloadStr);
 
 		if (resp.status_code < 200 || resp.status_code >= 300) {
-			LOG_ERROR("Batch presence failed: HTTP " + std::to_string(resp.status_code));
+			std::string error = "Batch presence failed: HTTP " + std::to_string(resp.status_code);
+			if (outError) {
+				*outError = std::move(error);
+			} else {
+				LOG_ERROR(error);
+			}
 			return {};
 		}
 
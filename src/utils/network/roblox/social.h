@@ -14,70 +14,31 @@
 #include "hba_client.h"
 #include "http.hpp"
 #include "threading.h"
+#include "user_directory.h"
 
 #include "../../components/components.h"
 
 namespace Roblox {
 	/**
-	 * Batch fetch user profiles (names) from the User Profile API.
-	 * This is needed because the Friends API no longer returns name/displayName fields.
-	 * @param userIds Vector of user IDs to fetch (will be batched in groups of 100)
-	 * @return Map of userId -> combinedName
+	 * Names of users, from the shared user directory (user_directory.h), which batches what it has to fetch from the
+	 * User Profile API. This is needed because the Friends API no longer returns name/displayName fields.
+	 * @param userIds Vector of user IDs to fetch
+	 * @return Map of userId -> "combinedName|username"
 	 */
 	inline std::unordered_map<uint64_t, std::string> getUserProfiles(const std::vector<uint64_t> &userIds) {
 		std::unordered_map<uint64_t, std::string> result;
 		if (userIds.empty()) { return result; }
 
-		const size_t batchSize = 100;
-		for (size_t i = 0; i < userIds.size(); i += batchSize) {
-			size_t end = (std::min)(userIds.size(), i + batchSize);
-			std::vector<uint64_t> batch(userIds.begin() + i, userIds.begin() + end);
-
-			nlohmann::json payload = {{"fields", {"names.combinedName", "names.username"}}, {"userIds", batch}};
-
-			auto resp = HttpClient::post(
-				"https://apis.roblox.com/user-profile-api/v1/user/profiles/get-profiles",
-				{{"Content-Type", "application/json"}, {"Accept", "application/json"}},
-				payload.dump()
-			);
-
-			if (resp.status_code < 200 || resp.status_code >= 300) {
-				LOG_ERROR("Failed to fetch user profiles: HTTP " + std::to_string(resp.status_code));
-				continue;
-			}
-
-			try {
-				nlohmann::json j = HttpClient::decode(resp);
-				if (j.contains("profileDetails") && j["profileDetails"].is_array()) {
-					for (const auto &profile : j["profileDetails"]) {
-						uint64_t uid = profile.value("userId", 0ULL);
-						if (uid == 0) { continue; }
-
-						std::string combinedName;
-						std::string username;
-						if (profile.contains("names") && profile["names"].is_object()) {
-							const auto &names = profile["names"];
-							if (names.contains("combinedName") && names["combinedName"].is_string()) {
-								combinedName = names["combinedName"].get<std::string>();
-							}
-							if (names.contains("username") && names["username"].is_string()) {
-								username = names["username"].get<std::string>();
-							}
-						}
-
-						// Store as "combinedName|username" so we can split later
-						// If username is empty, just store combinedName twice
-						if (username.empty()) { username = combinedName; }
-						result[uid] = combinedName + "|" + username;
-					}
-				}
-			} catch (const std::exception &e) { LOG_ERROR(std::string("Error parsing user profiles: ") + e.what()); }
+		for (const auto &[id, name] : UserDirectory::Lookup(userIds)) {
+			result[id] = name.displayName + "|" + name.username;
 		}
-
 		return result;
 	}
 
-	static std::vector<FriendInfo> getFriends(const std::string &userId, const HBA::AuthConfig &config) {
+	/**
+	 * Friend IDs of a user, without names: the Friends API no longer returns them, see applyUserProfiles.
+	 */
+	inline std::vector<FriendInfo> getFriendList(const std::string &userId, const HBA::AuthConfig &config) {
 		if (!canUseCookie(config)) { return {}; }
 
 		LOG_INFO("Fetching friends list (HBA-enabled)");
@@ -92,7 +53,6 @@ namespace Roblox {
 
 		nlohmann::json j = HttpClient::decode(resp);
 		std::vector<FriendInfo> friends;
-		std::vector<uint64_t> friendIds;
 
 		if (j.contains("data") && j["data"].is_array()) {
 			for (const auto &item : j["data"]) {
@@ -102,32 +62,50 @@ namespace Roblox {
 				f.displayName = item.value("displayName", "");
 				f.username = item.value("name", "");
 				friends.push_back(f);
-				if (f.id != 0) { friendIds.push_back(f.id); }
 			}
 		}
+		return friends;
+	}
+
+	/**
+	 * Fill in names from a getUserProfiles result. Friends missing from it keep what they had, or their ID if that
+	 * was nothing.
+	 */
+	inline void
+		applyUserProfiles(std::vector<FriendInfo> &friends, const std::unordered_map<uint64_t, std::string> &profiles) {
+		for (auto &f : friends) {
+			auto it = profiles.find(f.id);
+			if (it != profiles.end()) {
+				// Format is "combinedName|username"
+				size_t sep = it->second.find('|');
+				if (sep != std::string::npos) {
+					f.displayName = it->second.substr(0, sep);
+					f.username = it->second.substr(sep + 1);
+				} else {
+					f.displayName = it->second;
+					f.username = it->second;
+				}
+			} else if (f.displayName.empty() && f.username.empty()) {
+				// Fallback to user ID if profile fetch failed
+				f.displayName = std::to_string(f.id);
+				f.username = std::to_string(f.id);
+			}
+		}
+	}
+
+	static std::vector<FriendInfo> getFriends(const std::string &userId, const HBA::AuthConfig &config) {
+		std::vector<FriendInfo> friends = getFriendList(userId, config);
+
+		std::vector<uint64_t> friendIds;
+		friendIds.reserve(friends.size());
+		for (const auto &f : friends) {
+			if (f.id != 0) { friendIds.push_back(f.id); }
+		}
 
 		// Fetch names from User Profile API since Friends API no longer returns them
 		if (!friendIds.empty()) {
 			LOG_INFO("Fetching friend names from User Profile API...");
-			auto profiles = getUserProfiles(friendIds);
-			for (auto &f : friends) {
-				auto it = profiles.find(f.id);
-				if (it != profiles.end()) {
-					// Format is "combinedName|username"
-					size_t sep = it->second.find('|');
-					if (sep != std::string::npos) {
-						f.displayName = it->second.substr(0, sep);
-						f.username = it->second.substr(sep + 1);
-					} else {
-						f.displayName = it->second;
-						f.username = it->second;
-					}
-				} else if (f.displayName.empty() && f.username.empty()) {
-					// Fallback to user ID if profile fetch failed
-					f.displayName = std::to_string(f.id);
-					f.username = std::to_string(f.id);
-				}
-			}
+			applyUserProfiles(friends, getUserProfiles(friendIds));
 		}
 
 		return friends;
@@ -143,21 +121,25 @@ namespace Roblox {
 
 	static FriendInfo getUserInfo(const std::string &userId) {
 		LOG_INFO("Fetching user info");
-		HttpClient::Response resp
-			= HttpClient::get("https://users.roblox.com/v1/users/" + userId, {{"Accept", "application/json"}});
+		uint64_t id = 0;
+		try {
+			id = std::stoull(userId);
+		} catch (const std::exception &) {
+			LOG_ERROR("Failed to fetch user info: invalid user ID");
+			return FriendInfo {};
+		}
 
-		if (resp.status_code < 200 || resp.status_code >= 300) {
-			LOG_ERROR("Failed to fetch user info: HTTP " + std::to_string(resp.status_code));
+		auto names = UserDirectory::Lookup({id});
+		auto it = names.find(id);
+		if (it == names.end()) {
+			LOG_ERROR("Failed to fetch user info for " + userId);
 			return FriendInfo {};
 		}
 
-		nlohmann::json j = HttpClient::decode(resp);
 		FriendInfo f;
-		if (!j.is_null()) {
-			f.id = j.value("id", 0ULL);
-			f.username = j.value("name", "");
-			f.displayName = j.value("displayName", "");
-		}
+		f.id = id;
+		f.username = it->second.username;
+		f.displayName = it->second.displayName;
 		return f;
 	}
 
@@ -415,22 +397,13 @@ namespace Roblox {
 	}
 
 	inline uint64_t getUserIdFromUsername(const std::string &username) {
-		nlohmann::json payload = {{"usernames", {username}}, {"excludeBannedUsers", true}};
-
-		auto resp = HttpClient::post("https://users.roblox.com/v1/usernames/users", {}, payload.dump());
-
-		if (resp.status_code < 200 || resp.status_code >= 300) {
-			LOG_ERROR("Username lookup failed: HTTP " + std::to_string(resp.status_code));
-			return 0;
-		}
-
-		auto j = HttpClient::decode(resp);
-		if (!j.contains("data") || j["data"].empty()) {
+		auto found = UserDirectory::LookupUsernames({username});
+		auto it = found.find(username);
+		if (it == found.end()) {
 			LOG_ERROR("Username not found");
 			return 0;
 		}
-
-		return j["data"][0].value("id", 0ULL);
+		return it->second.id;
 	}
 
 	/**
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+#include "core/logging.hpp"
+#include "http.hpp"
+
+namespace Roblox {
+	// The thumbnails endpoints take this many target ids per request
+	inline constexpr size_t kMaxThumbnailBatch = 100;
+
+	struct ThumbnailInfo {
+			uint64_t targetId = 0;
+			std::string state; // "Completed", "Pending", "Blocked", "Error", ...
+			std::string imageUrl; // Set once state is "Completed"
+	};
+
+	/**
+	 * Thumbnail metadata for many targets of one kind
+	 * @param endpoint Path under thumbnails.roblox.com/v1, e.g. "assets"
+	 * @param idParam Query parameter the endpoint takes the ids in, e.g. "assetIds"
+	 * @return One entry per target the endpoint answered for; targets of failed requests are missing
+	 */
+	inline std::vector<ThumbnailInfo> getThumbnails(
+		const std::string &endpoint,
+		const std::string &idParam,
+		const std::vector<uint64_t> &targetIds,
+		const std::string &size
+	) {
+		std::vector<ThumbnailInfo> out;
+		out.reserve(targetIds.size());
+		for (size_t start = 0; start < targetIds.size(); start += kMaxThumbnailBatch) {
+			std::string ids;
+			size_t end = (std::min)(targetIds.size(), start + kMaxThumbnailBatch);
+			for (size_t i = start; i < end; ++i) {
+				if (i != start) { ids += ','; }
+				ids += std::to_string(targetIds[i]);
+			}
+			std::string url = "https://thumbnails.roblox.com/v1/" + endpoint + "?" + idParam + "=" + ids
+							+ "&size=" + size + "&format=Png";
+
+			HttpClient::Response resp = HttpClient::get(url);
+			if (resp.status_code != 200 || resp.text.empty()) {
+				LOG_WARN("Thumbnail metadata request failed: HTTP " + std::to_string(resp.status_code));
+				continue;
+			}
+			nlohmann::json j = HttpClient::decode(resp);
+			if (!j.contains("data") || !j["data"].is_array()) { continue; }
+			for (const auto &item : j["data"]) {
+				ThumbnailInfo info;
+				info.targetId = item.value("targetId", 0ULL);
+				info.state = item.value("state", "");
+				if (item.contains("imageUrl") && item["imageUrl"].is_string()) {
+					info.imageUrl = item["imageUrl"].get<std::string>();
+				}
+				if (info.targetId != 0) { out.push_back(std::move(info)); }
+			}
+		}
+		return out;
+	}
+
+	inline std::vector<ThumbnailInfo> getAssetThumbnails(const std::vector<uint64_t> &assetIds, const std::string &size) {
+		return getThumbnails("assets", "assetIds", assetIds, size);
+	}
+
+	inline std::vector<ThumbnailInfo> getAvatarThumbnails(const std::vector<uint64_t> &userIds, const std::string &size) {
+		return getThumbnails("users/avatar", "userIds", userIds, size);
+	}
+} // namespace Roblox
@@ -0,0 +1,310 @@
+#include "user_directory.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+
+#include "core/logging.hpp"
+#include "data.h"
+#include "network/http.hpp"
+#include "system/threading.h"
+
+using nlohmann::json;
+using UserDirectory::UserName;
+
+static constexpr const char *kDirectoryFile = "user_directory.json";
+// Answers older than this are fetched again when asked for; ones older than kForgetAfterMs are not saved
+static constexpr int64_t kFreshForMs = 24LL * 60 * 60 * 1000;
+static constexpr int64_t kForgetAfterMs = 30LL * 24 * 60 * 60 * 1000;
+// How long the dispatcher waits for more lookups before sending a batch
+static constexpr auto kBatchWindow = std::chrono::milliseconds(50);
+// Most IDs or usernames either endpoint takes per request
+static constexpr size_t kBatchSize = 100;
+
+namespace {
+	struct Entry {
+			UserName name;
+			int64_t fetchedAtMs = 0;
+	};
+} // namespace
+
+static std::mutex g_mutex;
+static std::condition_variable g_batchDone;
+static std::unordered_map<uint64_t, Entry> g_users;
+static std::unordered_map<std::string, uint64_t> g_idsByUsername; // Lowercase username -> userId
+// Lookups not yet sent, and every lookup not yet answered (sent or not); callers wait for theirs to leave the latter
+static std::vector<uint64_t> g_wantedIds;
+static std::vector<std::string> g_wantedUsernames;
+static std::unordered_set<uint64_t> g_pendingIds;
+static std::unordered_set<std::string> g_pendingUsernames;
+static bool g_dispatcherRunning = false;
+static bool g_loaded = false;
+static bool g_dirty = false;
+static std::mutex g_saveMutex;
+
+static int64_t nowMs() {
+	using namespace std::chrono;
+	return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+static std::string lowercase(std::string s) {
+	std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+	return s;
+}
+
+// Caller holds g_mutex
+static void storeLocked(const UserName &name, int64_t fetchedAtMs) {
+	if (name.id == 0) { return; }
+	g_users[name.id] = {name, fetchedAtMs};
+	if (!name.username.empty()) { g_idsByUsername[lowercase(name.username)] = name.id; }
+}
+
+// Caller holds g_mutex
+static void loadLocked() {
+	if (g_loaded) { return; }
+	g_loaded = true;
+
+	std::string path = Data::StorageFilePath(kDirectoryFile);
+	std::ifstream in {path};
+	if (!in.is_open()) { return; }
+	try {
+		json root;
+		in >> root;
+		int64_t forgetBefore = nowMs() - kForgetAfterMs;
+		for (const auto &j : root.value("users", json::array())) {
+			if (!j.is_array() || j.size() != 4) { continue; }
+			int64_t fetchedAtMs = j[3].get<int64_t>();
+			if (fetchedAtMs < forgetBefore) { continue; }
+			storeLocked({j[0].get<uint64_t>(), j[1].get<std::string>(), j[2].get<std::string>()}, fetchedAtMs);
+		}
+		LOG_INFO("Loaded user directory: " + std::to_string(g_users.size()) + " users");
+	} catch (const std::exception &e) {
+		g_users.clear();
+		g_idsByUsername.clear();
+		LOG_ERROR(std::string("Failed to load user directory: ") + e.what());
+	}
+}
+
+static void save() {
+	json users = json::array();
+	{
+		std::lock_guard<std::mutex> lock(g_mutex);
+		int64_t forgetBefore = nowMs() - kForgetAfterMs;
+		for (const auto &[id, entry] : g_users) {
+			if (entry.fetchedAtMs < forgetBefore) { continue; }
+			users.push_back({id, entry.name.username, entry.name.displayName, entry.fetchedAtMs});
+		}
+	}
+
+	// Written to a temporary file and swapped in, so a crash mid-write keeps the previous directory
+	std::lock_guard<std::mutex> saveLock(g_saveMutex);
+	std::string path = Data::StorageFilePath(kDirectoryFile);
+	std::string temp = path + ".tmp";
+	{
+		std::ofstream out(temp, std::ios::trunc);
+		if (!out.is_open()) {
+			LOG_ERROR("Could not open '" + temp + "' for writing");
+			return;
+		}
+		out << json {{"users", std::move(users)}}.dump();
+	}
+	std::error_code ec;
+	std::filesystem::rename(temp, path, ec);
+	if (ec) { LOG_ERROR("Could not save user directory: " + ec.message()); }
+}
+
+static std::vector<UserName> fetchProfiles(const std::vector<uint64_t> &userIds) {
+	std::vector<UserName> found;
+	json payload = {{"fields", {"names.combinedName", "names.username"}}, {"userIds", userIds}};
+	auto resp = HttpClient::post(
+		"https://apis.roblox.com/user-profile-api/v1/user/profiles/get-profiles",
+		{{"Content-Type", "application/json"}, {"Accept", "application/json"}},
+		payload.dump()
+	);
+	if (resp.status_code < 200 || resp.status_code >= 300) {
+		LOG_ERROR("Failed to fetch user profiles: HTTP " + std::to_string(resp.status_code));
+		return found;
+	}
+
+	try {
+		json j = HttpClient::decode(resp);
+		for (const auto &profile : j.value("profileDetails", json::array())) {
+			UserName name;
+			name.id = profile.value("userId", 0ULL);
+			if (name.id == 0) { continue; }
+			if (profile.contains("names") && profile["names"].is_object()) {
+				const auto &names = profile["names"];
+				if (names.contains("combinedName") && names["combinedName"].is_string()) {
+					name.displayName = names["combinedName"].get<std::string>();
+				}
+				if (names.contains("username") && names["username"].is_string()) {
+					name.username = names["username"].get<std::string>();
+				}
+			}
+			if (name.username.empty()) { name.username = name.displayName; }
+			found.push_back(std::move(name));
+		}
+	} catch (const std::exception &e) { LOG_ERROR(std::string("Error parsing user profiles: ") + e.what()); }
+	return found;
+}
+
+static std::vector<UserName> fetchUsernames(const std::vector<std::string> &usernames) {
+	std::vector<UserName> found;
+	json payload = {{"usernames", usernames}, {"excludeBannedUsers", true}};
+	auto resp = HttpClient::post("https://users.roblox.com/v1/usernames/users", {}, payload.dump());
+	if (resp.status_code < 200 || resp.status_code >= 300) {
+		LOG_ERROR("Username lookup failed: HTTP " + std::to_string(resp.status_code));
+		return found;
+	}
+
+	try {
+		json j = HttpClient::decode(resp);
+		for (const auto &user : j.value("data", json::array())) {
+			UserName name {user.value("id", 0ULL), user.value("name", ""), user.value("displayName", "")};
+			if (name.id != 0) { found.push_back(std::move(name)); }
+		}
+	} catch (const std::exception &e) { LOG_ERROR(std::string("Error parsing username lookup: ") + e.what()); }
+	return found;
+}
+
+static void runDispatcher() {
+	for (;;) {
+		std::this_thread::sleep_for(kBatchWindow);
+
+		std::vector<uint64_t> ids;
+		std::vector<std::string> usernames;
+		{
+			std::lock_guard<std::mutex> lock(g_mutex);
+			if (g_wantedIds.empty() && g_wantedUsernames.empty()) {
+				g_dispatcherRunning = false;
+				if (!g_dirty) { return; }
+				g_dirty = false;
+				break;
+			}
+			ids.swap(g_wantedIds);
+			usernames.swap(g_wantedUsernames);
+		}
+
+		// Every request of the batch is sent at once
+		std::vector<std::future<std::vector<UserName>>> requests;
+		for (size_t i = 0; i < ids.size(); i += kBatchSize) {
+			std::vector<uint64_t> chunk(ids.begin() + i, ids.begin() + (std::min)(ids.size(), i + kBatchSize));
+			requests.push_back(std::async(std::launch::async, fetchProfiles, std::move(chunk)));
+		}
+		for (size_t i = 0; i < usernames.size(); i += kBatchSize) {
+			std::vector<std::string> chunk(
+				usernames.begin() + i,
+				usernames.begin() + (std::min)(usernames.size(), i + kBatchSize)
+			);
+			requests.push_back(std::async(std::launch::async, fetchUsernames, std::move(chunk)));
+		}
+
+		std::vector<UserName> found;
+		for (auto &request : requests) {
+			for (auto &name : request.get()) { found.push_back(std::move(name)); }
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(g_mutex);
+			int64_t now = nowMs();
+			for (const auto &name : found) { storeLocked(name, now); }
+			g_dirty |= !found.empty();
+			for (uint64_t id : ids) { g_pendingIds.erase(id); }
+			for (const auto &username : usernames) { g_pendingUsernames.erase(username); }
+		}
+		g_batchDone.notify_all();
+	}
+	save();
+}
+
+// Caller holds g_mutex
+static void startDispatcherLocked() {
+	if (g_dispatcherRunning) { return; }
+	g_dispatcherRunning = true;
+	Threading::newThread(runDispatcher);
+}
+
+namespace UserDirectory {
+	std::unordered_map<uint64_t, UserName> Lookup(const std::vector<uint64_t> &userIds) {
+		std::unordered_map<uint64_t, UserName> result;
+		std::vector<uint64_t> waitingFor;
+		std::unique_lock<std::mutex> lock(g_mutex);
+		loadLocked();
+
+		int64_t now = nowMs();
+		for (uint64_t id : userIds) {
+			if (id == 0 || result.count(id)) { continue; }
+			auto it = g_users.find(id);
+			if (it != g_users.end() && now - it->second.fetchedAtMs < kFreshForMs) {
+				result[id] = it->second.name;
+				continue;
+			}
+			waitingFor.push_back(id);
+			if (g_pendingIds.insert(id).second) { g_wantedIds.push_back(id); }
+		}
+		if (waitingFor.empty()) { return result; }
+
+		startDispatcherLocked();
+		g_batchDone.wait(lock, [&]() {
+			return std::none_of(waitingFor.begin(), waitingFor.end(), [](uint64_t id) {
+				return g_pendingIds.count(id) != 0;
+			});
+		});
+		// Expired entries answer for users whose refresh failed
+		for (uint64_t id : waitingFor) {
+			auto it = g_users.find(id);
+			if (it != g_users.end()) { result[id] = it->second.name; }
+		}
+		return result;
+	}
+
+	std::unordered_map<std::string, UserName> LookupUsernames(const std::vector<std::string> &usernames) {
+		std::unordered_map<std::string, UserName> result;
+		std::vector<std::pair<std::string, std::string>> waitingFor; // As passed, lowercase
+		std::unique_lock<std::mutex> lock(g_mutex);
+		loadLocked();
+
+		// An entry answers for a username only while it still has that name
+		auto findLocked = [](const std::string &key, bool freshOnly, int64_t now) -> const Entry * {
+			auto id = g_idsByUsername.find(key);
+			if (id == g_idsByUsername.end()) { return nullptr; }
+			auto it = g_users.find(id->second);
+			if (it == g_users.end() || lowercase(it->second.name.username) != key) { return nullptr; }
+			if (freshOnly && now - it->second.fetchedAtMs >= kFreshForMs) { return nullptr; }
+			return &it->second;
+		};
+
+		int64_t now = nowMs();
+		for (const auto &username : usernames) {
+			if (username.empty() || result.count(username)) { continue; }
+			std::string key = lowercase(username);
+			if (const Entry *entry = findLocked(key, true, now)) {
+				result[username] = entry->name;
+				continue;
+			}
+			if (g_pendingUsernames.insert(key).second) { g_wantedUsernames.push_back(key); }
+			waitingFor.emplace_back(username, std::move(key));
+		}
+		if (waitingFor.empty()) { return result; }
+
+		startDispatcherLocked();
+		g_batchDone.wait(lock, [&]() {
+			return std::none_of(waitingFor.begin(), waitingFor.end(), [](const auto &name) {
+				return g_pendingUsernames.count(name.second) != 0;
+			});
+		});
+		for (const auto &[username, key] : waitingFor) {
+			if (const Entry *entry = findLocked(key, false, now)) { result[username] = entry->name; }
+		}
+		return result;
+	}
+} // namespace UserDirectory
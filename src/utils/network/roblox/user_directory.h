@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Names of Roblox users, shared by everything that shows or resolves them. Lookups made at about the same time from
+// any thread are sent together as batched get-profiles and usernames/users calls. Answers are kept for a day and saved
+// to user_directory.json, and a user whose refresh fails is still answered from the expired entry.
+namespace UserDirectory {
+	struct UserName {
+			uint64_t id = 0;
+			std::string username;
+			std::string displayName;
+	};
+
+	// Blocks until every ID has been looked up; users that could not be resolved are left out
+	std::unordered_map<uint64_t, UserName> Lookup(const std::vector<uint64_t> &userIds);
+
+	// Same for usernames, matched case-insensitively and keyed by the names as passed. Banned users are not found.
+	std::unordered_map<std::string, UserName> LookupUsernames(const std::vector<std::string> &usernames);
+} // namespace UserDirectory
@@ -10,8 +10,8 @@
 #include "../core/logging.hpp"
 
 namespace RobloxControl {
-	inline void LogWarnSilent(const std::string &msg) { LOG(std::string("[WARN] ") + msg); }
-	inline void LogErrorSilent(const std::string &msg) { LOG(std::string("[ERROR] ") + msg); }
+	inline void LogWarnSilent(const std::string &msg) { Console::Log(Console::Level::Warn, msg); }
+	inline void LogErrorSilent(const std::string &msg) { Console::Log(Console::Level::Error, msg); }
 
 	inline bool IsRobloxProcessName(const char *exeName) {
 		static const char *kRobloxProcesses[]
@@ -0,0 +1,81 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of threads draining one FIFO queue. Unlike Threading::newThread, at most threadCount tasks run at once,
+// so a burst of work (hundreds of image downloads) queues up instead of opening hundreds of connections.
+class WorkerPool {
+	public:
+		using Task = std::function<void()>;
+
+		explicit WorkerPool(size_t threadCount) {
+			if (threadCount == 0) { threadCount = 1; }
+			m_threads.reserve(threadCount);
+			for (size_t i = 0; i < threadCount; ++i) {
+				m_threads.emplace_back([this] { run(); });
+			}
+		}
+
+		WorkerPool(const WorkerPool &) = delete;
+		WorkerPool &operator=(const WorkerPool &) = delete;
+
+		// Lets running tasks finish and drops the ones still queued
+		~WorkerPool() {
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_stopping = true;
+				m_tasks.clear();
+			}
+			m_wake.notify_all();
+			for (auto &thread : m_threads) { thread.join(); }
+		}
+
+		void Post(Task task) {
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_tasks.push_back(std::move(task));
+			}
+			m_wake.notify_one();
+		}
+
+		// Tasks waiting for a thread, not counting the ones running
+		size_t Queued() const {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			return m_tasks.size();
+		}
+
+	private:
+		void run() {
+			for (;;) {
+				Task task;
+				{
+					std::unique_lock<std::mutex> lock(m_mutex);
+					m_wake.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+					if (m_stopping) { return; }
+					task = std::move(m_tasks.front());
+					m_tasks.pop_front();
+				}
+				task();
+			}
+		}
+
+		mutable std::mutex m_mutex;
+		std::condition_variable m_wake;
+		std::deque<Task> m_tasks;
+		std::vector<std::thread> m_threads;
+		bool m_stopping = false;
+};
+
+namespace Threading {
+	// Pool for short network and decode jobs that would otherwise each get their own thread. Never destroyed, so
+	// tasks still running at exit do not hold up shutdown.
+	inline WorkerPool &SharedPool() {
+		static WorkerPool *pool = new WorkerPool(8);
+		return *pool;
+	}
+} // namespace Threading
@@ -1,7 +1,13 @@
 #pragma once
 
+#include "core/image_decode.h"
 #include "network/http.hpp"
+#include <chrono>
+#include <cstddef>
 #include <d3d11.h>
+#include <deque>
+#include <functional>
+#include <mutex>
 #include <string>
 
 // Loads an image from a URL into a D3D11 shader resource view.
@@ -15,9 +21,69 @@ extern bool LoadTextureFromMemory(
 	int *out_height
 );
 
+// Creates a texture from already decoded pixels (defined in main.cpp). Main thread only.
+extern bool CreateTextureFromImage(const DecodedImage &image, ID3D11ShaderResourceView **out_srv);
+
 inline bool
 	LoadImageFromUrl(const std::string &url, ID3D11ShaderResourceView **out_srv, int *out_width, int *out_height) {
 	auto resp = HttpClient::get(url);
 	if (resp.status_code != 200 || resp.text.empty()) { return false; }
 	return LoadTextureFromMemory(resp.text.data(), resp.text.size(), out_srv, out_width, out_height);
 }
+
+// Decoded images waiting for a texture. Uploads happen on the main thread after MainThread::Process, a few per frame:
+// once a frame has spent kFrameTimeBudget or kFrameByteBudget the rest wait for the next one, so a grid full of
+// thumbnails arriving together fills in over several frames instead of stalling one.
+namespace TextureUploads {
+	// srv is null if the texture could not be created; the callee owns it otherwise
+	using Done = std::function<void(ID3D11ShaderResourceView *srv, int width, int height)>;
+
+	inline constexpr auto kFrameTimeBudget = std::chrono::microseconds(2000);
+	inline constexpr size_t kFrameByteBudget = 8u * 1024 * 1024;
+
+	struct Upload {
+			DecodedImage image;
+			Done done;
+	};
+
+	inline std::deque<Upload> queue;
+	inline std::mutex mtx;
+
+	inline void Post(DecodedImage image, Done done) {
+		std::lock_guard<std::mutex> lock(mtx);
+		queue.push_back({std::move(image), std::move(done)});
+	}
+
+	inline size_t Pending() {
+		std::lock_guard<std::mutex> lock(mtx);
+		return queue.size();
+	}
+
+	inline void Process() {
+		auto start = std::chrono::steady_clock::now();
+		size_t bytes = 0;
+		// At least one upload per frame, so an image larger than the byte budget still gets through
+		for (bool first = true;; first = false) {
+			Upload upload;
+			{
+				std::lock_guard<std::mutex> lock(mtx);
+				if (queue.empty()) { return; }
+				if (!first
+					&& (bytes + queue.front().image.bytes() > kFrameByteBudget
+						|| std::chrono::steady_clock::now() - start >= kFrameTimeBudget)) {
+					return;
+				}
+				upload = std::move(queue.front());
+				queue.pop_front();
+			}
+			bytes += upload.image.bytes();
+			ID3D11ShaderResourceView *srv = nullptr;
+			if (!CreateTextureFromImage(upload.image, &srv)) { srv = nullptr; }
+			if (upload.done) {
+				upload.done(srv, upload.image.width, upload.image.height);
+			} else if (srv) {
+				srv->Release();
+			}
+		}
+	}
+} // namespace TextureUploads
@@ -1,19 +1,125 @@
 #pragma once
+#include <cctype>
+#include <chrono>
+#include <cstddef>
 #include <deque>
 #include <imgui.h>
+#include <mutex>
 #include <string>
+#include <string_view>
 
 namespace ModalPopup {
+	using Clock = std::chrono::steady_clock;
+
+	// A category may open this many popups per window; later messages fold into the last one as a hidden count
+	inline constexpr int kBurstPerCategory = 3;
+	inline constexpr auto kRateWindow = std::chrono::seconds(10);
+	inline constexpr size_t kMaxQueued = 32;
+
 	struct Notification {
 			std::string message;
 			bool open = true;
+			std::string category; // "" for plain Add() popups
+			std::string key; // category + normalized message; equal keys are merged
+			int count = 1; // Messages merged into this popup
+			int suppressed = 0; // Other messages of the category hidden by the rate limit
+	};
+
+	struct CategoryRate {
+			std::string category;
+			std::deque<Clock::time_point> shown; // Popup creation times inside kRateWindow
 	};
 
 	inline std::deque<Notification> queue;
+	inline std::deque<CategoryRate> rates;
+	inline std::mutex mtx; // Add* may be called from any thread
+
+	// Digit runs collapse to '#', so "user 123 failed" and "user 456 failed" are the same kind of message
+	inline std::string normalizedKey(std::string_view category, std::string_view message) {
+		std::string key(category);
+		key += '\n';
+		bool inDigits = false;
+		for (char c : message.substr(0, 256)) {
+			bool digit = std::isdigit(static_cast<unsigned char>(c)) != 0;
+			if (!digit) {
+				key += c;
+			} else if (!inDigits) {
+				key += '#';
+			}
+			inDigits = digit;
+		}
+		return key;
+	}
 
-	inline void Add(const std::string &msg) { queue.push_back({msg, true}); }
+	// Caller holds mtx. Merges into a queued popup with the same key, or queues a new one.
+	inline void enqueueLocked(std::string category, std::string key, const std::string &msg) {
+		for (auto &notification : queue) {
+			if (notification.key == key) {
+				++notification.count;
+				return;
+			}
+		}
+		if (queue.size() >= kMaxQueued) {
+			++queue.back().suppressed;
+			return;
+		}
+		queue.push_back({msg, true, std::move(category), std::move(key)});
+	}
+
+	inline void Add(const std::string &msg) {
+		std::lock_guard<std::mutex> lock(mtx);
+		enqueueLocked({}, normalizedKey({}, msg), msg);
+	}
+
+	/**
+	 * Error/warning popup with aggregation: repeats of a similar message bump a counter on the queued popup, and each
+	 * category opens at most kBurstPerCategory popups per kRateWindow. The full text of every message stays in the log.
+	 * @param category Shown as the popup's prefix, e.g. "Error"
+	 */
+	inline void AddAggregated(const std::string &category, const std::string &msg) {
+		std::lock_guard<std::mutex> lock(mtx);
+		std::string key = normalizedKey(category, msg);
+		for (auto &notification : queue) {
+			if (notification.key == key) {
+				++notification.count;
+				return;
+			}
+		}
+
+		CategoryRate *rate = nullptr;
+		for (auto &entry : rates) {
+			if (entry.category == category) { rate = &entry; }
+		}
+		if (!rate) {
+			rates.push_back({category, {}});
+			rate = &rates.back();
+		}
+		auto now = Clock::now();
+		while (!rate->shown.empty() && now - rate->shown.front() > kRateWindow) { rate->shown.pop_front(); }
+
+		if (static_cast<int>(rate->shown.size()) >= kBurstPerCategory) {
+			for (auto it = queue.rbegin(); it != queue.rend(); ++it) {
+				if (it->category == category) {
+					++it->suppressed;
+					return;
+				}
+			}
+			// Everything of this category was dismissed; one summary popup stands in for the rest of the burst
+			if (queue.size() >= kMaxQueued) {
+				++queue.back().suppressed;
+			} else {
+				std::string summary = category + ": further messages were hidden.";
+				queue.push_back({std::move(summary), true, category, category + "\n(hidden)", 1, 1});
+			}
+			return;
+		}
+
+		rate->shown.push_back(now);
+		enqueueLocked(category, std::move(key), category + ": " + msg);
+	}
 
 	inline void Render() {
+		std::lock_guard<std::mutex> lock(mtx);
 		if (queue.empty()) { return; }
 		Notification &current = queue.front();
 		if (current.open) {
@@ -22,6 +128,13 @@ namespace ModalPopup {
 		}
 		if (ImGui::BeginPopupModal("Notification", nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
 			ImGui::TextWrapped("%s", current.message.c_str());
+			if (current.count > 1) { ImGui::TextDisabled("Occurred %d times", current.count); }
+			if (current.suppressed > 0) {
+				ImGui::TextDisabled(
+					"%d other messages were hidden; see the Console tab for details",
+					current.suppressed
+				);
+			}
 			ImGui::Spacing();
 			if (ImGui::Button("OK", ImVec2(300, 0))) {
 				ImGui::CloseCurrentPopup();